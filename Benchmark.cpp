@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmark.cpp
+// ============
+// render the scene along a fixed camera path and report the frame times
+//
+//	The camera path is a closed Catmull-Rom spline around the computer
+//	case that always looks at its middle.  It passes close to the fans,
+//	so the levels of detail change, and swings far enough to the sides
+//	that frustum culling skips part of the scene.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// control points of the closed camera path
+	const glm::vec3 g_PathPoints[] =
+	{
+		glm::vec3(0.0f, 8.0f, 16.0f),
+		glm::vec3(11.0f, 11.0f, 11.0f),
+		glm::vec3(15.0f, 6.0f, 1.0f),
+		glm::vec3(6.0f, 9.0f, 5.0f),
+		glm::vec3(-4.0f, 7.5f, 6.0f),
+		glm::vec3(-14.0f, 5.0f, 4.0f),
+		glm::vec3(-10.0f, 12.0f, 12.0f),
+		glm::vec3(-3.0f, 4.0f, 14.0f)
+	};
+	const int g_PathPointCount = sizeof(g_PathPoints) / sizeof(g_PathPoints[0]);
+	// point that the camera looks at along the whole path
+	const glm::vec3 g_PathTarget = glm::vec3(0.0f, 7.0f, 0.0f);
+
+	// frames rendered before the timed frames of a configuration,
+	// so the batches of changed options are already rebuilt
+	const int g_WarmupFrames = 60;
+	// longest wait for the texture images before the first configuration
+	const double g_TextureWaitSeconds = 30.0;
+
+	// get a percentile of sorted frame times by the nearest rank
+	double GetPercentile(const std::vector<double>& sortedTimes, double percentile)
+	{
+		int rank = (int)std::ceil(percentile * (double)sortedTimes.size());
+
+		rank = std::min(std::max(rank, 1), (int)sortedTimes.size());
+
+		return(sortedTimes[rank - 1]);
+	}
+}
+
+/***********************************************************
+ *  Benchmark()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+Benchmark::Benchmark(GLFWwindow* window, ViewManager* pViewManager, SceneManager* pSceneManager)
+{
+	m_pWindow = window;
+	m_pViewManager = pViewManager;
+	m_pSceneManager = pSceneManager;
+	m_pRenderTarget = NULL;
+}
+
+/***********************************************************
+ *  SetRenderTarget()
+ *
+ *  This method is used for drawing the frames through the
+ *  same offscreen buffers and post processing as the
+ *  interactive loop.
+ ***********************************************************/
+void Benchmark::SetRenderTarget(RenderTarget* pRenderTarget)
+{
+	m_pRenderTarget = pRenderTarget;
+}
+
+/***********************************************************
+ *  AddConfiguration()
+ *
+ *  This method is used for adding a set of rendering
+ *  optimizations to the test matrix.
+ ***********************************************************/
+void Benchmark::AddConfiguration(const std::string& name, const SceneManager::RENDER_OPTIONS& options)
+{
+	CONFIGURATION configuration;
+
+	configuration.name = name;
+	configuration.options = options;
+	m_configurations.push_back(configuration);
+}
+
+/***********************************************************
+ *  AddDefaultConfigurations()
+ *
+ *  This method is used for adding the default test matrix,
+ *  which shows what each optimization saves on its own.
+ ***********************************************************/
+void Benchmark::AddDefaultConfigurations()
+{
+	SceneManager::RENDER_OPTIONS allOn = m_pSceneManager->GetRenderOptions();
+	SceneManager::RENDER_OPTIONS options;
+
+	allOn.bStaticBatching = true;
+	allOn.bInstancing = true;
+	allOn.bFrustumCulling = true;
+	allOn.bOcclusionCulling = true;
+	allOn.bLevelOfDetail = true;
+	allOn.bLightClusters = true;
+	allOn.bMultithreading = true;
+	allOn.bMultiDraw = true;
+	allOn.bGpuCulling = true;
+	AddConfiguration("all on", allOn);
+
+	options = allOn;
+	options.bStaticBatching = false;
+	AddConfiguration("static batching off", options);
+
+	options = allOn;
+	options.bInstancing = false;
+	AddConfiguration("instancing off", options);
+
+	options = allOn;
+	options.bFrustumCulling = false;
+	AddConfiguration("frustum culling off", options);
+
+	options = allOn;
+	options.bOcclusionCulling = false;
+	AddConfiguration("occlusion culling off", options);
+
+	options = allOn;
+	options.bLevelOfDetail = false;
+	AddConfiguration("level of detail off", options);
+
+	options = allOn;
+	options.bLightClusters = false;
+	AddConfiguration("light clusters off", options);
+
+	options = allOn;
+	options.bMultithreading = false;
+	AddConfiguration("multithreading off", options);
+
+	options = allOn;
+	options.bGpuCulling = false;
+	AddConfiguration("GPU culling off", options);
+
+	// the GPU culler draws with multi-draws of its own
+	options = allOn;
+	options.bMultiDraw = false;
+	options.bGpuCulling = false;
+	AddConfiguration("multi-draw off", options);
+
+	options.bLightClusters = false;
+	options.bMultithreading = false;
+	options.bStaticBatching = false;
+	options.bInstancing = false;
+	options.bFrustumCulling = false;
+	options.bOcclusionCulling = false;
+	options.bLevelOfDetail = false;
+	AddConfiguration("all off", options);
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for rendering the camera path with
+ *  every configuration and keeping the statistics.  The
+ *  rendering options in use before the run are restored.
+ ***********************************************************/
+void Benchmark::Run(int frameCount)
+{
+	SceneManager::RENDER_OPTIONS previousOptions = m_pSceneManager->GetRenderOptions();
+	std::vector<double> frameTimes;
+
+	if (frameCount <= 0)
+	{
+		return;
+	}
+
+	// vsync would round every frame up to the display refresh
+	glfwSwapInterval(0);
+
+	// the placeholders would make the first frames cheaper
+	std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+	while ((m_pSceneManager->GetPendingTextureCount() > 0) &&
+		(std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count() < g_TextureWaitSeconds))
+	{
+		RenderFrame(0.0f);
+	}
+
+	m_results.clear();
+	for (const CONFIGURATION& configuration : m_configurations)
+	{
+		m_pSceneManager->SetRenderOptions(configuration.options);
+
+		for (int frame = 0; frame < g_WarmupFrames; frame++)
+		{
+			RenderFrame(0.0f);
+		}
+
+		frameTimes.clear();
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			frameTimes.push_back(RenderFrame((float)frame / (float)frameCount));
+		}
+
+		m_results.push_back(SummarizeFrames(configuration.name, frameTimes));
+		std::cout << "INFO: benchmarked " << configuration.name << std::endl;
+	}
+
+	m_pSceneManager->SetRenderOptions(previousOptions);
+}
+
+/***********************************************************
+ *  RenderFrame()
+ *
+ *  This method is used for rendering one frame the same way
+ *  as the interactive loop, with the camera on the path.
+ ***********************************************************/
+double Benchmark::RenderFrame(float pathTime)
+{
+	std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+	m_pViewManager->SetCameraPose(GetPathPosition(pathTime), g_PathTarget);
+
+	if (NULL != m_pRenderTarget)
+	{
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+
+		glfwGetFramebufferSize(m_pWindow, &framebufferWidth, &framebufferHeight);
+		m_pRenderTarget->BeginFrame(framebufferWidth, framebufferHeight);
+		m_pViewManager->SetRenderSize(m_pRenderTarget->GetWidth(), m_pRenderTarget->GetHeight());
+	}
+
+	glEnable(GL_DEPTH_TEST);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	m_pViewManager->PrepareSceneView();
+	m_pSceneManager->RenderScene();
+
+	if (NULL != m_pRenderTarget)
+	{
+		m_pRenderTarget->EndFrame();
+	}
+
+	m_pSceneManager->EndFrame();
+
+	glfwSwapBuffers(m_pWindow);
+	glFinish();
+	glfwPollEvents();
+
+	return(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+}
+
+/***********************************************************
+ *  GetPathPosition()
+ *
+ *  This method is used for getting the camera position on
+ *  the closed Catmull-Rom spline through the control points.
+ ***********************************************************/
+glm::vec3 Benchmark::GetPathPosition(float pathTime)
+{
+	float segmentTime = (pathTime - std::floor(pathTime)) * (float)g_PathPointCount;
+	int segment = std::min((int)segmentTime, g_PathPointCount - 1);
+	float t = segmentTime - (float)segment;
+	float t2 = t * t;
+	float t3 = t2 * t;
+
+	const glm::vec3& p0 = g_PathPoints[(segment + g_PathPointCount - 1) % g_PathPointCount];
+	const glm::vec3& p1 = g_PathPoints[segment];
+	const glm::vec3& p2 = g_PathPoints[(segment + 1) % g_PathPointCount];
+	const glm::vec3& p3 = g_PathPoints[(segment + 2) % g_PathPointCount];
+
+	return(0.5f * ((2.0f * p1) +
+		((p2 - p0) * t) +
+		(((2.0f * p0) - (5.0f * p1) + (4.0f * p2) - p3) * t2) +
+		(((3.0f * p1) - p0 - (3.0f * p2) + p3) * t3)));
+}
+
+/***********************************************************
+ *  SummarizeFrames()
+ *
+ *  This method is used for getting the mean, median, 99th
+ *  percentile and range of the frame times.  The times are
+ *  sorted in place.
+ ***********************************************************/
+Benchmark::RESULT Benchmark::SummarizeFrames(const std::string& name, std::vector<double>& frameTimes)
+{
+	RESULT result;
+	double total = 0.0;
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+	for (double frameTime : frameTimes)
+	{
+		total += frameTime;
+	}
+
+	result.name = name;
+	result.frameCount = (int)frameTimes.size();
+	result.mean = total / (double)frameTimes.size();
+	result.p50 = GetPercentile(frameTimes, 0.5);
+	result.p99 = GetPercentile(frameTimes, 0.99);
+	result.minimum = frameTimes.front();
+	result.maximum = frameTimes.back();
+
+	return(result);
+}
+
+/***********************************************************
+ *  PrintResults()
+ *
+ *  This method is used for printing the frame times of all
+ *  of the configurations as a table.
+ ***********************************************************/
+void Benchmark::PrintResults() const
+{
+	std::ios::fmtflags flags = std::cout.flags();
+	std::streamsize precision = std::cout.precision();
+
+	std::cout << std::endl << std::left << std::setw(24) << "configuration" << std::right
+		<< std::setw(8) << "frames" << std::setw(10) << "mean" << std::setw(10) << "p50"
+		<< std::setw(10) << "p99" << std::setw(10) << "min" << std::setw(10) << "max" << std::endl;
+
+	std::cout << std::fixed << std::setprecision(3);
+	for (const RESULT& result : m_results)
+	{
+		std::cout << std::left << std::setw(24) << result.name << std::right
+			<< std::setw(8) << result.frameCount << std::setw(10) << result.mean << std::setw(10) << result.p50
+			<< std::setw(10) << result.p99 << std::setw(10) << result.minimum << std::setw(10) << result.maximum
+			<< std::endl;
+	}
+	std::cout << "(frame times in ms)" << std::endl << std::endl;
+
+	std::cout.flags(flags);
+	std::cout.precision(precision);
+}
+
+/***********************************************************
+ *  WriteCsv()
+ *
+ *  This method is used for writing the results in a form
+ *  that other tools can compare between runs.
+ ***********************************************************/
+bool Benchmark::WriteCsv(const std::string& filename) const
+{
+	std::ofstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not write benchmark file:" << filename << std::endl;
+		return(false);
+	}
+
+	file << "configuration,frames,mean_ms,p50_ms,p99_ms,min_ms,max_ms\n";
+	file << std::fixed << std::setprecision(4);
+	for (const RESULT& result : m_results)
+	{
+		file << result.name << "," << result.frameCount << "," << result.mean << "," << result.p50 << ","
+			<< result.p99 << "," << result.minimum << "," << result.maximum << "\n";
+	}
+
+	std::cout << "INFO: wrote the benchmark results to " << filename << std::endl;
+
+	return(true);
+}
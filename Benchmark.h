@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmark.h
+// ============
+// render the scene along a fixed camera path and report the frame times
+//
+//	The benchmark draws into a hidden window with vsync off and moves the
+//	camera by frame number instead of by time, so every run renders the
+//	same frames.  Each configuration of the test matrix turns some of the
+//	rendering optimizations off and renders the whole path after a few
+//	warm-up frames.  A frame is timed until glFinish() returns, so the GPU
+//	work of the frame is included.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "RenderTarget.h"
+
+// GLFW library
+#include "GLFW/glfw3.h"
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  Benchmark
+ *
+ *  This class contains the test matrix, the camera path and
+ *  the code for timing and summarizing the frames.
+ ***********************************************************/
+class Benchmark
+{
+public:
+	// frame time statistics of one configuration, in milliseconds
+	struct RESULT
+	{
+		std::string name;
+		int frameCount;
+		double mean;
+		double p50;
+		double p99;
+		double minimum;
+		double maximum;
+	};
+
+	// constructor
+	Benchmark(GLFWwindow* window, ViewManager* pViewManager, SceneManager* pSceneManager);
+
+	// add one configuration of the rendering optimizations
+	void AddConfiguration(const std::string& name, const SceneManager::RENDER_OPTIONS& options);
+	// add all optimizations on, each one off alone, and all off
+	void AddDefaultConfigurations();
+	// draw the frames through offscreen buffers, NULL for the window
+	void SetRenderTarget(RenderTarget* pRenderTarget);
+
+	// render the camera path once for every configuration
+	void Run(int frameCount);
+
+	// print the results as a table
+	void PrintResults() const;
+	// write the results with one line per configuration
+	bool WriteCsv(const std::string& filename) const;
+
+	// get the camera position at a time between 0 and 1 of the path
+	static glm::vec3 GetPathPosition(float pathTime);
+
+private:
+	struct CONFIGURATION
+	{
+		std::string name;
+		SceneManager::RENDER_OPTIONS options;
+	};
+
+	GLFWwindow* m_pWindow;
+	ViewManager* m_pViewManager;
+	SceneManager* m_pSceneManager;
+	RenderTarget* m_pRenderTarget;
+	std::vector<CONFIGURATION> m_configurations;
+	std::vector<RESULT> m_results;
+
+	// render one frame with the camera at a time of the path and
+	// get how long it took in milliseconds
+	double RenderFrame(float pathTime);
+	// get the statistics of the frame times of a configuration
+	static RESULT SummarizeFrames(const std::string& name, std::vector<double>& frameTimes);
+};
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.cpp
+// ============
+// notice edits to the shader, texture and scene files while the program runs
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FileWatcher.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+/***********************************************************
+ *  FileWatcher()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FileWatcher::FileWatcher(int checkIntervalMilliseconds)
+{
+	m_checkInterval = std::chrono::milliseconds(checkIntervalMilliseconds);
+	m_lastCheck = std::chrono::steady_clock::now();
+}
+
+/***********************************************************
+ *  WatchFile()
+ *
+ *  This method is used for adding a file to the watched
+ *  files.  The current version of the file is not reported,
+ *  only the edits made after this call.
+ ***********************************************************/
+int FileWatcher::WatchFile(const std::string& filename)
+{
+	for (int i = 0; i < (int)m_files.size(); i++)
+	{
+		if (m_files[i].filename == filename)
+		{
+			return(i);
+		}
+	}
+
+	WATCHED_FILE file;
+	file.filename = filename;
+	GetFileStamp(filename, file.modifiedTime, file.size);
+	file.pendingTime = file.modifiedTime;
+	file.pendingSize = file.size;
+	file.bPending = false;
+	m_files.push_back(file);
+
+	return((int)m_files.size() - 1);
+}
+
+/***********************************************************
+ *  GetFilename()
+ *
+ *  This method is used for getting the name of a watched
+ *  file.
+ ***********************************************************/
+const std::string& FileWatcher::GetFilename(int handle) const
+{
+	return(m_files[handle].filename);
+}
+
+/***********************************************************
+ *  GetCount()
+ *
+ *  This method is used for getting the number of watched
+ *  files.
+ ***********************************************************/
+int FileWatcher::GetCount() const
+{
+	return((int)m_files.size());
+}
+
+/***********************************************************
+ *  CheckFiles()
+ *
+ *  This method is used for polling the watched files once
+ *  the check interval has passed.  A changed file is held
+ *  back for one more check, so a file that is still being
+ *  written is not read half way.  Files that were removed
+ *  are reported when they come back.
+ ***********************************************************/
+bool FileWatcher::CheckFiles(std::vector<int>& changedFiles)
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	bool bChanged = false;
+
+	if ((now - m_lastCheck) < m_checkInterval)
+	{
+		return(false);
+	}
+	m_lastCheck = now;
+
+	for (int i = 0; i < (int)m_files.size(); i++)
+	{
+		WATCHED_FILE& file = m_files[i];
+		long long modifiedTime = 0;
+		long long size = -1;
+
+		GetFileStamp(file.filename, modifiedTime, size);
+
+		if ((modifiedTime == file.modifiedTime) && (size == file.size))
+		{
+			file.bPending = false;
+			continue;
+		}
+
+		// the same new version twice in a row is a finished edit
+		if ((file.bPending == true) && (modifiedTime == file.pendingTime) && (size == file.pendingSize))
+		{
+			file.modifiedTime = modifiedTime;
+			file.size = size;
+			file.bPending = false;
+
+			// a file that is missing has nothing to reload yet
+			if (size >= 0)
+			{
+				changedFiles.push_back(i);
+				bChanged = true;
+			}
+			continue;
+		}
+
+		file.pendingTime = modifiedTime;
+		file.pendingSize = size;
+		file.bPending = true;
+	}
+
+	return(bChanged);
+}
+
+/***********************************************************
+ *  GetFileStamp()
+ *
+ *  This method is used for getting the last modification
+ *  time and the size of a file, 0 and -1 if the file does
+ *  not exist.  The time is kept at the finest resolution
+ *  the file system stores, so an edit that keeps the size
+ *  is seen even within the same second as the last one.
+ ***********************************************************/
+void FileWatcher::GetFileStamp(const std::string& filename, long long& modifiedTime, long long& size)
+{
+	modifiedTime = 0;
+	size = -1;
+
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+	// the write time is counted in 100 nanosecond steps
+	if (GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &attributes) != FALSE)
+	{
+		modifiedTime = ((long long)attributes.ftLastWriteTime.dwHighDateTime << 32) |
+			(long long)attributes.ftLastWriteTime.dwLowDateTime;
+		size = ((long long)attributes.nFileSizeHigh << 32) | (long long)attributes.nFileSizeLow;
+	}
+#else
+	struct stat fileStatus;
+
+	if (stat(filename.c_str(), &fileStatus) == 0)
+	{
+#ifdef __APPLE__
+		const struct timespec& writeTime = fileStatus.st_mtimespec;
+#else
+		const struct timespec& writeTime = fileStatus.st_mtim;
+#endif
+		modifiedTime = ((long long)writeTime.tv_sec * 1000000000LL) + (long long)writeTime.tv_nsec;
+		size = (long long)fileStatus.st_size;
+	}
+#endif
+}
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+// filewatcher.h
+// ============
+// notice edits to the shader, texture and scene files while the program runs
+//
+//	The modification time and size of every watched file are polled, at
+//	most once per check interval, so a frame without a check only reads
+//	the clock.  Editors often write a file in several steps, so a file is
+//	only reported once its new time and size have held for a whole check
+//	interval, and it is then reported a single time per edit.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FileWatcher
+ *
+ *  This class contains the watched files and the code for
+ *  finding the ones that were changed since the last check.
+ ***********************************************************/
+class FileWatcher
+{
+public:
+	// constructor, files are polled at most once per interval
+	FileWatcher(int checkIntervalMilliseconds);
+
+	// start watching a file and get its handle, a file that is
+	// already watched keeps its handle
+	int WatchFile(const std::string& filename);
+	// get the file name that a handle was returned for
+	const std::string& GetFilename(int handle) const;
+	// number of watched files
+	int GetCount() const;
+
+	// add the handles of the files that were changed since the
+	// last check, false when none were changed or the check
+	// interval has not passed yet
+	bool CheckFiles(std::vector<int>& changedFiles);
+
+private:
+	struct WATCHED_FILE
+	{
+		std::string filename;
+		// time and size of the last reported version, 0 and -1
+		// for a file that does not exist, the time in the finest
+		// steps of the platform, nanoseconds where stat() has them
+		long long modifiedTime;
+		long long size;
+		// time and size seen by the previous check, reported when
+		// they still hold on the next one
+		long long pendingTime;
+		long long pendingSize;
+		bool bPending;
+	};
+
+	std::vector<WATCHED_FILE> m_files;
+	// time between two polls of the files
+	std::chrono::steady_clock::duration m_checkInterval;
+	std::chrono::steady_clock::time_point m_lastCheck;
+
+	// get the current modification time and size of a file
+	static void GetFileStamp(const std::string& filename, long long& modifiedTime, long long& size);
+};
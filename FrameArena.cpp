@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.cpp
+// ============
+// scratch memory for the draw items and upload data of the frames
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameArena.h"
+
+#include <cstdint>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// buffers are grown in steps of this many bytes
+	const size_t g_GrowBytes = 64 * 1024;
+
+	// get the first address at or after a pointer with an alignment
+	unsigned char* AlignPointer(unsigned char* pointer, size_t alignment)
+	{
+		uintptr_t address = (uintptr_t)pointer;
+
+		return(pointer + (((address + alignment - 1) & ~(uintptr_t)(alignment - 1)) - address));
+	}
+}
+
+/***********************************************************
+ *  FrameArena()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameArena::FrameArena(size_t frameBytes, int frameCount)
+{
+	m_frames.resize(std::max(frameCount, 1));
+	for (FRAME_MEMORY& frame : m_frames)
+	{
+		frame.capacity = frameBytes;
+		frame.data = (frameBytes > 0) ? new unsigned char[frameBytes] : NULL;
+		frame.used = 0;
+		frame.overflowBlocks = NULL;
+		frame.overflowBytes = 0;
+	}
+	m_currentFrame = 0;
+}
+
+/***********************************************************
+ *  ~FrameArena()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameArena::~FrameArena()
+{
+	for (FRAME_MEMORY& frame : m_frames)
+	{
+		while (NULL != frame.overflowBlocks)
+		{
+			void* next = *(void**)frame.overflowBlocks;
+
+			delete[] (unsigned char*)frame.overflowBlocks;
+			frame.overflowBlocks = next;
+		}
+		delete[] frame.data;
+		frame.data = NULL;
+	}
+	m_frames.clear();
+}
+
+/***********************************************************
+ *  NextFrame()
+ *
+ *  This method is used for finishing the current frame and
+ *  making the oldest frame current.  Its memory is released
+ *  all at once by resetting the offset.  A frame that ran
+ *  out of room frees its extra blocks and gets a buffer
+ *  that holds all of it instead.
+ ***********************************************************/
+void FrameArena::NextFrame()
+{
+	m_currentFrame = (m_currentFrame + 1) % (int)m_frames.size();
+
+	FRAME_MEMORY& frame = m_frames[m_currentFrame];
+
+	if (NULL != frame.overflowBlocks)
+	{
+		size_t capacity = frame.capacity + frame.overflowBytes;
+
+		capacity = ((capacity + g_GrowBytes - 1) / g_GrowBytes) * g_GrowBytes;
+		while (NULL != frame.overflowBlocks)
+		{
+			void* next = *(void**)frame.overflowBlocks;
+
+			delete[] (unsigned char*)frame.overflowBlocks;
+			frame.overflowBlocks = next;
+		}
+		delete[] frame.data;
+		frame.data = new unsigned char[capacity];
+		frame.capacity = capacity;
+		frame.overflowBytes = 0;
+
+		std::cout << "INFO: frame scratch memory grown to " << (capacity / 1024) << " KB" << std::endl;
+	}
+
+	frame.used = 0;
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for getting memory in the current
+ *  frame.  The alignment must be a power of two.
+ ***********************************************************/
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	FRAME_MEMORY& frame = m_frames[m_currentFrame];
+
+	if (NULL != frame.data)
+	{
+		unsigned char* pointer = AlignPointer(frame.data + frame.used, alignment);
+		size_t end = (size_t)(pointer - frame.data) + size;
+
+		if (end <= frame.capacity)
+		{
+			frame.used = end;
+			return(pointer);
+		}
+	}
+
+	return(AllocateOverflow(frame, size, alignment));
+}
+
+/***********************************************************
+ *  AllocateOverflow()
+ *
+ *  This method is used for getting memory for a frame whose
+ *  buffer is full from a heap block of its own.  The sizes
+ *  are added up, so the buffer can hold the whole frame the
+ *  next time.
+ ***********************************************************/
+void* FrameArena::AllocateOverflow(FRAME_MEMORY& frame, size_t size, size_t alignment)
+{
+	size_t blockSize = sizeof(void*) + alignment + size;
+	unsigned char* block = new unsigned char[blockSize];
+
+	*(void**)block = frame.overflowBlocks;
+	frame.overflowBlocks = block;
+	frame.overflowBytes += alignment + size;
+
+	return(AlignPointer(block + sizeof(void*), alignment));
+}
+
+/***********************************************************
+ *  GetUsedBytes()
+ *
+ *  This method is used for getting the number of bytes that
+ *  the current frame has allocated, with the extra blocks.
+ ***********************************************************/
+size_t FrameArena::GetUsedBytes() const
+{
+	const FRAME_MEMORY& frame = m_frames[m_currentFrame];
+
+	return(frame.used + frame.overflowBytes);
+}
+
+/***********************************************************
+ *  GetCapacity()
+ *
+ *  This method is used for getting the size of the buffers
+ *  of all of the frames together.
+ ***********************************************************/
+size_t FrameArena::GetCapacity() const
+{
+	size_t capacity = 0;
+
+	for (const FRAME_MEMORY& frame : m_frames)
+	{
+		capacity += frame.capacity;
+	}
+
+	return(capacity);
+}
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.h
+// ============
+// scratch memory for the draw items and upload data of the frames
+//
+//	Each frame allocates its draw items, sort buffers, visible instance
+//	lists and upload data from a linear arena by moving an offset along
+//	a buffer, and nothing is freed on its own.  The arena keeps one
+//	buffer per frame for a few frames, so the data of the previous frame
+//	can still be read while the current one is built, and starting a new
+//	frame only resets the offset of its buffer.  A frame that runs past
+//	the end of its buffer gets extra blocks from the heap, and its buffer
+//	is grown to fit the whole frame the next time it is reset, so after
+//	the first frames of a scene the arena does not touch the heap.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  FrameArena
+ *
+ *  This class contains the buffers of the frames and the
+ *  code for allocating scratch memory from them.  Only the
+ *  GL thread allocates, the jobs only fill in memory that
+ *  was allocated before they started.
+ ***********************************************************/
+class FrameArena
+{
+public:
+	// constructor, with the bytes each frame starts with and the
+	// number of frames whose memory is kept at the same time
+	FrameArena(size_t frameBytes, int frameCount);
+	// destructor
+	~FrameArena();
+
+	// finish the current frame, the memory of the oldest frame is
+	// reused for the next one
+	void NextFrame();
+
+	// allocate memory in the current frame, valid until the
+	// frame count of NextFrame() calls have been made
+	void* Allocate(size_t size, size_t alignment);
+	template <typename T>
+	T* AllocateArray(int count)
+	{
+		return(static_cast<T*>(Allocate(sizeof(T) * (size_t)std::max(count, 0), alignof(T))));
+	}
+
+	// bytes allocated in the current frame
+	size_t GetUsedBytes() const;
+	// bytes of the buffers of all of the frames
+	size_t GetCapacity() const;
+
+private:
+	// buffer of one frame
+	struct FRAME_MEMORY
+	{
+		unsigned char* data;
+		size_t capacity;
+		size_t used;
+		// heap blocks of the allocations past the end of the buffer,
+		// each block starts with the pointer to the next one
+		void* overflowBlocks;
+		size_t overflowBytes;
+	};
+
+	std::vector<FRAME_MEMORY> m_frames;
+	// frame that the allocations go to
+	int m_currentFrame;
+
+	// allocate from the heap once the buffer of a frame is full
+	void* AllocateOverflow(FRAME_MEMORY& frame, size_t size, size_t alignment);
+};
+
+/***********************************************************
+ *  FrameArray
+ *
+ *  This class contains a list of plain structs in the
+ *  memory of a frame.  It grows like a vector, leaving the
+ *  old items behind in the arena, but the lists filled by
+ *  jobs are given all the room they need in Reset(), since
+ *  a job must not allocate.
+ ***********************************************************/
+template <typename T>
+class FrameArray
+{
+public:
+	// constructor
+	FrameArray()
+	{
+		m_pArena = NULL;
+		m_items = NULL;
+		m_count = 0;
+		m_capacity = 0;
+	}
+
+	// start an empty list in the current frame of the arena,
+	// with room for the passed in number of items
+	void Reset(FrameArena* pArena, int capacity)
+	{
+		m_pArena = pArena;
+		m_count = 0;
+		m_capacity = std::max(capacity, 0);
+		m_items = (m_capacity > 0) ? pArena->AllocateArray<T>(m_capacity) : NULL;
+	}
+
+	// remove the items, the room is kept
+	void Clear()
+	{
+		m_count = 0;
+	}
+
+	// add items at the end of the list
+	void PushBack(const T& item)
+	{
+		if (m_count == m_capacity)
+		{
+			Grow(m_count + 1);
+		}
+		m_items[m_count++] = item;
+	}
+	void Append(const T* items, int count)
+	{
+		if ((m_count + count) > m_capacity)
+		{
+			Grow(m_count + count);
+		}
+		std::copy(items, items + count, m_items + m_count);
+		m_count += count;
+	}
+
+	// make the list a number of items long, added items are not set
+	void Resize(int count)
+	{
+		if (count > m_capacity)
+		{
+			Grow(count);
+		}
+		m_count = std::max(count, 0);
+	}
+
+	int Size() const
+	{
+		return(m_count);
+	}
+	bool IsEmpty() const
+	{
+		return(m_count == 0);
+	}
+	T* Data()
+	{
+		return(m_items);
+	}
+	const T* Data() const
+	{
+		return(m_items);
+	}
+	T& operator[](int index)
+	{
+		return(m_items[index]);
+	}
+	const T& operator[](int index) const
+	{
+		return(m_items[index]);
+	}
+
+	// for range based loops
+	T* begin()
+	{
+		return(m_items);
+	}
+	T* end()
+	{
+		return(m_items + m_count);
+	}
+	const T* begin() const
+	{
+		return(m_items);
+	}
+	const T* end() const
+	{
+		return(m_items + m_count);
+	}
+
+private:
+	FrameArena* m_pArena;
+	T* m_items;
+	int m_count;
+	int m_capacity;
+
+	// move the items to a larger run of the arena
+	void Grow(int count)
+	{
+		int capacity = std::max(count, m_capacity * 2);
+		T* items = m_pArena->AllocateArray<T>(capacity);
+
+		std::copy(m_items, m_items + m_count, items);
+		m_items = items;
+		m_capacity = capacity;
+	}
+};
@@ -0,0 +1,688 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// time the parts of each frame on the CPU and the GPU and count draw work
+//
+//	The overlay needs no shader or font, each bar is a scissored clear of
+//	the color buffer.  Every scope gets one row, the upper bar is the CPU
+//	time and the lower one the GPU time, and the white line marks the
+//	16.7 ms budget of a 60 Hz frame.  The row below the scopes shows the
+//	heap allocations of the frame, a green square when there were none
+//	and a red bar that grows with their number otherwise.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+// declaration of the global variables and defines
+namespace
+{
+	// work counted in the current frame by the static methods
+	FrameProfiler::FRAME_COUNTERS g_FrameCounters = { 0, 0, 0, 0, 0 };
+	// heap allocations of all threads, counted by operator new
+	std::atomic<long long> g_AllocationCount(0);
+
+	// frame time that half of the window width stands for
+	const float g_FrameBudgetMs = 1000.0f / 60.0f;
+	// layout of the overlay rows in pixels
+	const int g_OverlayMargin = 10;
+	const int g_RowHeight = 12;
+	const int g_BarHeight = 5;
+	const int g_DepthIndent = 8;
+	// width of the allocation bar for each allocation
+	const int g_PixelsPerAllocation = 4;
+	// scopes that each kept frame has room for before it allocates
+	const int g_ReservedScopes = 16;
+
+	// colors of the scope rows, the GPU bar uses half of the color
+	const float g_ScopeColors[][3] =
+	{
+		{ 0.9f, 0.9f, 0.9f },
+		{ 0.2f, 0.8f, 0.2f },
+		{ 0.2f, 0.5f, 1.0f },
+		{ 1.0f, 0.6f, 0.1f },
+		{ 0.9f, 0.2f, 0.6f },
+		{ 0.1f, 0.8f, 0.8f },
+		{ 0.9f, 0.9f, 0.2f }
+	};
+	const int g_ScopeColorCount = sizeof(g_ScopeColors) / sizeof(g_ScopeColors[0]);
+
+	// fill a rectangle of the color buffer, at least one pixel wide
+	void DrawOverlayBar(int x, int y, int width, int height, float red, float green, float blue)
+	{
+		glScissor(x, y, std::max(width, 1), height);
+		glClearColor(red, green, blue, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	// get heap memory for operator new
+	void* AllocateCounted(std::size_t size)
+	{
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		void* pointer = std::malloc((size > 0) ? size : 1);
+		while (NULL == pointer)
+		{
+			std::new_handler handler = std::get_new_handler();
+			if (NULL == handler)
+			{
+				throw std::bad_alloc();
+			}
+			handler();
+			pointer = std::malloc((size > 0) ? size : 1);
+		}
+
+		return(pointer);
+	}
+}
+
+/***********************************************************
+ *  operator new()
+ *
+ *  The global allocation functions are replaced, so every
+ *  heap allocation of the program is counted.  The nothrow
+ *  forms call these, and the memory comes from malloc().
+ ***********************************************************/
+void* operator new(std::size_t size)
+{
+	return(AllocateCounted(size));
+}
+
+void* operator new[](std::size_t size)
+{
+	return(AllocateCounted(size));
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	m_currentSlot = 0;
+	m_frameNumber = 0;
+	m_bInFrame = false;
+	m_frameAllocations = 0;
+
+	// the kept frames are made once, so recording does not allocate
+	m_history.resize(PROFILER_HISTORY_FRAMES);
+	for (FRAME_RECORD& record : m_history)
+	{
+		record.frameNumber = 0;
+		record.scopes.reserve(g_ReservedScopes);
+		record.counters = g_FrameCounters;
+	}
+	m_historyStart = 0;
+	m_historyCount = 0;
+
+	for (int i = 0; i < PROFILER_FRAME_LATENCY; i++)
+	{
+		m_slots[i].bPending = false;
+		m_slots[i].frameNumber = 0;
+		m_slots[i].usedQueries = 0;
+		m_slots[i].counters = g_FrameCounters;
+		glGenQueries(1, &m_slots[i].primitivesQuery);
+	}
+
+	// the two clocks are read together so GPU times can be
+	// placed next to the CPU times in the trace
+	m_startTime = std::chrono::steady_clock::now();
+	m_gpuStartTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &m_gpuStartTime);
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	for (int i = 0; i < PROFILER_FRAME_LATENCY; i++)
+	{
+		if (m_slots[i].queries.empty() == false)
+		{
+			glDeleteQueries((GLsizei)m_slots[i].queries.size(), m_slots[i].queries.data());
+		}
+		glDeleteQueries(1, &m_slots[i].primitivesQuery);
+	}
+}
+
+/***********************************************************
+ *  GetCpuMilliseconds()
+ *
+ *  This method is used for getting the CPU time that has
+ *  passed since the profiler was created.
+ ***********************************************************/
+double FrameProfiler::GetCpuMilliseconds() const
+{
+	return(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for starting the frame scope.  The
+ *  frames that have finished on the GPU are read back first,
+ *  and the frame that used this slot is waited on if its
+ *  results have still not arrived.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	if (m_bInFrame == true)
+	{
+		EndFrame();
+	}
+
+	m_frameAllocations = GetAllocationCount();
+
+	// the slot about to be reused holds the oldest frame
+	m_currentSlot = m_frameNumber % PROFILER_FRAME_LATENCY;
+	ResolveFrame(m_slots[m_currentSlot], true);
+	for (int i = 1; i < PROFILER_FRAME_LATENCY; i++)
+	{
+		if (ResolveFrame(m_slots[(m_currentSlot + i) % PROFILER_FRAME_LATENCY], false) == false)
+		{
+			break;
+		}
+	}
+
+	FRAME_SLOT& slot = m_slots[m_currentSlot];
+	slot.frameNumber = m_frameNumber;
+	slot.scopes.clear();
+	slot.usedQueries = 0;
+
+	g_FrameCounters.drawCalls = 0;
+	g_FrameCounters.stateChanges = 0;
+	g_FrameCounters.uniformUploads = 0;
+	g_FrameCounters.allocations = 0;
+	g_FrameCounters.triangles = 0;
+
+	glBeginQuery(GL_PRIMITIVES_GENERATED, slot.primitivesQuery);
+
+	m_bInFrame = true;
+	BeginScope("Frame");
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for finishing the frame scope and
+ *  any scope left open inside it.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	if (m_bInFrame == false)
+	{
+		return;
+	}
+
+	while (m_openScopes.empty() == false)
+	{
+		EndScope();
+	}
+
+	glEndQuery(GL_PRIMITIVES_GENERATED);
+
+	FRAME_SLOT& slot = m_slots[m_currentSlot];
+	slot.counters = g_FrameCounters;
+	slot.counters.allocations = (int)(GetAllocationCount() - m_frameAllocations);
+	slot.bPending = true;
+
+	m_bInFrame = false;
+	m_frameNumber++;
+}
+
+/***********************************************************
+ *  BeginScope()
+ *
+ *  This method is used for starting a scope inside the
+ *  current frame.  Scopes outside of a frame are ignored.
+ ***********************************************************/
+void FrameProfiler::BeginScope(const char* name)
+{
+	if (m_bInFrame == false)
+	{
+		return;
+	}
+
+	FRAME_SLOT& slot = m_slots[m_currentSlot];
+	PENDING_SCOPE scope;
+
+	scope.name = name;
+	scope.depth = (int)m_openScopes.size();
+	scope.beginQuery = IssueTimestamp();
+	scope.endQuery = -1;
+	scope.cpuStart = GetCpuMilliseconds();
+	scope.cpuEnd = scope.cpuStart;
+
+	m_openScopes.push_back((int)slot.scopes.size());
+	slot.scopes.push_back(scope);
+}
+
+/***********************************************************
+ *  EndScope()
+ *
+ *  This method is used for finishing the innermost scope
+ *  that is still open.
+ ***********************************************************/
+void FrameProfiler::EndScope()
+{
+	if ((m_bInFrame == false) || (m_openScopes.empty() == true))
+	{
+		return;
+	}
+
+	PENDING_SCOPE& scope = m_slots[m_currentSlot].scopes[m_openScopes.back()];
+
+	scope.cpuEnd = GetCpuMilliseconds();
+	scope.endQuery = IssueTimestamp();
+	m_openScopes.pop_back();
+}
+
+/***********************************************************
+ *  IssueTimestamp()
+ *
+ *  This method is used for recording the GPU clock once the
+ *  commands issued so far have finished.  The queries of a
+ *  slot are kept for the later frames that use the slot.
+ ***********************************************************/
+int FrameProfiler::IssueTimestamp()
+{
+	FRAME_SLOT& slot = m_slots[m_currentSlot];
+
+	if (slot.usedQueries == (int)slot.queries.size())
+	{
+		GLuint query = 0;
+
+		glGenQueries(1, &query);
+		slot.queries.push_back(query);
+	}
+
+	glQueryCounter(slot.queries[slot.usedQueries], GL_TIMESTAMP);
+
+	return(slot.usedQueries++);
+}
+
+/***********************************************************
+ *  ResolveFrame()
+ *
+ *  This method is used for reading back the queries of a
+ *  frame in flight and adding the frame to the history.
+ *  Once the history is full the oldest kept frame is
+ *  written over.  Without waiting, false is returned while
+ *  the results of the frame have not arrived.
+ ***********************************************************/
+bool FrameProfiler::ResolveFrame(FRAME_SLOT& slot, bool bWait)
+{
+	if (slot.bPending == false)
+	{
+		return(true);
+	}
+
+	if (bWait == false)
+	{
+		GLint bAvailable = 0;
+
+		// the queries finish in order, so the last one is enough
+		glGetQueryObjectiv(slot.queries[slot.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		if (bAvailable != 0)
+		{
+			glGetQueryObjectiv(slot.primitivesQuery, GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		}
+		if (bAvailable == 0)
+		{
+			return(false);
+		}
+	}
+
+	FRAME_RECORD& record = m_history[(m_historyStart + m_historyCount) % PROFILER_HISTORY_FRAMES];
+	GLuint64 primitives = 0;
+
+	if (m_historyCount < PROFILER_HISTORY_FRAMES)
+	{
+		m_historyCount++;
+	}
+	else
+	{
+		m_historyStart = (m_historyStart + 1) % PROFILER_HISTORY_FRAMES;
+	}
+
+	record.frameNumber = slot.frameNumber;
+	record.counters = slot.counters;
+	glGetQueryObjectui64v(slot.primitivesQuery, GL_QUERY_RESULT, &primitives);
+	record.counters.triangles = (long long)primitives;
+
+	record.scopes.clear();
+	for (const PENDING_SCOPE& pending : slot.scopes)
+	{
+		SCOPE_TIMES times;
+		GLuint64 gpuBegin = 0;
+		GLuint64 gpuEnd = 0;
+
+		glGetQueryObjectui64v(slot.queries[pending.beginQuery], GL_QUERY_RESULT, &gpuBegin);
+		glGetQueryObjectui64v(slot.queries[pending.endQuery], GL_QUERY_RESULT, &gpuEnd);
+
+		times.name = pending.name;
+		times.depth = pending.depth;
+		times.cpuStart = pending.cpuStart;
+		times.cpuMilliseconds = pending.cpuEnd - pending.cpuStart;
+		times.gpuStart = (double)((GLint64)gpuBegin - m_gpuStartTime) / 1000000.0;
+		times.gpuMilliseconds = (double)(gpuEnd - gpuBegin) / 1000000.0;
+		record.scopes.push_back(times);
+	}
+
+	slot.bPending = false;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLatestFrame()
+ *
+ *  This method is used for getting the newest frame whose
+ *  GPU results have been read back.
+ ***********************************************************/
+const FrameProfiler::FRAME_RECORD* FrameProfiler::GetLatestFrame() const
+{
+	if (m_historyCount == 0)
+	{
+		return(NULL);
+	}
+
+	return(&GetKeptFrame(m_historyCount - 1));
+}
+
+/***********************************************************
+ *  GetKeptFrame()
+ *
+ *  This method is used for getting a frame of the history,
+ *  counting from the oldest one.
+ ***********************************************************/
+const FrameProfiler::FRAME_RECORD& FrameProfiler::GetKeptFrame(int index) const
+{
+	return(m_history[(m_historyStart + index) % PROFILER_HISTORY_FRAMES]);
+}
+
+/***********************************************************
+ *  GetSummary()
+ *
+ *  This method is used for writing the frame times and the
+ *  counters of the newest frame as one line of text.  The
+ *  text is written into the passed in buffer, so showing it
+ *  every few frames does not allocate.
+ ***********************************************************/
+void FrameProfiler::GetSummary(char* text, int textSize) const
+{
+	const FRAME_RECORD* frame = GetLatestFrame();
+
+	if (textSize <= 0)
+	{
+		return;
+	}
+
+	text[0] = 0;
+	if ((NULL == frame) || (frame->scopes.empty() == true))
+	{
+		return;
+	}
+
+	snprintf(text, (size_t)textSize,
+		"%.2f ms CPU, %.2f ms GPU, %d draws, %d state changes, %d uniform uploads, %lld triangles, %d allocations",
+		frame->scopes[0].cpuMilliseconds,
+		frame->scopes[0].gpuMilliseconds,
+		frame->counters.drawCalls,
+		frame->counters.stateChanges,
+		frame->counters.uniformUploads,
+		frame->counters.triangles,
+		frame->counters.allocations);
+}
+
+/***********************************************************
+ *  DrawOverlay()
+ *
+ *  This method is used for drawing one row of bars for each
+ *  scope of the newest frame in the top left corner of the
+ *  window.  Half of the window width is the 60 Hz budget.
+ ***********************************************************/
+void FrameProfiler::DrawOverlay(int screenWidth, int screenHeight) const
+{
+	const FRAME_RECORD* frame = GetLatestFrame();
+	GLfloat clearColor[4];
+
+	if ((NULL == frame) || (screenWidth <= 0) || (screenHeight <= 0))
+	{
+		return;
+	}
+
+	float pixelsPerMillisecond = (screenWidth * 0.5f) / g_FrameBudgetMs;
+	int top = screenHeight - g_OverlayMargin;
+	int rowCount = (int)frame->scopes.size();
+
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+	glEnable(GL_SCISSOR_TEST);
+
+	for (int i = 0; i < rowCount; i++)
+	{
+		const SCOPE_TIMES& scope = frame->scopes[i];
+		const float* color = g_ScopeColors[i % g_ScopeColorCount];
+		int x = g_OverlayMargin + (scope.depth * g_DepthIndent);
+		int y = top - ((i + 1) * g_RowHeight);
+
+		DrawOverlayBar(x, y + g_BarHeight, (int)(scope.cpuMilliseconds * pixelsPerMillisecond), g_BarHeight,
+			color[0], color[1], color[2]);
+		DrawOverlayBar(x, y, (int)(scope.gpuMilliseconds * pixelsPerMillisecond), g_BarHeight,
+			color[0] * 0.5f, color[1] * 0.5f, color[2] * 0.5f);
+	}
+
+	// the frame budget marker
+	DrawOverlayBar(g_OverlayMargin + (int)(g_FrameBudgetMs * pixelsPerMillisecond), top - (rowCount * g_RowHeight),
+		2, rowCount * g_RowHeight, 1.0f, 1.0f, 1.0f);
+
+	// the heap allocations of the frame
+	int allocationY = top - ((rowCount + 1) * g_RowHeight);
+	if (frame->counters.allocations == 0)
+	{
+		DrawOverlayBar(g_OverlayMargin, allocationY, g_BarHeight * 2, g_BarHeight * 2, 0.2f, 0.8f, 0.2f);
+	}
+	else
+	{
+		int width = std::min(frame->counters.allocations * g_PixelsPerAllocation, screenWidth - (g_OverlayMargin * 2));
+
+		DrawOverlayBar(g_OverlayMargin, allocationY, width, g_BarHeight * 2, 1.0f, 0.1f, 0.1f);
+	}
+
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+}
+
+/***********************************************************
+ *  WriteCsv()
+ *
+ *  This method is used for writing one line per scope of
+ *  the kept frames, with the counters of its frame.
+ ***********************************************************/
+bool FrameProfiler::WriteCsv(const std::string& filename) const
+{
+	std::ofstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not write profile file:" << filename << std::endl;
+		return(false);
+	}
+
+	file << "frame,scope,depth,cpu_start_ms,cpu_ms,gpu_start_ms,gpu_ms,"
+		<< "draw_calls,state_changes,uniform_uploads,allocations,triangles\n";
+	file << std::fixed << std::setprecision(4);
+	for (int i = 0; i < m_historyCount; i++)
+	{
+		const FRAME_RECORD& frame = GetKeptFrame(i);
+
+		for (const SCOPE_TIMES& scope : frame.scopes)
+		{
+			file << frame.frameNumber << "," << scope.name << "," << scope.depth << ","
+				<< scope.cpuStart << "," << scope.cpuMilliseconds << ","
+				<< scope.gpuStart << "," << scope.gpuMilliseconds << ","
+				<< frame.counters.drawCalls << "," << frame.counters.stateChanges << ","
+				<< frame.counters.uniformUploads << "," << frame.counters.allocations << ","
+				<< frame.counters.triangles << "\n";
+		}
+	}
+
+	std::cout << "INFO: wrote " << m_historyCount << " profiled frames to " << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  WriteChromeTrace()
+ *
+ *  This method is used for writing the kept frames in the
+ *  trace event format of chrome://tracing and Perfetto.
+ *  CPU scopes go on the first track, GPU scopes on the
+ *  second, and the counters are drawn as graphs.
+ ***********************************************************/
+bool FrameProfiler::WriteChromeTrace(const std::string& filename) const
+{
+	std::ofstream file(filename);
+
+	if (file.is_open() == false)
+	{
+		std::cout << "Could not write profile file:" << filename << std::endl;
+		return(false);
+	}
+
+	// trace times are in microseconds
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\":[\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+	file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+	for (int i = 0; i < m_historyCount; i++)
+	{
+		const FRAME_RECORD& frame = GetKeptFrame(i);
+
+		for (const SCOPE_TIMES& scope : frame.scopes)
+		{
+			file << ",\n{\"name\":\"" << scope.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+				<< (scope.cpuStart * 1000.0) << ",\"dur\":" << (scope.cpuMilliseconds * 1000.0) << "}";
+			file << ",\n{\"name\":\"" << scope.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":"
+				<< (scope.gpuStart * 1000.0) << ",\"dur\":" << (scope.gpuMilliseconds * 1000.0) << "}";
+		}
+		if (frame.scopes.empty() == false)
+		{
+			file << ",\n{\"name\":\"frame counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << (frame.scopes[0].cpuStart * 1000.0)
+				<< ",\"args\":{\"draw calls\":" << frame.counters.drawCalls
+				<< ",\"state changes\":" << frame.counters.stateChanges
+				<< ",\"uniform uploads\":" << frame.counters.uniformUploads
+				<< ",\"allocations\":" << frame.counters.allocations << "}}";
+			file << ",\n{\"name\":\"triangles\",\"ph\":\"C\",\"pid\":1,\"ts\":" << (frame.scopes[0].cpuStart * 1000.0)
+				<< ",\"args\":{\"triangles\":" << frame.counters.triangles << "}}";
+		}
+	}
+	file << "\n]}\n";
+
+	std::cout << "INFO: wrote " << m_historyCount << " profiled frames to " << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  CountDrawCall()
+ *
+ *  This method is used for counting a draw call of the
+ *  current frame.
+ ***********************************************************/
+void FrameProfiler::CountDrawCall()
+{
+	g_FrameCounters.drawCalls++;
+}
+
+/***********************************************************
+ *  CountStateChange()
+ *
+ *  This method is used for counting a program, texture or
+ *  vertex array change of the current frame.
+ ***********************************************************/
+void FrameProfiler::CountStateChange()
+{
+	g_FrameCounters.stateChanges++;
+}
+
+/***********************************************************
+ *  CountUniformUpload()
+ *
+ *  This method is used for counting a uniform value or
+ *  uniform block update of the current frame.
+ ***********************************************************/
+void FrameProfiler::CountUniformUpload()
+{
+	g_FrameCounters.uniformUploads++;
+}
+
+/***********************************************************
+ *  GetAllocationCount()
+ *
+ *  This method is used for getting the number of heap
+ *  allocations that all threads have made so far.
+ ***********************************************************/
+long long FrameProfiler::GetAllocationCount()
+{
+	return(g_AllocationCount.load(std::memory_order_relaxed));
+}
+
+/***********************************************************
+ *  ProfileScope()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ProfileScope::ProfileScope(FrameProfiler* pProfiler, const char* name)
+{
+	m_pProfiler = pProfiler;
+	if (NULL != m_pProfiler)
+	{
+		m_pProfiler->BeginScope(name);
+	}
+}
+
+/***********************************************************
+ *  ~ProfileScope()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ProfileScope::~ProfileScope()
+{
+	if (NULL != m_pProfiler)
+	{
+		m_pProfiler->EndScope();
+	}
+}
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// time the parts of each frame on the CPU and the GPU and count draw work
+//
+//	Every scope records the CPU clock and a GL_TIMESTAMP query at its
+//	start and end, so scopes can nest inside each other (only one
+//	GL_TIME_ELAPSED query can run at a time).  The queries of a frame are
+//	read back a few frames later, so profiling never stalls the pipeline.
+//	Draw calls, state changes and uniform uploads are counted by the code
+//	that issues them, and a GL_PRIMITIVES_GENERATED query counts the
+//	triangles of the whole frame.  The heap allocations of every thread
+//	are counted by replacing the global operator new, so a frame loop
+//	that should not allocate can be checked in the overlay.  Recent frames
+//	are kept for the overlay and for the CSV and Chrome trace
+//	(chrome://tracing) files, in records that are reused, so the profiler
+//	does not allocate either once it has been running for a while.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// number of frames a query result may take to become available
+#define PROFILER_FRAME_LATENCY 4
+// number of finished frames kept for the trace files
+#define PROFILER_HISTORY_FRAMES 1800
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class contains the timer queries and the recorded
+ *  scopes of the recent frames, and the code for showing
+ *  and writing them.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// work counted during one frame
+	struct FRAME_COUNTERS
+	{
+		int drawCalls;
+		int stateChanges;
+		int uniformUploads;
+		// calls of operator new between the start and end of the frame
+		int allocations;
+		// primitives drawn, counted by the GPU
+		long long triangles;
+	};
+
+	// times of one scope, in milliseconds since the profiler started
+	struct SCOPE_TIMES
+	{
+		const char* name;
+		// 0 for the frame itself, 1 for scopes directly inside it
+		int depth;
+		double cpuStart;
+		double cpuMilliseconds;
+		double gpuStart;
+		double gpuMilliseconds;
+	};
+
+	// finished frame with the GPU results read back
+	struct FRAME_RECORD
+	{
+		int frameNumber;
+		// the frame scope first, then the scopes in the order they began
+		std::vector<SCOPE_TIMES> scopes;
+		FRAME_COUNTERS counters;
+	};
+
+	// constructor, needs a current GL context
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// start and finish the frame scope and the frame counters
+	void BeginFrame();
+	void EndFrame();
+
+	// start and finish a scope inside the frame, the name must
+	// stay valid as long as the profiler (a string literal)
+	void BeginScope(const char* name);
+	void EndScope();
+
+	// the newest frame whose results have arrived, NULL if none yet
+	const FRAME_RECORD* GetLatestFrame() const;
+	// write one line with the frame times and counters of the newest
+	// frame into a text buffer, empty before the first frame
+	void GetSummary(char* text, int textSize) const;
+
+	// draw the scope times of the newest frame as bars
+	void DrawOverlay(int screenWidth, int screenHeight) const;
+
+	// write the kept frames as a table or as a Chrome trace
+	bool WriteCsv(const std::string& filename) const;
+	bool WriteChromeTrace(const std::string& filename) const;
+
+	// count work of the current frame, may be called without a profiler
+	static void CountDrawCall();
+	static void CountStateChange();
+	static void CountUniformUpload();
+	// number of heap allocations since the program started
+	static long long GetAllocationCount();
+
+private:
+	// scope of a frame whose queries are not read back yet
+	struct PENDING_SCOPE
+	{
+		const char* name;
+		int depth;
+		double cpuStart;
+		double cpuEnd;
+		int beginQuery;
+		int endQuery;
+	};
+
+	// queries and scopes of one frame in flight
+	struct FRAME_SLOT
+	{
+		bool bPending;
+		int frameNumber;
+		std::vector<PENDING_SCOPE> scopes;
+		// timestamp queries, reused by the frames of this slot
+		std::vector<GLuint> queries;
+		int usedQueries;
+		GLuint primitivesQuery;
+		FRAME_COUNTERS counters;
+	};
+
+	FRAME_SLOT m_slots[PROFILER_FRAME_LATENCY];
+	// slot of the frame being recorded
+	int m_currentSlot;
+	int m_frameNumber;
+	// true between BeginFrame() and EndFrame()
+	bool m_bInFrame;
+	// scopes of the current frame that have not ended, innermost last
+	std::vector<int> m_openScopes;
+	// allocation count when the current frame began
+	long long m_frameAllocations;
+	// ring of the finished frames, the oldest one at m_historyStart
+	std::vector<FRAME_RECORD> m_history;
+	int m_historyStart;
+	int m_historyCount;
+	// CPU and GPU clocks when the profiler started
+	std::chrono::steady_clock::time_point m_startTime;
+	GLint64 m_gpuStartTime;
+
+	// milliseconds on the CPU clock since the profiler started
+	double GetCpuMilliseconds() const;
+	// record a timestamp query in the current frame
+	int IssueTimestamp();
+	// read back the results of a frame once they have arrived,
+	// or wait for them
+	bool ResolveFrame(FRAME_SLOT& slot, bool bWait);
+	// get a kept frame, 0 for the oldest one
+	const FRAME_RECORD& GetKeptFrame(int index) const;
+};
+
+/***********************************************************
+ *  ProfileScope
+ *
+ *  This class contains a profiler scope that lasts until
+ *  the end of the enclosing block.  A NULL profiler turns
+ *  the scope into nothing.
+ ***********************************************************/
+class ProfileScope
+{
+public:
+	// constructor
+	ProfileScope(FrameProfiler* pProfiler, const char* name);
+	// destructor
+	~ProfileScope();
+
+private:
+	FrameProfiler* m_pProfiler;
+};
@@ -0,0 +1,265 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustumculler.cpp
+// ============
+// test world space bounding boxes against the camera view frustum
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FRUSTUM_CULLER_SSE2
+#include <emmintrin.h>
+#endif
+
+// declaration of the global variables and defines
+namespace
+{
+	// boxes tested together by the SIMD path
+	const int g_BoxesPerGroup = 4;
+}
+
+/***********************************************************
+ *  FrustumCuller()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrustumCuller::FrustumCuller()
+{
+	m_boundsCount = 0;
+
+	// everything is inside until a frustum is set
+	for (int i = 0; i < 6; i++)
+	{
+		m_planeX[i] = 0.0f;
+		m_planeY[i] = 0.0f;
+		m_planeZ[i] = 0.0f;
+		m_planeD[i] = 1.0f;
+		m_planeAbsX[i] = 0.0f;
+		m_planeAbsY[i] = 0.0f;
+		m_planeAbsZ[i] = 0.0f;
+	}
+}
+
+/***********************************************************
+ *  SetFrustum()
+ *
+ *  This method is used for extracting the left, right,
+ *  bottom, top, near and far planes from the rows of the
+ *  combined camera matrix.  The planes are not normalized,
+ *  since the box test only compares signs.
+ ***********************************************************/
+void FrustumCuller::SetFrustum(const glm::mat4& viewProjection)
+{
+	// glm matrices are column major, so row i is m[0][i]..m[3][i]
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	glm::vec4 planes[6] = {
+		rows[3] + rows[0],
+		rows[3] - rows[0],
+		rows[3] + rows[1],
+		rows[3] - rows[1],
+		rows[3] + rows[2],
+		rows[3] - rows[2]
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		m_planeX[i] = planes[i].x;
+		m_planeY[i] = planes[i].y;
+		m_planeZ[i] = planes[i].z;
+		m_planeD[i] = planes[i].w;
+		m_planeAbsX[i] = std::fabs(planes[i].x);
+		m_planeAbsY[i] = std::fabs(planes[i].y);
+		m_planeAbsZ[i] = std::fabs(planes[i].z);
+	}
+}
+
+/***********************************************************
+ *  GetPlane()
+ *
+ *  This method is used for getting a frustum plane in the
+ *  order of SetFrustum(), for a culling test run elsewhere.
+ ***********************************************************/
+glm::vec4 FrustumCuller::GetPlane(int plane) const
+{
+	if ((plane < 0) || (plane >= 6))
+	{
+		return(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+
+	return(glm::vec4(m_planeX[plane], m_planeY[plane], m_planeZ[plane], m_planeD[plane]));
+}
+
+/***********************************************************
+ *  SetBoundsCount()
+ *
+ *  This method is used for setting the number of bounding
+ *  boxes.  The arrays are padded to whole groups of boxes.
+ ***********************************************************/
+void FrustumCuller::SetBoundsCount(int count)
+{
+	int paddedCount = ((count + g_BoxesPerGroup - 1) / g_BoxesPerGroup) * g_BoxesPerGroup;
+
+	m_boundsCount = count;
+	m_centerX.resize(paddedCount, 0.0f);
+	m_centerY.resize(paddedCount, 0.0f);
+	m_centerZ.resize(paddedCount, 0.0f);
+	m_extentX.resize(paddedCount, 0.0f);
+	m_extentY.resize(paddedCount, 0.0f);
+	m_extentZ.resize(paddedCount, 0.0f);
+}
+
+/***********************************************************
+ *  GetBoundsCount()
+ *
+ *  This method is used for getting the number of bounding
+ *  boxes.
+ ***********************************************************/
+int FrustumCuller::GetBoundsCount() const
+{
+	return(m_boundsCount);
+}
+
+/***********************************************************
+ *  SetBounds()
+ *
+ *  This method is used for setting the world space bounding
+ *  box of an object.
+ ***********************************************************/
+void FrustumCuller::SetBounds(int index, const glm::vec3& minPoint, const glm::vec3& maxPoint)
+{
+	if ((index < 0) || (index >= m_boundsCount))
+	{
+		return;
+	}
+
+	glm::vec3 center = (minPoint + maxPoint) * 0.5f;
+	glm::vec3 extent = (maxPoint - minPoint) * 0.5f;
+
+	m_centerX[index] = center.x;
+	m_centerY[index] = center.y;
+	m_centerZ[index] = center.z;
+	m_extentX[index] = extent.x;
+	m_extentY[index] = extent.y;
+	m_extentZ[index] = extent.z;
+}
+
+/***********************************************************
+ *  CullBounds()
+ *
+ *  This method is used for testing every box against the
+ *  frustum planes.  A box is behind a plane when its center
+ *  distance plus its extent projected on the plane normal
+ *  is negative.
+ ***********************************************************/
+int FrustumCuller::CullBounds(std::vector<unsigned char>& visible) const
+{
+	visible.resize(m_boundsCount);
+
+	return(CullBounds(visible, 0, m_boundsCount));
+}
+
+/***********************************************************
+ *  CullBounds()
+ *
+ *  This method is used for testing a range of the boxes
+ *  against the frustum planes.  The ranges of different
+ *  calls may be tested at the same time.
+ ***********************************************************/
+int FrustumCuller::CullBounds(std::vector<unsigned char>& visible, int firstBox, int lastBox) const
+{
+	int visibleCount = 0;
+	int index = std::max(firstBox, 0);
+
+	lastBox = std::min(lastBox, m_boundsCount);
+
+#ifdef FRUSTUM_CULLER_SSE2
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; (index + g_BoxesPerGroup) <= lastBox; index += g_BoxesPerGroup)
+	{
+		__m128 centerX = _mm_loadu_ps(&m_centerX[index]);
+		__m128 centerY = _mm_loadu_ps(&m_centerY[index]);
+		__m128 centerZ = _mm_loadu_ps(&m_centerZ[index]);
+		__m128 extentX = _mm_loadu_ps(&m_extentX[index]);
+		__m128 extentY = _mm_loadu_ps(&m_extentY[index]);
+		__m128 extentZ = _mm_loadu_ps(&m_extentZ[index]);
+		__m128 outside = zero;
+
+		for (int plane = 0; plane < 6; plane++)
+		{
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(m_planeX[plane])), _mm_mul_ps(centerY, _mm_set1_ps(m_planeY[plane]))),
+				_mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(m_planeZ[plane])), _mm_set1_ps(m_planeD[plane])));
+			__m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(extentX, _mm_set1_ps(m_planeAbsX[plane])), _mm_mul_ps(extentY, _mm_set1_ps(m_planeAbsY[plane]))),
+				_mm_mul_ps(extentZ, _mm_set1_ps(m_planeAbsZ[plane])));
+
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+		}
+
+		int outsideMask = _mm_movemask_ps(outside);
+		for (int i = 0; i < g_BoxesPerGroup; i++)
+		{
+			visible[index + i] = ((outsideMask & (1 << i)) == 0) ? 1 : 0;
+			visibleCount += visible[index + i];
+		}
+	}
+#endif
+
+	// whatever the SIMD path left over, or every box without it
+	for (; index < lastBox; index++)
+	{
+		bool bOutside = false;
+
+		for (int plane = 0; (plane < 6) && (bOutside == false); plane++)
+		{
+			float distance = (m_centerX[index] * m_planeX[plane]) + (m_centerY[index] * m_planeY[plane]) +
+				(m_centerZ[index] * m_planeZ[plane]) + m_planeD[plane];
+			float radius = (m_extentX[index] * m_planeAbsX[plane]) + (m_extentY[index] * m_planeAbsY[plane]) +
+				(m_extentZ[index] * m_planeAbsZ[plane]);
+
+			bOutside = ((distance + radius) < 0.0f);
+		}
+
+		visible[index] = (bOutside == true) ? 0 : 1;
+		visibleCount += visible[index];
+	}
+
+	return(visibleCount);
+}
+
+/***********************************************************
+ *  TransformBounds()
+ *
+ *  This method is used for getting the world space box that
+ *  holds a local box after it has been transformed.  The
+ *  center is transformed and the half extent is spread over
+ *  the axes by the absolute values of the matrix.
+ ***********************************************************/
+void FrustumCuller::TransformBounds(
+	const glm::mat4& matrix,
+	const glm::vec3& minPoint,
+	const glm::vec3& maxPoint,
+	glm::vec3& worldMin,
+	glm::vec3& worldMax)
+{
+	glm::vec3 center = glm::vec3(matrix * glm::vec4((minPoint + maxPoint) * 0.5f, 1.0f));
+	glm::vec3 extent = (maxPoint - minPoint) * 0.5f;
+	glm::vec3 worldExtent(0.0f);
+
+	for (int column = 0; column < 3; column++)
+	{
+		worldExtent += glm::abs(glm::vec3(matrix[column])) * extent[column];
+	}
+
+	worldMin = center - worldExtent;
+	worldMax = center + worldExtent;
+}
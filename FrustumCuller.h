@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+// frustumculler.h
+// ============
+// test world space bounding boxes against the camera view frustum
+//
+//	The six frustum planes are extracted from projection * view.  Boxes
+//	are kept as center and half extent in structure-of-arrays form, so the
+//	test runs on four boxes at a time with SSE2 where it is available and
+//	one box at a time otherwise.  A box is culled when it lies completely
+//	behind any one plane, which never culls a visible box but can keep a
+//	few boxes near the frustum corners that are not visible.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  FrustumCuller
+ *
+ *  This class contains the bounding boxes of the scene
+ *  objects and the code for testing them against a view
+ *  frustum.
+ ***********************************************************/
+class FrustumCuller
+{
+public:
+	// constructor
+	FrustumCuller();
+
+	// extract the frustum planes of a camera
+	void SetFrustum(const glm::mat4& viewProjection);
+	// get one of the frustum planes as its normal and distance
+	glm::vec4 GetPlane(int plane) const;
+
+	// set the number of bounding boxes, new boxes are empty
+	void SetBoundsCount(int count);
+	int GetBoundsCount() const;
+	// set the world space bounding box of an object
+	void SetBounds(int index, const glm::vec3& minPoint, const glm::vec3& maxPoint);
+
+	// test every box against the frustum, visible is set to 1 for
+	// the boxes inside and 0 for the culled ones, and the number
+	// of visible boxes is returned
+	int CullBounds(std::vector<unsigned char>& visible) const;
+	// test the boxes first to last - 1 only, so separate threads can
+	// test separate ranges, visible must already hold every box
+	int CullBounds(std::vector<unsigned char>& visible, int firstBox, int lastBox) const;
+
+	// get the world space box around a transformed local box
+	static void TransformBounds(
+		const glm::mat4& matrix,
+		const glm::vec3& minPoint,
+		const glm::vec3& maxPoint,
+		glm::vec3& worldMin,
+		glm::vec3& worldMax);
+
+private:
+	// plane normals, absolute normals and distances, N.p + d >= 0 inside
+	float m_planeX[6];
+	float m_planeY[6];
+	float m_planeZ[6];
+	float m_planeD[6];
+	float m_planeAbsX[6];
+	float m_planeAbsY[6];
+	float m_planeAbsZ[6];
+
+	int m_boundsCount;
+	// box centers and half extents, padded to a multiple of four
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_extentX;
+	std::vector<float> m_extentY;
+	std::vector<float> m_extentZ;
+};
@@ -0,0 +1,386 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculler.cpp
+// ============
+// cull the instanced scene objects and build their draw commands on the GPU
+//
+//	The command, instance and level of detail buffers are only touched by
+//	the GPU once they are created.  The commands are reset by copying the
+//	template over them, so no data goes from the CPU to the GPU in a frame
+//	except the occlusion group visibility.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuCuller.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// storage buffer bindings and work group size, these match
+	// cullComputeShader.glsl
+	const GLuint g_ObjectBinding = 0;
+	const GLuint g_CommandBinding = 1;
+	const GLuint g_InstanceBinding = 2;
+	const GLuint g_LodBinding = 3;
+	const GLuint g_GroupBinding = 4;
+	const int g_WorkGroupSize = 64;
+
+	// bytes of each region of the object and group streams, they
+	// grow when a scene needs more
+	const size_t g_ObjectStreamBytes = 64 * 1024;
+	const size_t g_GroupStreamBytes = 4 * 1024;
+}
+
+/***********************************************************
+ *  GpuCuller()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuCuller::GpuCuller()
+{
+	GLint offsetAlignment = 16;
+
+	m_program = 0;
+	m_objectCountLocation = -1;
+	m_viewProjectionLocation = -1;
+	m_planesLocation = -1;
+	m_frustumCullingLocation = -1;
+	m_occlusionCullingLocation = -1;
+	m_levelOfDetailLocation = -1;
+	m_nearPlaneLocation = -1;
+	m_lodScaleLocation = -1;
+	m_lodScreenSizesLocation = -1;
+	m_lodHysteresisLocation = -1;
+
+	glGenBuffers(1, &m_commandTemplate);
+	glGenBuffers(1, &m_commandBuffer);
+	glGenBuffers(1, &m_instanceBuffer);
+	glGenBuffers(1, &m_lodBuffer);
+	m_commandCount = 0;
+	m_instanceCapacity = 0;
+
+	// storage buffer ranges must start on this alignment
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+	m_objectStream = new StreamBuffer(g_ObjectStreamBytes, (size_t)std::max(offsetAlignment, 1));
+	m_objectOffset = 0;
+	m_objectCount = 0;
+	m_groupStream = new StreamBuffer(g_GroupStreamBytes, (size_t)std::max(offsetAlignment, 1));
+	m_groupOffset = 0;
+	m_groupCount = 0;
+}
+
+/***********************************************************
+ *  ~GpuCuller()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuCuller::~GpuCuller()
+{
+	if (m_program != 0)
+	{
+		glDeleteProgram(m_program);
+		m_program = 0;
+	}
+
+	glDeleteBuffers(1, &m_commandTemplate);
+	glDeleteBuffers(1, &m_commandBuffer);
+	glDeleteBuffers(1, &m_instanceBuffer);
+	glDeleteBuffers(1, &m_lodBuffer);
+	m_commandTemplate = 0;
+	m_commandBuffer = 0;
+	m_instanceBuffer = 0;
+	m_lodBuffer = 0;
+
+	delete m_objectStream;
+	m_objectStream = NULL;
+	delete m_groupStream;
+	m_groupStream = NULL;
+}
+
+/***********************************************************
+ *  IsSupported()
+ *
+ *  This method is used for checking whether the driver has
+ *  compute shaders and storage buffers, and can draw the
+ *  commands they write with base instances in one call.
+ ***********************************************************/
+bool GpuCuller::IsSupported()
+{
+	return((GLEW_ARB_compute_shader != 0) && (GLEW_ARB_shader_storage_buffer_object != 0) &&
+		(GLEW_ARB_draw_indirect != 0) && (GLEW_ARB_multi_draw_indirect != 0) && (GLEW_ARB_base_instance != 0));
+}
+
+/***********************************************************
+ *  LoadShader()
+ *
+ *  This method is used for reading the compute shader file
+ *  and building the program.  The uniform locations are
+ *  looked up once, since the program never changes.
+ ***********************************************************/
+bool GpuCuller::LoadShader(const char* computeShaderPath)
+{
+	std::ifstream file(computeShaderPath);
+	if (!file.is_open())
+	{
+		std::cout << "Could not open shader file:" << computeShaderPath << std::endl;
+		return(false);
+	}
+
+	std::stringstream contents;
+	contents << file.rdbuf();
+
+	GLuint program = BuildProgram(contents.str().c_str());
+	if (program == 0)
+	{
+		return(false);
+	}
+
+	if (m_program != 0)
+	{
+		glDeleteProgram(m_program);
+	}
+	m_program = program;
+
+	m_objectCountLocation = glGetUniformLocation(m_program, "objectCount");
+	m_viewProjectionLocation = glGetUniformLocation(m_program, "viewProjection");
+	m_planesLocation = glGetUniformLocation(m_program, "frustumPlanes");
+	m_frustumCullingLocation = glGetUniformLocation(m_program, "bFrustumCulling");
+	m_occlusionCullingLocation = glGetUniformLocation(m_program, "bOcclusionCulling");
+	m_levelOfDetailLocation = glGetUniformLocation(m_program, "bLevelOfDetail");
+	m_nearPlaneLocation = glGetUniformLocation(m_program, "nearPlane");
+	m_lodScaleLocation = glGetUniformLocation(m_program, "lodScale");
+	m_lodScreenSizesLocation = glGetUniformLocation(m_program, "lodScreenSizes");
+	m_lodHysteresisLocation = glGetUniformLocation(m_program, "lodHysteresis");
+
+	return(true);
+}
+
+/***********************************************************
+ *  BuildProgram()
+ *
+ *  This method is used for compiling the compute shader and
+ *  linking it into a program.  Returns 0 and prints the log
+ *  if either step fails.
+ ***********************************************************/
+GLuint GpuCuller::BuildProgram(const char* source)
+{
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	GLint success = 0;
+	GLchar infoLog[1024];
+
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::SHADER_COMPILATION_ERROR of compute shader\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(0);
+	}
+
+	GLuint programID = glCreateProgram();
+	glAttachShader(programID, shader);
+	glLinkProgram(programID);
+
+	// the linked program keeps the compiled code
+	glDetachShader(programID, shader);
+	glDeleteShader(shader);
+
+	glGetProgramiv(programID, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(programID, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::PROGRAM_LINKING_ERROR of compute shader\n" << infoLog << std::endl;
+		glDeleteProgram(programID);
+		return(0);
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  IsReady()
+ *
+ *  This method is used for checking whether the compute
+ *  program has been built.
+ ***********************************************************/
+bool GpuCuller::IsReady() const
+{
+	return(m_program != 0);
+}
+
+/***********************************************************
+ *  SetCommands()
+ *
+ *  This method is used for uploading the draw commands with
+ *  their mesh ranges and instance runs and no instances,
+ *  and making room for the instances of all of them.  The
+ *  culled commands and instances never go through the CPU.
+ ***********************************************************/
+void GpuCuller::SetCommands(const std::vector<InstancedMeshes::DRAW_COMMAND>& commands, int instanceCapacity)
+{
+	GLsizeiptr commandBytes = (GLsizeiptr)(std::max(commands.size(), (size_t)1) * sizeof(InstancedMeshes::DRAW_COMMAND));
+
+	m_commandCount = (int)commands.size();
+	m_instanceCapacity = std::max(instanceCapacity, 1);
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandTemplate);
+	glBufferData(GL_COPY_WRITE_BUFFER, commandBytes, NULL, GL_STATIC_DRAW);
+	if (commands.empty() == false)
+	{
+		glBufferSubData(GL_COPY_WRITE_BUFFER, 0, commands.size() * sizeof(InstancedMeshes::DRAW_COMMAND), commands.data());
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, commandBytes, NULL, GL_DYNAMIC_COPY);
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_instanceBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, m_instanceCapacity * sizeof(InstancedMeshes::CULLED_INSTANCE), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  SetObjects()
+ *
+ *  This method is used for writing the object records into
+ *  the object stream, which the passes keep reading until
+ *  the objects change again.  The levels of detail start
+ *  over at the full tessellation when the count changes.
+ ***********************************************************/
+void GpuCuller::SetObjects(const std::vector<OBJECT_RECORD>& objects)
+{
+	if (objects.empty() == false)
+	{
+		m_objectOffset = m_objectStream->Write(objects.data(), objects.size() * sizeof(OBJECT_RECORD));
+	}
+
+	if ((int)objects.size() != m_objectCount)
+	{
+		std::vector<GLuint> levels(std::max(objects.size(), (size_t)1), 0);
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_lodBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, levels.size() * sizeof(GLuint), levels.data(), GL_DYNAMIC_COPY);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	m_objectCount = (int)objects.size();
+}
+
+/***********************************************************
+ *  SetGroupVisibility()
+ *
+ *  This method is used for writing the occlusion group
+ *  results of the frame into the group stream.  One entry
+ *  is always written so the range bound to the shader is
+ *  never empty.
+ ***********************************************************/
+void GpuCuller::SetGroupVisibility(const std::vector<GLuint>& groupVisible)
+{
+	const GLuint visible = 1;
+
+	m_groupCount = std::max((int)groupVisible.size(), 1);
+	if (groupVisible.empty() == true)
+	{
+		m_groupOffset = m_groupStream->Write(&visible, sizeof(GLuint));
+	}
+	else
+	{
+		m_groupOffset = m_groupStream->Write(groupVisible.data(), groupVisible.size() * sizeof(GLuint));
+	}
+}
+
+/***********************************************************
+ *  CullObjects()
+ *
+ *  This method is used for resetting the commands and
+ *  running the compute shader over all of the objects.  The
+ *  barrier makes the written commands and instances visible
+ *  to the indirect draws and the levels of detail to the
+ *  next pass.
+ ***********************************************************/
+void GpuCuller::CullObjects(const CULL_VIEW& view)
+{
+	if ((m_program == 0) || (m_commandCount == 0))
+	{
+		return;
+	}
+
+	// every command starts the pass with no instances
+	glBindBuffer(GL_COPY_READ_BUFFER, m_commandTemplate);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_commandBuffer);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+		m_commandCount * sizeof(InstancedMeshes::DRAW_COMMAND));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (m_objectCount == 0)
+	{
+		return;
+	}
+
+	glUseProgram(m_program);
+	glUniform1ui(m_objectCountLocation, (GLuint)m_objectCount);
+	glUniformMatrix4fv(m_viewProjectionLocation, 1, GL_FALSE, glm::value_ptr(view.viewProjection));
+	glUniform4fv(m_planesLocation, 6, glm::value_ptr(view.planes[0]));
+	glUniform1i(m_frustumCullingLocation, (int)view.bFrustumCulling);
+	glUniform1i(m_occlusionCullingLocation, (int)view.bOcclusionCulling);
+	glUniform1i(m_levelOfDetailLocation, (int)view.bLevelOfDetail);
+	glUniform1f(m_nearPlaneLocation, view.nearPlane);
+	glUniform1f(m_lodScaleLocation, view.lodScale);
+	glUniform1fv(m_lodScreenSizesLocation, MESH_LOD_LEVELS - 1, view.lodScreenSizes);
+	glUniform1f(m_lodHysteresisLocation, view.lodHysteresis);
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, g_ObjectBinding, m_objectStream->GetBuffer(), m_objectOffset,
+		(GLsizeiptr)(m_objectCount * sizeof(OBJECT_RECORD)));
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_CommandBinding, m_commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_InstanceBinding, m_instanceBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_LodBinding, m_lodBuffer);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, g_GroupBinding, m_groupStream->GetBuffer(), m_groupOffset,
+		(GLsizeiptr)(m_groupCount * sizeof(GLuint)));
+
+	glDispatchCompute((GLuint)((m_objectCount + g_WorkGroupSize - 1) / g_WorkGroupSize), 1, 1);
+
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+/***********************************************************
+ *  GetCommandBuffer()
+ *
+ *  This method is used for getting the buffer of the culled
+ *  draw commands, to bind as the draw indirect buffer.
+ ***********************************************************/
+GLuint GpuCuller::GetCommandBuffer() const
+{
+	return(m_commandBuffer);
+}
+
+/***********************************************************
+ *  GetInstanceBuffer()
+ *
+ *  This method is used for getting the buffer of the culled
+ *  instances, which the base instance of each command
+ *  indexes into.
+ ***********************************************************/
+GLuint GpuCuller::GetInstanceBuffer() const
+{
+	return(m_instanceBuffer);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the regions of the
+ *  object and group streams that the pass of this frame
+ *  read.
+ ***********************************************************/
+void GpuCuller::EndFrame()
+{
+	m_objectStream->EndFrame();
+	m_groupStream->EndFrame();
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuculler.h
+// ============
+// cull the instanced scene objects and build their draw commands on the GPU
+//
+//	The world matrix, local bounding box, material and occlusion group of
+//	every instanced object live in a shader storage buffer that is only
+//	written when the objects change.  Each frame a compute shader (see
+//	cullComputeShader.glsl) tests every object against the view frustum
+//	and the visibility of its occlusion group, picks its level of detail
+//	and appends the object to the DrawElementsIndirectCommand of its mesh
+//	and level with an atomic add on the instance count.  The surviving
+//	matrices and materials are packed into the instance buffer at the base
+//	instance of their command, so the commands can be drawn straight from
+//	the GPU with glMultiDrawElementsIndirect() and the CPU never sees the
+//	visible set.  Needs GL_ARB_compute_shader and
+//	GL_ARB_shader_storage_buffer_object along with the multi-draw indirect
+//	extensions, otherwise the scene keeps culling on the CPU.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "InstancedMeshes.h"
+#include "StreamBuffer.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  GpuCuller
+ *
+ *  This class contains the object and command buffers of
+ *  the GPU culling pass and the compute program that fills
+ *  the draw commands.
+ ***********************************************************/
+class GpuCuller
+{
+public:
+	// one instanced object, laid out as the std430 ObjectRecord
+	// struct of the compute shader
+	struct OBJECT_RECORD
+	{
+		glm::mat4 world;
+		// local bounding box of the mesh, w unused
+		glm::vec4 minPoint;
+		glm::vec4 maxPoint;
+		// command of the full tessellation of the mesh, the other
+		// levels of detail follow it
+		GLuint firstCommand;
+		// 1 for a mesh without levels of detail
+		GLuint lodCount;
+		// material drawn with the object, -1 for the draw's own
+		GLint materialIndex;
+		// occlusion group of the object, ~0 for none
+		GLuint occlusionGroup;
+	};
+
+	// camera and switches of a culling pass
+	struct CULL_VIEW
+	{
+		glm::mat4 viewProjection;
+		// frustum planes, N.p + d >= 0 inside
+		glm::vec4 planes[6];
+		bool bFrustumCulling;
+		bool bOcclusionCulling;
+		bool bLevelOfDetail;
+		float nearPlane;
+		// projection[1][1] times the screen height, which turns a
+		// radius over the clip w into pixels
+		float lodScale;
+		float lodScreenSizes[MESH_LOD_LEVELS - 1];
+		float lodHysteresis;
+	};
+
+	// constructor, needs a current GL context
+	GpuCuller();
+	// destructor
+	~GpuCuller();
+
+	// check if the driver has everything the GPU culling pass needs
+	static bool IsSupported();
+
+	// build the compute program from a shader file, false if it
+	// could not be built
+	bool LoadShader(const char* computeShaderPath);
+	// true once the compute program has been built
+	bool IsReady() const;
+
+	// set the draw commands that the objects are added to, with
+	// no instances, and the instances all of them can hold
+	void SetCommands(const std::vector<InstancedMeshes::DRAW_COMMAND>& commands, int instanceCapacity);
+	// replace the instanced objects
+	void SetObjects(const std::vector<OBJECT_RECORD>& objects);
+	// set 1 for each occlusion group that was not found occluded
+	void SetGroupVisibility(const std::vector<GLuint>& groupVisible);
+
+	// run the culling pass, the commands and instances can be
+	// drawn once it returns, the current program is changed
+	void CullObjects(const CULL_VIEW& view);
+
+	// buffers that the culled commands and instances are read from
+	GLuint GetCommandBuffer() const;
+	GLuint GetInstanceBuffer() const;
+
+	// fence the stream regions read by this frame's culling pass,
+	// called once the draws of the frame are submitted
+	void EndFrame();
+
+private:
+	GLuint m_program;
+	// cached uniform locations of the compute program
+	GLint m_objectCountLocation;
+	GLint m_viewProjectionLocation;
+	GLint m_planesLocation;
+	GLint m_frustumCullingLocation;
+	GLint m_occlusionCullingLocation;
+	GLint m_levelOfDetailLocation;
+	GLint m_nearPlaneLocation;
+	GLint m_lodScaleLocation;
+	GLint m_lodScreenSizesLocation;
+	GLint m_lodHysteresisLocation;
+
+	// commands with no instances, copied over the culled ones
+	// before every pass
+	GLuint m_commandTemplate;
+	GLuint m_commandBuffer;
+	int m_commandCount;
+	// culled instances, written by the compute shader only
+	GLuint m_instanceBuffer;
+	int m_instanceCapacity;
+	// level of detail each object was last drawn at
+	GLuint m_lodBuffer;
+
+	// object records and group visibility, the latest write of
+	// each is read by the pass
+	StreamBuffer* m_objectStream;
+	GLintptr m_objectOffset;
+	int m_objectCount;
+	StreamBuffer* m_groupStream;
+	GLintptr m_groupOffset;
+	int m_groupCount;
+
+	// compile and link the compute program, 0 if it fails
+	static GLuint BuildProgram(const char* source);
+};
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// gputimer.cpp
+// ============
+// measure how long the GPU spends on a block of GL commands
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuTimer.h"
+
+#include <iostream>
+
+/***********************************************************
+ *  GpuTimer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuTimer::GpuTimer(std::string name, int reportInterval)
+{
+	m_name = name;
+	m_reportInterval = reportInterval;
+	m_nextQuery = 0;
+	m_totalMilliseconds = 0.0;
+	m_sampleCount = 0;
+	m_averageMilliseconds = -1.0;
+	m_latestMilliseconds = -1.0;
+
+	glGenQueries(GPU_TIMER_QUERIES, m_queries);
+	for (int i = 0; i < GPU_TIMER_QUERIES; i++)
+	{
+		m_bPending[i] = false;
+	}
+}
+
+/***********************************************************
+ *  ~GpuTimer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuTimer::~GpuTimer()
+{
+	glDeleteQueries(GPU_TIMER_QUERIES, m_queries);
+}
+
+/***********************************************************
+ *  Begin()
+ *
+ *  This method is used for starting to time the following
+ *  GL commands.  If the oldest query in the ring has still
+ *  not finished, it is waited on so its result is not lost.
+ ***********************************************************/
+void GpuTimer::Begin()
+{
+	ReadResults();
+
+	if (m_bPending[m_nextQuery] == true)
+	{
+		GLuint64 elapsed = 0;
+
+		glGetQueryObjectui64v(m_queries[m_nextQuery], GL_QUERY_RESULT, &elapsed);
+		m_latestMilliseconds = (double)elapsed / 1000000.0;
+		m_totalMilliseconds += m_latestMilliseconds;
+		m_sampleCount++;
+		m_bPending[m_nextQuery] = false;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, m_queries[m_nextQuery]);
+}
+
+/***********************************************************
+ *  End()
+ *
+ *  This method is used for stopping the timing started by
+ *  Begin().  The result is read back in a later frame.
+ ***********************************************************/
+void GpuTimer::End()
+{
+	glEndQuery(GL_TIME_ELAPSED);
+
+	m_bPending[m_nextQuery] = true;
+	m_nextQuery = (m_nextQuery + 1) % GPU_TIMER_QUERIES;
+}
+
+/***********************************************************
+ *  ReadResults()
+ *
+ *  This method is used for collecting the results of the
+ *  finished queries, oldest first, and averaging them over
+ *  the report interval.
+ ***********************************************************/
+void GpuTimer::ReadResults()
+{
+	for (int i = 0; i < GPU_TIMER_QUERIES; i++)
+	{
+		int query = (m_nextQuery + i) % GPU_TIMER_QUERIES;
+		GLint bAvailable = 0;
+		GLuint64 elapsed = 0;
+
+		if (m_bPending[query] == false)
+		{
+			continue;
+		}
+
+		glGetQueryObjectiv(m_queries[query], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		if (bAvailable == 0)
+		{
+			break;
+		}
+
+		glGetQueryObjectui64v(m_queries[query], GL_QUERY_RESULT, &elapsed);
+		m_latestMilliseconds = (double)elapsed / 1000000.0;
+		m_totalMilliseconds += m_latestMilliseconds;
+		m_sampleCount++;
+		m_bPending[query] = false;
+	}
+
+	if ((m_reportInterval > 0) && (m_sampleCount >= m_reportInterval))
+	{
+		m_averageMilliseconds = m_totalMilliseconds / m_sampleCount;
+		std::cout << "INFO: " << m_name << " GPU time: " << m_averageMilliseconds << " ms (average of " << m_sampleCount << " frames)" << std::endl;
+		m_totalMilliseconds = 0.0;
+		m_sampleCount = 0;
+	}
+}
+
+/***********************************************************
+ *  GetAverageMilliseconds()
+ *
+ *  This method is used for getting the average GPU time of
+ *  the last completed report interval.
+ ***********************************************************/
+double GpuTimer::GetAverageMilliseconds() const
+{
+	return(m_averageMilliseconds);
+}
+
+/***********************************************************
+ *  GetLatestMilliseconds()
+ *
+ *  This method is used for getting the GPU time of the
+ *  newest frame whose query has finished, which is a few
+ *  frames old.
+ ***********************************************************/
+double GpuTimer::GetLatestMilliseconds() const
+{
+	return(m_latestMilliseconds);
+}
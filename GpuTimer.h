@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+// gputimer.h
+// ============
+// measure how long the GPU spends on a block of GL commands
+//
+//	GL_TIME_ELAPSED queries are kept in a small ring and read back a few
+//	frames later, so measuring never stalls the pipeline.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+// number of frames a query result may take to become available
+#define GPU_TIMER_QUERIES 4
+
+/***********************************************************
+ *  GpuTimer
+ *
+ *  This class contains the code for timing a block of GL
+ *  commands each frame and reporting the average time.
+ ***********************************************************/
+class GpuTimer
+{
+public:
+	// constructor
+	GpuTimer(std::string name, int reportInterval);
+	// destructor
+	~GpuTimer();
+
+	// start and stop timing the GL commands of this frame
+	void Begin();
+	void End();
+
+	// average GPU time of the last full report interval, -1 if none yet
+	double GetAverageMilliseconds() const;
+	// GPU time of the newest finished frame, -1 if none yet
+	double GetLatestMilliseconds() const;
+
+private:
+	// name printed with the report
+	std::string m_name;
+	// number of timed frames per report, 0 for no printed report
+	int m_reportInterval;
+	// ring of timer queries
+	GLuint m_queries[GPU_TIMER_QUERIES];
+	bool m_bPending[GPU_TIMER_QUERIES];
+	int m_nextQuery;
+	// results gathered for the current report interval
+	double m_totalMilliseconds;
+	int m_sampleCount;
+	double m_averageMilliseconds;
+	double m_latestMilliseconds;
+
+	// collect the results of the queries that have finished
+	void ReadResults();
+};
@@ -0,0 +1,510 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmeshes.cpp
+// ============
+// basic shape meshes that are drawn many times with one instanced draw call
+//
+//	The shapes are generated by ShapeGeometry to match the ShapeMeshes
+//	conventions, so an instanced copy lines up with a regular draw.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "InstancedMeshes.h"
+#include "FrameProfiler.h"
+#include "ShapeGeometry.h"
+
+#include <algorithm>
+#include <cstddef>
+
+// declaration of the global variables and defines
+namespace
+{
+	// interleaved vertex layout - position, normal, texture coordinate
+	const GLuint g_FloatsPerVertex = ShapeGeometry::FLOATS_PER_VERTEX;
+	// first attribute location of the per-instance model matrix
+	const GLuint g_InstanceAttribute = 3;
+	// attribute location of the per-instance material of the culled instances
+	const GLuint g_MaterialAttribute = 7;
+
+	// segments around the cylinder and sphere and sphere rings
+	// of each level of detail
+	const int g_LodSegments[MESH_LOD_LEVELS] = { ShapeGeometry::ROUND_SEGMENTS, 16, 8 };
+	const int g_LodRings[MESH_LOD_LEVELS] = { ShapeGeometry::SPHERE_RINGS, 8, 4 };
+
+	// bytes of each region of the instance matrix and multi-draw
+	// command streams, they grow when a frame needs more
+	const size_t g_InstanceStreamBytes = 256 * 1024;
+	const size_t g_CommandStreamBytes = 16 * 1024;
+}
+
+/***********************************************************
+ *  InstancedMeshes()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+InstancedMeshes::InstancedMeshes()
+{
+	m_boxMesh = {};
+	for (int level = 0; level < MESH_LOD_LEVELS; level++)
+	{
+		m_cylinderMeshes[level] = {};
+		m_sphereMeshes[level] = {};
+	}
+
+	m_instanceStream = new StreamBuffer(g_InstanceStreamBytes, sizeof(glm::mat4));
+	m_instanceOffset = 0;
+
+	glGenVertexArrays(1, &m_vao);
+	glGenBuffers(1, &m_vertexBuffer);
+	glGenBuffers(1, &m_indexBuffer);
+
+	// position, normal and texture coordinate
+	const GLsizei stride = sizeof(GLfloat) * g_FloatsPerVertex;
+
+	glBindVertexArray(m_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 3));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 6));
+	glEnableVertexAttribArray(2);
+
+	// the model matrix takes four attribute slots, one per column,
+	// and advances once per instance instead of once per vertex
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceStream->GetBuffer());
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glEnableVertexAttribArray(g_InstanceAttribute + column);
+		glVertexAttribPointer(g_InstanceAttribute + column, 4, GL_FLOAT, GL_FALSE,
+			sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * column));
+		glVertexAttribDivisor(g_InstanceAttribute + column, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// the base instance of each command selects its run of matrices
+	m_commandStream = NULL;
+	if ((GLEW_ARB_draw_indirect != 0) && (GLEW_ARB_multi_draw_indirect != 0) && (GLEW_ARB_base_instance != 0))
+	{
+		m_commandStream = new StreamBuffer(g_CommandStreamBytes, sizeof(GLuint));
+	}
+}
+
+/***********************************************************
+ *  ~InstancedMeshes()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+InstancedMeshes::~InstancedMeshes()
+{
+	glDeleteVertexArrays(1, &m_vao);
+	glDeleteBuffers(1, &m_vertexBuffer);
+	glDeleteBuffers(1, &m_indexBuffer);
+	m_vao = 0;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+
+	if (NULL != m_commandStream)
+	{
+		delete m_commandStream;
+		m_commandStream = NULL;
+	}
+
+	delete m_instanceStream;
+	m_instanceStream = NULL;
+}
+
+/***********************************************************
+ *  AddMesh()
+ *
+ *  This method is used for appending the vertices and
+ *  indices of a mesh to the shared buffers.  The indices
+ *  stay relative to the first vertex of the mesh, which the
+ *  draws pass as the base vertex.  Meshes are only added
+ *  while the scene is prepared, so the buffers are simply
+ *  uploaded again.
+ ***********************************************************/
+InstancedMeshes::MESH_RANGE InstancedMeshes::AddMesh(
+	const std::vector<GLfloat>& vertices,
+	const std::vector<GLuint>& indices)
+{
+	MESH_RANGE mesh;
+
+	mesh.firstIndex = (GLuint)m_indices.size();
+	mesh.nIndices = (GLuint)indices.size();
+	mesh.baseVertex = (GLint)(m_vertices.size() / g_FloatsPerVertex);
+
+	m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+	m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(GLfloat), m_vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// the element buffer binding belongs to the vertex array
+	glBindVertexArray(m_vao);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint), m_indices.data(), GL_STATIC_DRAW);
+	glBindVertexArray(0);
+
+	return(mesh);
+}
+
+/***********************************************************
+ *  LoadBoxMesh()
+ *
+ *  This method is used for creating a unit cube centered on
+ *  the origin, with four vertices per face so each face has
+ *  its own normal and full texture coordinates.
+ ***********************************************************/
+void InstancedMeshes::LoadBoxMesh()
+{
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint> indices;
+
+	ShapeGeometry::BuildBox(vertices, indices);
+	m_boxMesh = AddMesh(vertices, indices);
+}
+
+/***********************************************************
+ *  LoadCylinderMesh()
+ *
+ *  This method is used for creating a closed cylinder with
+ *  a radius of 1 that stands from y = 0 to y = 1, once for
+ *  every level of detail.
+ ***********************************************************/
+void InstancedMeshes::LoadCylinderMesh()
+{
+	for (int level = 0; level < MESH_LOD_LEVELS; level++)
+	{
+		std::vector<GLfloat> vertices;
+		std::vector<GLuint> indices;
+
+		ShapeGeometry::BuildCylinder(vertices, indices, g_LodSegments[level]);
+		m_cylinderMeshes[level] = AddMesh(vertices, indices);
+	}
+}
+
+/***********************************************************
+ *  LoadSphereMesh()
+ *
+ *  This method is used for creating a sphere with a radius
+ *  of 1 centered on the origin, once for every level of
+ *  detail.
+ ***********************************************************/
+void InstancedMeshes::LoadSphereMesh()
+{
+	for (int level = 0; level < MESH_LOD_LEVELS; level++)
+	{
+		std::vector<GLfloat> vertices;
+		std::vector<GLuint> indices;
+
+		ShapeGeometry::BuildSphere(vertices, indices, g_LodSegments[level], g_LodRings[level]);
+		m_sphereMeshes[level] = AddMesh(vertices, indices);
+	}
+}
+
+/***********************************************************
+ *  SetInstanceTransforms()
+ *
+ *  This method is used for writing the model matrices of
+ *  all instances into the instance stream.  The draws read
+ *  from the offset of the latest write, and the matrices of
+ *  earlier frames are left for the draws still in flight.
+ ***********************************************************/
+void InstancedMeshes::SetInstanceTransforms(const glm::mat4* transforms, int count)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	m_instanceOffset = m_instanceStream->Write(transforms, count * sizeof(glm::mat4));
+}
+
+/***********************************************************
+ *  BeginInstanceTransforms()
+ *
+ *  This method is used for getting the memory of the
+ *  instance stream that the model matrices of all instances
+ *  are written into, which saves copying them first.  The
+ *  memory may be uncached, so it should only be written,
+ *  in order.
+ ***********************************************************/
+glm::mat4* InstancedMeshes::BeginInstanceTransforms(int count)
+{
+	return(static_cast<glm::mat4*>(m_instanceStream->BeginWrite(std::max(count, 1) * sizeof(glm::mat4))));
+}
+
+/***********************************************************
+ *  EndInstanceTransforms()
+ *
+ *  This method is used for finishing the matrices started
+ *  with BeginInstanceTransforms() and drawing from them.
+ ***********************************************************/
+void InstancedMeshes::EndInstanceTransforms()
+{
+	m_instanceOffset = m_instanceStream->EndWrite();
+}
+
+/***********************************************************
+ *  SetInstanceOffset()
+ *
+ *  This method is used for pointing the instance attributes
+ *  of the shared vertex array at a matrix of the latest
+ *  write to the instance stream.  The vertex array must be
+ *  bound.
+ ***********************************************************/
+void InstancedMeshes::SetInstanceOffset(int firstInstance) const
+{
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceStream->GetBuffer());
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glVertexAttribPointer(g_InstanceAttribute + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+			(void*)(m_instanceOffset + (firstInstance * sizeof(glm::mat4)) + (sizeof(glm::vec4) * column)));
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  DrawMeshInstanced()
+ *
+ *  This method is used for drawing a run of instances of a
+ *  mesh.  The instance attributes are pointed at the first
+ *  matrix of the run, which keeps this usable without
+ *  base-instance support on OpenGL 3.3.
+ ***********************************************************/
+void InstancedMeshes::DrawMeshInstanced(
+	const MESH_RANGE& mesh,
+	int firstInstance,
+	int instanceCount) const
+{
+	if ((mesh.nIndices == 0) || (instanceCount <= 0))
+	{
+		return;
+	}
+
+	glBindVertexArray(m_vao);
+	SetInstanceOffset(firstInstance);
+
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.nIndices, GL_UNSIGNED_INT,
+		(void*)(mesh.firstIndex * sizeof(GLuint)), instanceCount, mesh.baseVertex);
+	FrameProfiler::CountStateChange();
+	FrameProfiler::CountDrawCall();
+
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  DrawBoxMeshInstanced()
+ *
+ *  This method is used for drawing a run of box instances.
+ ***********************************************************/
+void InstancedMeshes::DrawBoxMeshInstanced(int firstInstance, int instanceCount) const
+{
+	DrawMeshInstanced(m_boxMesh, firstInstance, instanceCount);
+}
+
+/***********************************************************
+ *  DrawCylinderMeshInstanced()
+ *
+ *  This method is used for drawing a run of cylinder instances
+ *  at a level of detail.
+ ***********************************************************/
+void InstancedMeshes::DrawCylinderMeshInstanced(int firstInstance, int instanceCount, int lodLevel) const
+{
+	DrawMeshInstanced(m_cylinderMeshes[ClampLodLevel(lodLevel)], firstInstance, instanceCount);
+}
+
+/***********************************************************
+ *  DrawSphereMeshInstanced()
+ *
+ *  This method is used for drawing a run of sphere instances
+ *  at a level of detail.
+ ***********************************************************/
+void InstancedMeshes::DrawSphereMeshInstanced(int firstInstance, int instanceCount, int lodLevel) const
+{
+	DrawMeshInstanced(m_sphereMeshes[ClampLodLevel(lodLevel)], firstInstance, instanceCount);
+}
+
+/***********************************************************
+ *  IsMultiDrawSupported()
+ *
+ *  This method is used for checking whether the driver can
+ *  draw several instance runs with one multi-draw.
+ ***********************************************************/
+bool InstancedMeshes::IsMultiDrawSupported() const
+{
+	return(NULL != m_commandStream);
+}
+
+/***********************************************************
+ *  GetCommand()
+ *
+ *  This method is used for getting the multi-draw command
+ *  of a run of instances of a mesh.
+ ***********************************************************/
+InstancedMeshes::DRAW_COMMAND InstancedMeshes::GetCommand(
+	const MESH_RANGE& mesh,
+	int firstInstance,
+	int instanceCount)
+{
+	DRAW_COMMAND command;
+
+	command.count = mesh.nIndices;
+	command.instanceCount = (GLuint)instanceCount;
+	command.firstIndex = mesh.firstIndex;
+	command.baseVertex = mesh.baseVertex;
+	command.baseInstance = (GLuint)firstInstance;
+
+	return(command);
+}
+
+/***********************************************************
+ *  GetBoxCommand()
+ *
+ *  This method is used for getting the multi-draw command
+ *  of a run of box instances.
+ ***********************************************************/
+InstancedMeshes::DRAW_COMMAND InstancedMeshes::GetBoxCommand(int firstInstance, int instanceCount) const
+{
+	return(GetCommand(m_boxMesh, firstInstance, instanceCount));
+}
+
+/***********************************************************
+ *  GetCylinderCommand()
+ *
+ *  This method is used for getting the multi-draw command
+ *  of a run of cylinder instances at a level of detail.
+ ***********************************************************/
+InstancedMeshes::DRAW_COMMAND InstancedMeshes::GetCylinderCommand(int firstInstance, int instanceCount, int lodLevel) const
+{
+	return(GetCommand(m_cylinderMeshes[ClampLodLevel(lodLevel)], firstInstance, instanceCount));
+}
+
+/***********************************************************
+ *  GetSphereCommand()
+ *
+ *  This method is used for getting the multi-draw command
+ *  of a run of sphere instances at a level of detail.
+ ***********************************************************/
+InstancedMeshes::DRAW_COMMAND InstancedMeshes::GetSphereCommand(int firstInstance, int instanceCount, int lodLevel) const
+{
+	return(GetCommand(m_sphereMeshes[ClampLodLevel(lodLevel)], firstInstance, instanceCount));
+}
+
+/***********************************************************
+ *  MultiDrawInstanced()
+ *
+ *  This method is used for drawing several runs of instances
+ *  with one glMultiDrawElementsIndirect().  The instance
+ *  attributes start at the first matrix, and the base
+ *  instance of each command moves them to its run.  The
+ *  commands are written into the command stream, so the
+ *  commands of an earlier draw still in flight are kept.
+ ***********************************************************/
+void InstancedMeshes::MultiDrawInstanced(const std::vector<DRAW_COMMAND>& commands)
+{
+	if (commands.empty() == true)
+	{
+		return;
+	}
+
+	if (NULL == m_commandStream)
+	{
+		glBindVertexArray(m_vao);
+		for (const DRAW_COMMAND& command : commands)
+		{
+			SetInstanceOffset((int)command.baseInstance);
+			glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+				(void*)(command.firstIndex * sizeof(GLuint)), command.instanceCount, command.baseVertex);
+			FrameProfiler::CountStateChange();
+			FrameProfiler::CountDrawCall();
+		}
+		glBindVertexArray(0);
+		return;
+	}
+
+	GLintptr commandOffset = m_commandStream->Write(commands.data(), commands.size() * sizeof(DRAW_COMMAND));
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandStream->GetBuffer());
+	glBindVertexArray(m_vao);
+	SetInstanceOffset(0);
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)commandOffset, (GLsizei)commands.size(), 0);
+	FrameProfiler::CountStateChange();
+	FrameProfiler::CountDrawCall();
+	glBindVertexArray(0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/***********************************************************
+ *  MultiDrawCulled()
+ *
+ *  This method is used for drawing commands that the GPU
+ *  culling pass filled in, without reading them back.  The
+ *  instance attributes are pointed at the culled instances,
+ *  and the material attribute is only enabled for the draw
+ *  so the other instanced draws never read it.
+ ***********************************************************/
+void InstancedMeshes::MultiDrawCulled(GLuint commandBuffer, int firstCommand, int commandCount, GLuint instanceBuffer)
+{
+	if (commandCount <= 0)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+	glBindVertexArray(m_vao);
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	for (GLuint column = 0; column < 4; column++)
+	{
+		glVertexAttribPointer(g_InstanceAttribute + column, 4, GL_FLOAT, GL_FALSE, sizeof(CULLED_INSTANCE),
+			(void*)(offsetof(CULLED_INSTANCE, model) + (sizeof(glm::vec4) * column)));
+	}
+	glVertexAttribIPointer(g_MaterialAttribute, 1, GL_INT, sizeof(CULLED_INSTANCE),
+		(void*)offsetof(CULLED_INSTANCE, materialIndex));
+	glVertexAttribDivisor(g_MaterialAttribute, 1);
+	glEnableVertexAttribArray(g_MaterialAttribute);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+		(void*)(firstCommand * sizeof(DRAW_COMMAND)), (GLsizei)commandCount, 0);
+	FrameProfiler::CountStateChange();
+	FrameProfiler::CountDrawCall();
+
+	glDisableVertexAttribArray(g_MaterialAttribute);
+	glBindVertexArray(0);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the regions of the
+ *  instance and command streams that the draws of this
+ *  frame read, so they are not written again until the
+ *  GPU is done with them.
+ ***********************************************************/
+void InstancedMeshes::EndFrame()
+{
+	m_instanceStream->EndFrame();
+
+	if (NULL != m_commandStream)
+	{
+		m_commandStream->EndFrame();
+	}
+}
+
+/***********************************************************
+ *  ClampLodLevel()
+ *
+ *  This method is used for keeping a level of detail within
+ *  the loaded levels.
+ ***********************************************************/
+int InstancedMeshes::ClampLodLevel(int lodLevel)
+{
+	return((lodLevel < 0) ? 0 : ((lodLevel >= MESH_LOD_LEVELS) ? (MESH_LOD_LEVELS - 1) : lodLevel));
+}
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// instancedmeshes.h
+// ============
+// basic shape meshes that are drawn many times with one instanced draw call
+//
+//	Instance model matrices are read from a shared StreamBuffer at
+//	attribute locations 3-6 (see vertexShader.glsl).  The cylinder and
+//	sphere are loaded at MESH_LOD_LEVELS tessellations, level 0 being the
+//	full one, so that small instances can be drawn with fewer vertices.
+//	All of the meshes share one vertex buffer, index buffer and vertex
+//	array, and each mesh is a range of them, so switching meshes between
+//	draws changes no GL state.  Where the driver supports multi-draw
+//	indirect and base instances, several instance runs that only differ in
+//	their mesh are drawn with a single glMultiDrawElementsIndirect().  The
+//	commands and instances written by the GPU culling pass are drawn the
+//	same way, with the material of each instance at attribute location 7.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "StreamBuffer.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// number of tessellations of the cylinder and sphere
+#define MESH_LOD_LEVELS 3
+
+/***********************************************************
+ *  InstancedMeshes
+ *
+ *  This class contains the code for loading the box,
+ *  cylinder and sphere meshes with the same dimensions as
+ *  ShapeMeshes and drawing runs of instances of them.
+ ***********************************************************/
+class InstancedMeshes
+{
+public:
+	// one draw of a multi-draw, laid out as the
+	// DrawElementsIndirectCommand that GL reads
+	struct DRAW_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// one instance written by the GPU culling pass, laid out as
+	// the std430 CulledInstance struct of cullComputeShader.glsl
+	struct CULLED_INSTANCE
+	{
+		glm::mat4 model;
+		GLint materialIndex;
+		GLint padding[3];
+	};
+
+	// constructor
+	InstancedMeshes();
+	// destructor
+	~InstancedMeshes();
+
+	// load the meshes into GPU memory
+	void LoadBoxMesh();
+	void LoadCylinderMesh();
+	void LoadSphereMesh();
+
+	// upload the model matrices used by all instanced draws
+	void SetInstanceTransforms(const glm::mat4* transforms, int count);
+	// get the memory of the instance stream to write the model
+	// matrices into, and start drawing from it once they are written
+	glm::mat4* BeginInstanceTransforms(int count);
+	void EndInstanceTransforms();
+
+	// draw a run of instances from the uploaded model matrices
+	void DrawBoxMeshInstanced(int firstInstance, int instanceCount) const;
+	void DrawCylinderMeshInstanced(int firstInstance, int instanceCount, int lodLevel = 0) const;
+	void DrawSphereMeshInstanced(int firstInstance, int instanceCount, int lodLevel = 0) const;
+
+	// check if runs of instances can be drawn with one multi-draw
+	bool IsMultiDrawSupported() const;
+	// get the multi-draw command of a run of instances
+	DRAW_COMMAND GetBoxCommand(int firstInstance, int instanceCount) const;
+	DRAW_COMMAND GetCylinderCommand(int firstInstance, int instanceCount, int lodLevel = 0) const;
+	DRAW_COMMAND GetSphereCommand(int firstInstance, int instanceCount, int lodLevel = 0) const;
+	// draw all of the commands with one draw call, or one at a
+	// time when multi-draw is not supported
+	void MultiDrawInstanced(const std::vector<DRAW_COMMAND>& commands);
+	// draw a run of the commands written by the GPU culling pass,
+	// with the culled instances as the instance attributes
+	void MultiDrawCulled(GLuint commandBuffer, int firstCommand, int commandCount, GLuint instanceBuffer);
+
+	// fence the stream regions read by this frame's draws, called
+	// once the draws of the frame are submitted
+	void EndFrame();
+
+private:
+	// index range of one mesh in the shared buffers
+	struct MESH_RANGE
+	{
+		GLuint firstIndex;
+		GLuint nIndices;
+		GLint baseVertex;
+	};
+
+	MESH_RANGE m_boxMesh;
+	MESH_RANGE m_cylinderMeshes[MESH_LOD_LEVELS];
+	MESH_RANGE m_sphereMeshes[MESH_LOD_LEVELS];
+
+	// vertex array and buffers shared by all of the meshes
+	GLuint m_vao;
+	GLuint m_vertexBuffer;
+	GLuint m_indexBuffer;
+	// copies of the loaded geometry, uploaded again whenever a
+	// mesh is added
+	std::vector<GLfloat> m_vertices;
+	std::vector<GLuint> m_indices;
+
+	// per-instance model matrices shared by all of the meshes
+	StreamBuffer* m_instanceStream;
+	// offset of the latest matrices in the instance stream
+	GLintptr m_instanceOffset;
+
+	// stream of the multi-draw commands, NULL without multi-draw support
+	StreamBuffer* m_commandStream;
+
+	// append a mesh to the shared buffers and get its range
+	MESH_RANGE AddMesh(
+		const std::vector<GLfloat>& vertices,
+		const std::vector<GLuint>& indices);
+	// point the instance attributes at a run of matrices
+	void SetInstanceOffset(int firstInstance) const;
+	// draw a run of instances of a mesh
+	void DrawMeshInstanced(
+		const MESH_RANGE& mesh,
+		int firstInstance,
+		int instanceCount) const;
+	// get the multi-draw command of a run of instances of a mesh
+	static DRAW_COMMAND GetCommand(
+		const MESH_RANGE& mesh,
+		int firstInstance,
+		int instanceCount);
+	// clamp a level of detail to the loaded levels
+	static int ClampLodLevel(int lodLevel);
+};
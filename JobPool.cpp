@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobpool.cpp
+// ============
+// split loops over the scene into jobs that run on worker threads
+///////////////////////////////////////////////////////////////////////////////
+
+#include "JobPool.h"
+
+#include <algorithm>
+
+/***********************************************************
+ *  JobPool()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+JobPool::JobPool(int workerCount)
+{
+	m_bStopping = false;
+	m_bEnabled = true;
+	m_loopNumber = 0;
+	m_busyWorkers = 0;
+	m_callback = NULL;
+	m_pFunction = NULL;
+	m_itemCount = 0;
+	m_itemsPerJob = 1;
+	m_jobCount = 0;
+	m_nextJob = 0;
+
+	if (workerCount <= 0)
+	{
+		workerCount = (int)std::thread::hardware_concurrency() - 1;
+		if (workerCount <= 0)
+		{
+			workerCount = 1;
+		}
+	}
+
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&JobPool::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~JobPool()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+JobPool::~JobPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_loopStarted.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of threads
+ *  that run the jobs of a loop.
+ ***********************************************************/
+int JobPool::GetThreadCount() const
+{
+	if (m_bEnabled == false)
+	{
+		return(1);
+	}
+
+	return((int)m_workers.size() + 1);
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for switching between running the
+ *  jobs on all of the threads and on the calling thread
+ *  only, which gives the same results.
+ ***********************************************************/
+void JobPool::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  IsEnabled()
+ *
+ *  This method is used for checking whether the jobs are
+ *  run on the worker threads.
+ ***********************************************************/
+bool JobPool::IsEnabled() const
+{
+	return(m_bEnabled);
+}
+
+/***********************************************************
+ *  GetJobCount()
+ *
+ *  This method is used for getting the number of jobs that
+ *  ParallelFor() cuts a loop into, so the caller can make
+ *  an output buffer for each of them.
+ ***********************************************************/
+int JobPool::GetJobCount(int itemCount, int itemsPerJob)
+{
+	if (itemCount <= 0)
+	{
+		return(0);
+	}
+
+	itemsPerJob = std::max(itemsPerJob, 1);
+
+	return((itemCount + itemsPerJob - 1) / itemsPerJob);
+}
+
+/***********************************************************
+ *  RunLoop()
+ *
+ *  This method is used for running a loop as jobs of up to
+ *  itemsPerJob items.  The calling thread runs jobs too and
+ *  only returns when all of them are finished.  A loop with
+ *  a single job never wakes the workers.
+ ***********************************************************/
+void JobPool::RunLoop(int itemCount, int itemsPerJob, JOB_CALLBACK callback, const void* pFunction)
+{
+	int jobCount = GetJobCount(itemCount, itemsPerJob);
+
+	itemsPerJob = std::max(itemsPerJob, 1);
+	if (jobCount == 0)
+	{
+		return;
+	}
+
+	if ((m_bEnabled == false) || (jobCount == 1) || (m_workers.empty() == true))
+	{
+		for (int job = 0; job < jobCount; job++)
+		{
+			callback(pFunction, job, job * itemsPerJob, std::min((job + 1) * itemsPerJob, itemCount));
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_callback = callback;
+		m_pFunction = pFunction;
+		m_itemCount = itemCount;
+		m_itemsPerJob = itemsPerJob;
+		m_jobCount = jobCount;
+		m_nextJob = 0;
+		m_busyWorkers = (int)m_workers.size();
+		m_loopNumber++;
+	}
+	m_loopStarted.notify_all();
+
+	RunJobs();
+
+	// the function and the loop values must stay valid until
+	// every worker has let go of them
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_loopFinished.wait(lock, [this]() { return(m_busyWorkers == 0); });
+	m_callback = NULL;
+	m_pFunction = NULL;
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for waiting until a loop is started
+ *  and helping to run its jobs, until the pool is stopped.
+ ***********************************************************/
+void JobPool::WorkerLoop()
+{
+	int lastLoop = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_loopStarted.wait(lock, [this, lastLoop]() { return((m_bStopping == true) || (m_loopNumber != lastLoop)); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+			lastLoop = m_loopNumber;
+		}
+
+		RunJobs();
+
+		bool bLastWorker = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_busyWorkers--;
+			bLastWorker = (m_busyWorkers == 0);
+		}
+		if (bLastWorker == true)
+		{
+			m_loopFinished.notify_one();
+		}
+	}
+}
+
+/***********************************************************
+ *  RunJobs()
+ *
+ *  This method is used for taking the next job of the
+ *  current loop and running it, until every job has been
+ *  taken.
+ ***********************************************************/
+void JobPool::RunJobs()
+{
+	int job = m_nextJob.fetch_add(1);
+
+	while (job < m_jobCount)
+	{
+		m_callback(m_pFunction, job, job * m_itemsPerJob, std::min((job + 1) * m_itemsPerJob, m_itemCount));
+		job = m_nextJob.fetch_add(1);
+	}
+}
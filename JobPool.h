@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobpool.h
+// ============
+// split loops over the scene into jobs that run on worker threads
+//
+//	A parallel loop is cut into jobs of a fixed number of items.  The
+//	workers and the calling thread take the next job from a shared atomic
+//	counter until none are left, so a thread that finishes early keeps
+//	taking the jobs the slower threads have not reached, and the call
+//	returns once every job is done.  Each job has its own index, which the
+//	callers use for giving every job its own output buffer and merging the
+//	buffers in job order, so the results do not depend on which thread ran
+//	which job.  The loop function is only referenced while the loop runs,
+//	never copied, so starting a loop does not allocate.  The jobs must not
+//	make any GL calls.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  JobPool
+ *
+ *  This class contains the worker threads and the code for
+ *  running the jobs of a parallel loop on them.
+ ***********************************************************/
+class JobPool
+{
+public:
+	// runs the items first to last of one job of a loop function
+	typedef void (*JOB_CALLBACK)(const void* pFunction, int job, int first, int last);
+
+	// constructor, 0 worker threads picks one less than the
+	// number of hardware threads, since the caller works too
+	JobPool(int workerCount);
+	// destructor
+	~JobPool();
+
+	// number of threads that run jobs, the caller included
+	int GetThreadCount() const;
+	// run every job on the calling thread only when disabled
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const;
+
+	// number of jobs that a loop over itemCount items is cut into
+	static int GetJobCount(int itemCount, int itemsPerJob);
+	// run the jobs of a loop over itemCount items and wait for all of
+	// them, the function is called as function(job, first, last)
+	template <typename FUNCTION>
+	void ParallelFor(int itemCount, int itemsPerJob, const FUNCTION& function)
+	{
+		RunLoop(itemCount, itemsPerJob, &CallFunction<FUNCTION>, &function);
+	}
+
+private:
+	// worker threads that run the jobs
+	std::vector<std::thread> m_workers;
+	// guards the loop being run and the stop flag
+	std::mutex m_mutex;
+	std::condition_variable m_loopStarted;
+	std::condition_variable m_loopFinished;
+	bool m_bStopping;
+	bool m_bEnabled;
+	// counts the started loops, so workers can tell a new one apart
+	int m_loopNumber;
+	// workers that have not finished the current loop
+	int m_busyWorkers;
+
+	// the loop being run
+	JOB_CALLBACK m_callback;
+	const void* m_pFunction;
+	int m_itemCount;
+	int m_itemsPerJob;
+	int m_jobCount;
+	// next job that has not been taken by a thread
+	std::atomic<int> m_nextJob;
+
+	// call a loop function of a known type
+	template <typename FUNCTION>
+	static void CallFunction(const void* pFunction, int job, int first, int last)
+	{
+		(*static_cast<const FUNCTION*>(pFunction))(job, first, last);
+	}
+	// run the jobs of a loop with the function behind a callback
+	void RunLoop(int itemCount, int itemsPerJob, JOB_CALLBACK callback, const void* pFunction);
+	// wait for loops and help run them until the pool is destroyed
+	void WorkerLoop();
+	// take and run jobs of the current loop until none are left
+	void RunJobs();
+};
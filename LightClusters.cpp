@@ -0,0 +1,416 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.cpp
+// ============
+// bin the scene point lights into the clusters of the camera view
+//
+//	The cluster grid buffer holds an (offset, count) pair per cluster,
+//	with the x tile changing fastest, then the y tile, then the slice.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+// declaration of the global variables and defines
+namespace
+{
+	const int g_TotalClusters = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+
+	// bytes of each region of the cluster stream, room for the grid
+	// and a few tens of thousands of light indices
+	const size_t g_ClusterStreamBytes = 256 * 1024;
+
+	/***********************************************************
+	 *  UnprojectPoint()
+	 *
+	 *  Returns the view space point of a normalized device
+	 *  coordinate through the inverse projection matrix.
+	 ***********************************************************/
+	glm::vec3 UnprojectPoint(const glm::mat4& inverseProjection, float x, float y, float z)
+	{
+		glm::vec4 point = inverseProjection * glm::vec4(x, y, z, 1.0f);
+
+		return(glm::vec3(point.x, point.y, point.z) / point.w);
+	}
+
+	/***********************************************************
+	 *  SphereTouchesBox()
+	 *
+	 *  Returns true if the sphere overlaps the bounding box.
+	 ***********************************************************/
+	bool SphereTouchesBox(glm::vec3 center, float radius, glm::vec3 minPoint, glm::vec3 maxPoint)
+	{
+		glm::vec3 closest = glm::max(minPoint, glm::min(center, maxPoint));
+		glm::vec3 offset = center - closest;
+
+		return(glm::dot(offset, offset) <= radius * radius);
+	}
+}
+
+/***********************************************************
+ *  LightClusters()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightClusters::LightClusters()
+{
+	m_boundsProjection = glm::mat4(0.0f);
+	m_boundsNear = 0.0f;
+	m_boundsFar = 0.0f;
+	m_indexCapacity = 0;
+	m_maxIndexCount = 0;
+	m_bReportedTruncation = false;
+
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &m_maxIndexCount);
+
+	m_clusterGrid.assign(g_TotalClusters * 2, 0);
+
+	// the grid always has one entry per cluster
+	glGenBuffers(1, &m_gridBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_gridBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, m_clusterGrid.size() * sizeof(GLuint), m_clusterGrid.data(), GL_DYNAMIC_DRAW);
+	glGenTextures(1, &m_gridTexture);
+	glBindTexture(GL_TEXTURE_BUFFER, m_gridTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, m_gridBuffer);
+
+	// the index list grows with the number of lights in view
+	glGenBuffers(1, &m_indexBuffer);
+	glGenTextures(1, &m_indexTexture);
+
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	// with texture buffer ranges both lists are written into one
+	// stream buffer and the textures are pointed at the latest writes
+	m_clusterStream = NULL;
+	if (GLEW_ARB_texture_buffer_range != 0)
+	{
+		GLint offsetAlignment = 0;
+
+		glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+		m_clusterStream = new StreamBuffer(g_ClusterStreamBytes, (size_t)std::max(offsetAlignment, 1));
+	}
+}
+
+/***********************************************************
+ *  ~LightClusters()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightClusters::~LightClusters()
+{
+	if (NULL != m_clusterStream)
+	{
+		delete m_clusterStream;
+		m_clusterStream = NULL;
+	}
+	glDeleteTextures(1, &m_gridTexture);
+	glDeleteTextures(1, &m_indexTexture);
+	glDeleteBuffers(1, &m_gridBuffer);
+	glDeleteBuffers(1, &m_indexBuffer);
+}
+
+/***********************************************************
+ *  GetDepthSlice()
+ *
+ *  This method is used for getting the depth slice that a
+ *  positive view space depth falls in.  The slices split the
+ *  near to far range exponentially, the same way the
+ *  fragment shader looks them up.
+ ***********************************************************/
+int LightClusters::GetDepthSlice(float viewDepth) const
+{
+	if (viewDepth <= m_boundsNear)
+	{
+		return(0);
+	}
+
+	int slice = (int)(std::log(viewDepth / m_boundsNear) / std::log(m_boundsFar / m_boundsNear) * CLUSTER_SLICES);
+
+	return(std::min(std::max(slice, 0), CLUSTER_SLICES - 1));
+}
+
+/***********************************************************
+ *  BuildClusterBounds()
+ *
+ *  This method is used for calculating the view space
+ *  bounding box of every cluster.  Going through the inverse
+ *  projection works for both the perspective and the
+ *  orthographic camera.  The boxes only change along with
+ *  the projection.
+ ***********************************************************/
+void LightClusters::BuildClusterBounds(
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane)
+{
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	m_boundsProjection = projection;
+	m_boundsNear = nearPlane;
+	m_boundsFar = farPlane;
+	m_clusterBounds.resize(g_TotalClusters);
+
+	for (int slice = 0; slice < CLUSTER_SLICES; slice++)
+	{
+		float sliceNear = nearPlane * std::pow(farPlane / nearPlane, (float)slice / CLUSTER_SLICES);
+		float sliceFar = nearPlane * std::pow(farPlane / nearPlane, (float)(slice + 1) / CLUSTER_SLICES);
+
+		for (int tileY = 0; tileY < CLUSTER_TILES_Y; tileY++)
+		{
+			for (int tileX = 0; tileX < CLUSTER_TILES_X; tileX++)
+			{
+				float x0 = -1.0f + 2.0f * tileX / CLUSTER_TILES_X;
+				float x1 = -1.0f + 2.0f * (tileX + 1) / CLUSTER_TILES_X;
+				float y0 = -1.0f + 2.0f * tileY / CLUSTER_TILES_Y;
+				float y1 = -1.0f + 2.0f * (tileY + 1) / CLUSTER_TILES_Y;
+				float cornersX[4] = { x0, x1, x0, x1 };
+				float cornersY[4] = { y0, y0, y1, y1 };
+				CLUSTER_BOUNDS bounds;
+
+				bounds.minPoint = glm::vec3(std::numeric_limits<float>::max());
+				bounds.maxPoint = glm::vec3(-std::numeric_limits<float>::max());
+
+				// where the corner rays of the tile cross the slice planes
+				for (int corner = 0; corner < 4; corner++)
+				{
+					glm::vec3 nearPoint = UnprojectPoint(inverseProjection, cornersX[corner], cornersY[corner], -1.0f);
+					glm::vec3 farPoint = UnprojectPoint(inverseProjection, cornersX[corner], cornersY[corner], 1.0f);
+					glm::vec3 ray = farPoint - nearPoint;
+					float sliceDepths[2] = { sliceNear, sliceFar };
+
+					for (int plane = 0; plane < 2; plane++)
+					{
+						float t = (-sliceDepths[plane] - nearPoint.z) / ray.z;
+						glm::vec3 point = nearPoint + ray * t;
+
+						bounds.minPoint = glm::min(bounds.minPoint, point);
+						bounds.maxPoint = glm::max(bounds.maxPoint, point);
+					}
+				}
+
+				m_clusterBounds[(slice * CLUSTER_TILES_Y + tileY) * CLUSTER_TILES_X + tileX] = bounds;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildClusters()
+ *
+ *  This method is used for finding the clusters that each
+ *  point light reaches and building the per-cluster light
+ *  index lists.  Only the depth slices covered by the light
+ *  radius are tested against the light.  The pairs start
+ *  with the room the last frame needed.
+ ***********************************************************/
+void LightClusters::BuildClusters(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane,
+	const std::vector<ShaderUniforms::POINT_LIGHT>& lights,
+	FrameArena* pArena)
+{
+	bool bTruncated = false;
+
+	if ((m_clusterBounds.empty() == true) || (m_boundsProjection != projection) ||
+		(m_boundsNear != nearPlane) || (m_boundsFar != farPlane))
+	{
+		BuildClusterBounds(projection, nearPlane, farPlane);
+	}
+
+	m_clusterPairs.Reset(pArena, m_clusterPairs.Size());
+
+	for (int lightIndex = 0; lightIndex < (int)lights.size(); lightIndex++)
+	{
+		glm::vec4 viewCenter = view * glm::vec4(lights[lightIndex].position, 1.0f);
+		glm::vec3 center = glm::vec3(viewCenter.x, viewCenter.y, viewCenter.z);
+		float radius = lights[lightIndex].radius;
+		float viewDepth = -center.z;
+
+		// skip lights that are completely in front of or behind the view
+		if ((viewDepth + radius < nearPlane) || (viewDepth - radius > farPlane))
+		{
+			continue;
+		}
+
+		int firstSlice = GetDepthSlice(viewDepth - radius);
+		int lastSlice = GetDepthSlice(viewDepth + radius);
+
+		for (int slice = firstSlice; slice <= lastSlice; slice++)
+		{
+			for (int tile = 0; tile < CLUSTER_TILES_X * CLUSTER_TILES_Y; tile++)
+			{
+				int cluster = slice * CLUSTER_TILES_X * CLUSTER_TILES_Y + tile;
+
+				if (SphereTouchesBox(center, radius, m_clusterBounds[cluster].minPoint, m_clusterBounds[cluster].maxPoint) == false)
+				{
+					continue;
+				}
+
+				if (m_clusterPairs.Size() / 2 >= m_maxIndexCount)
+				{
+					bTruncated = true;
+					continue;
+				}
+
+				m_clusterPairs.PushBack((GLuint)cluster);
+				m_clusterPairs.PushBack((GLuint)lightIndex);
+			}
+		}
+	}
+
+	// the same lights overflow on every frame they are in view,
+	// so the warning is only given the first time
+	if ((bTruncated == true) && (m_bReportedTruncation == false))
+	{
+		m_bReportedTruncation = true;
+		std::cout << "Too many clustered lights, some lights were left out" << std::endl;
+	}
+
+	// count the lights of each cluster and lay the lists out back to back
+	std::fill(m_clusterGrid.begin(), m_clusterGrid.end(), 0);
+	for (int i = 0; i < m_clusterPairs.Size(); i += 2)
+	{
+		m_clusterGrid[m_clusterPairs[i] * 2 + 1]++;
+	}
+
+	GLuint offset = 0;
+	for (int cluster = 0; cluster < g_TotalClusters; cluster++)
+	{
+		m_clusterGrid[cluster * 2] = offset;
+		offset += m_clusterGrid[cluster * 2 + 1];
+		// counted again while filling in the index list
+		m_clusterGrid[cluster * 2 + 1] = 0;
+	}
+
+	m_lightIndices.Reset(pArena, (int)offset);
+	m_lightIndices.Resize((int)offset);
+	for (int i = 0; i < m_clusterPairs.Size(); i += 2)
+	{
+		GLuint cluster = m_clusterPairs[i];
+
+		m_lightIndices[m_clusterGrid[cluster * 2] + m_clusterGrid[cluster * 2 + 1]] = m_clusterPairs[i + 1];
+		m_clusterGrid[cluster * 2 + 1]++;
+	}
+}
+
+/***********************************************************
+ *  UploadClusters()
+ *
+ *  This method is used for copying the cluster grid and the
+ *  light index list into their texture buffers.  With the
+ *  cluster stream the lists are written into it instead,
+ *  so the buffers read by the draws of the previous frames
+ *  are not touched.
+ ***********************************************************/
+void LightClusters::UploadClusters()
+{
+	if (NULL != m_clusterStream)
+	{
+		StreamClusters();
+		return;
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_gridBuffer);
+	glBufferSubData(GL_TEXTURE_BUFFER, 0, m_clusterGrid.size() * sizeof(GLuint), m_clusterGrid.data());
+
+	// keep at least one entry so the texture buffer is never empty
+	int indexCount = std::max(m_lightIndices.Size(), 1);
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_indexBuffer);
+	if (indexCount > m_indexCapacity)
+	{
+		// grow the buffer with some room so it is not reallocated every frame
+		m_indexCapacity = std::min(std::max(indexCount * 2, 1024), std::max(m_maxIndexCount, indexCount));
+		glBufferData(GL_TEXTURE_BUFFER, m_indexCapacity * sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+
+		glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, m_indexBuffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+	if (m_lightIndices.IsEmpty() == false)
+	{
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, m_lightIndices.Size() * sizeof(GLuint), m_lightIndices.Data());
+	}
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  StreamClusters()
+ *
+ *  This method is used for writing the cluster grid and the
+ *  light index list into the cluster stream and pointing
+ *  their texture buffers at the written ranges.
+ ***********************************************************/
+void LightClusters::StreamClusters()
+{
+	// keep at least one entry so the texture buffer is never empty
+	const GLuint emptyIndex = 0;
+	const void* indices = &emptyIndex;
+	size_t indexBytes = sizeof(GLuint);
+	size_t gridBytes = m_clusterGrid.size() * sizeof(GLuint);
+
+	if (m_lightIndices.IsEmpty() == false)
+	{
+		indices = m_lightIndices.Data();
+		indexBytes = m_lightIndices.Size() * sizeof(GLuint);
+	}
+
+	// either write can move the stream to a new buffer, so the
+	// buffer is taken right after each one
+	GLintptr indexOffset = m_clusterStream->Write(indices, indexBytes);
+	GLuint indexBuffer = m_clusterStream->GetBuffer();
+	GLintptr gridOffset = m_clusterStream->Write(m_clusterGrid.data(), gridBytes);
+	GLuint gridBuffer = m_clusterStream->GetBuffer();
+
+	glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+	glTexBufferRange(GL_TEXTURE_BUFFER, GL_R32UI, indexBuffer, indexOffset, (GLsizeiptr)indexBytes);
+	glBindTexture(GL_TEXTURE_BUFFER, m_gridTexture);
+	glTexBufferRange(GL_TEXTURE_BUFFER, GL_RG32UI, gridBuffer, gridOffset, (GLsizeiptr)gridBytes);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  BindClusterTextures()
+ *
+ *  This method is used for binding the cluster texture
+ *  buffers to their texture units.
+ ***********************************************************/
+void LightClusters::BindClusterTextures() const
+{
+	glActiveTexture(GL_TEXTURE0 + CLUSTER_GRID_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, m_gridTexture);
+	glActiveTexture(GL_TEXTURE0 + CLUSTER_INDEX_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, m_indexTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the region of the
+ *  cluster stream that the draws of this frame read.
+ ***********************************************************/
+void LightClusters::EndFrame()
+{
+	if (NULL != m_clusterStream)
+	{
+		m_clusterStream->EndFrame();
+	}
+}
+
+/***********************************************************
+ *  GetClusterLightCount()
+ *
+ *  This method is used for getting the number of light
+ *  references over all of the clusters of the last build.
+ ***********************************************************/
+int LightClusters::GetClusterLightCount() const
+{
+	return(m_lightIndices.Size());
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightclusters.h
+// ============
+// bin the scene point lights into the clusters of the camera view
+//
+//	The view is split into CLUSTER_TILES_X x CLUSTER_TILES_Y screen tiles
+//	and CLUSTER_SLICES depth slices that get exponentially thicker with
+//	distance.  Every frame the lights are tested against the clusters on
+//	the CPU, and the fragment shader only walks the lights of the cluster
+//	it falls in.  The results are read through texture buffers since the
+//	shaders target GL 3.3, which has no compute shaders or SSBOs.  The
+//	light lists are rebuilt from scratch every frame, in the frame arena,
+//	and written into a StreamBuffer where texture buffer ranges exist.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderUniforms.h"
+#include "FrameArena.h"
+#include "StreamBuffer.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// these must match the defines in fragmentShader.glsl
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 8
+#define CLUSTER_SLICES 24
+
+// texture units of the cluster buffers, above the scene textures
+#define CLUSTER_GRID_TEXTURE_UNIT 14
+#define CLUSTER_INDEX_TEXTURE_UNIT 15
+
+/***********************************************************
+ *  LightClusters
+ *
+ *  This class contains the code for assigning point lights
+ *  to view clusters and uploading the per-cluster light
+ *  lists into texture buffers.
+ ***********************************************************/
+class LightClusters
+{
+public:
+	// constructor
+	LightClusters();
+	// destructor
+	~LightClusters();
+
+	// assign the point lights to the clusters of the camera view,
+	// the light lists are allocated in the current frame of the arena
+	void BuildClusters(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane,
+		const std::vector<ShaderUniforms::POINT_LIGHT>& lights,
+		FrameArena* pArena);
+
+	// copy the cluster light lists into the texture buffers
+	void UploadClusters();
+	// bind the texture buffers to their texture units
+	void BindClusterTextures() const;
+	// fence the stream region read by this frame's draws, called
+	// once the draws of the frame are submitted
+	void EndFrame();
+
+	// number of light references over all of the clusters
+	int GetClusterLightCount() const;
+
+private:
+	// view space bounding box of a cluster
+	struct CLUSTER_BOUNDS
+	{
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+	};
+
+	// cluster bounding boxes for the projection they were built with
+	std::vector<CLUSTER_BOUNDS> m_clusterBounds;
+	glm::mat4 m_boundsProjection;
+	float m_boundsNear;
+	float m_boundsFar;
+
+	// offset and count into the light index list for each cluster
+	std::vector<GLuint> m_clusterGrid;
+	// light indices of all the clusters, one run per cluster
+	FrameArray<GLuint> m_lightIndices;
+	// cluster and light index pairs found by the light tests
+	FrameArray<GLuint> m_clusterPairs;
+
+	// texture buffer of the cluster grid
+	GLuint m_gridBuffer;
+	GLuint m_gridTexture;
+	// texture buffer of the light index list
+	GLuint m_indexBuffer;
+	GLuint m_indexTexture;
+	// number of indices the light index buffer can currently hold
+	int m_indexCapacity;
+	// largest texture buffer supported by the driver
+	int m_maxIndexCount;
+	// set once the light index list has been reported as full
+	bool m_bReportedTruncation;
+	// stream buffer of both lists, NULL without texture buffer ranges
+	StreamBuffer* m_clusterStream;
+
+	// calculate the view space bounding boxes of the clusters
+	void BuildClusterBounds(
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane);
+	// get the depth slice that a view space depth falls in
+	int GetDepthSlice(float viewDepth) const;
+	// write both lists into the stream and point the textures at them
+	void StreamClusters();
+};
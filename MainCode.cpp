@@ -1,187 +1,493 @@
-///////////////////////////////////////////////////////////////////////////////
-// maincode.cpp
-// ============
-// gets called when application is launched - initializes GLEW, GLFW
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include <iostream>         // error handling and output
-#include <cstdlib>          // EXIT_FAILURE
-
-#include <GL/glew.h>        // GLEW library
-#include "GLFW/glfw3.h"     // GLFW library
-
-// GLM Math Header inclusions
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "SceneManager.h"
-#include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
-
-// Namespace for declaring global variables
-namespace
-{
-	// Macro for window title
-	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
-
-	// Main GLFW window
-	GLFWwindow* g_Window = nullptr;
-
-	// scene manager object for managing the 3D scene prepare and render
-	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
-	// view manager object for managing the 3D view setup and projection to 2D
-	ViewManager* g_ViewManager = nullptr;
-}
-
-// Function declarations - all functions that are called manually
-// need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
-
-
-/***********************************************************
- *  main(int, char*)
- *
- *  This function gets called after the application has been
- *  launched.
- ***********************************************************/
-int main(int argc, char* argv[])
-{
-	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
-	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
-
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"shaders/vertexShader.glsl",
-		"shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
-	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
-	g_SceneManager->PrepareScene();
-
-	// loop will keep running until the application is closed 
-	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
-	{
-		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
-
-		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
-
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
-
-
-		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
-	}
-
-	// clear the allocated manager objects from memory
-	if (NULL != g_SceneManager)
-	{
-		delete g_SceneManager;
-		g_SceneManager = NULL;
-	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
-
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
-}
-
-/***********************************************************
- *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
- ***********************************************************/
-bool InitializeGLFW()
-{
-	// GLFW: initialize and configure library
-	// --------------------------------------
-	glfwInit();
-
-#ifdef __APPLE__
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#else
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-	// GLFW: end -------------------------------
-
-	return(true);
-}
-
-/***********************************************************
- *	InitializeGLEW()
- *
- *  This function is used to initialize the GLEW library.
- ***********************************************************/
-bool InitializeGLEW()
-{
-	// GLEW: initialize
-	// -----------------------------------------
-	GLenum GLEWInitResult = GLEW_OK;
-
-	// try to initialize the GLEW library
-	GLEWInitResult = glewInit();
-	if (GLEW_OK != GLEWInitResult)
-	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
-		return false;
-	}
-	// GLEW: end -------------------------------
-
-	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
-
-	return(true);
+///////////////////////////////////////////////////////////////////////////////
+// maincode.cpp
+// ============
+// gets called when application is launched - initializes GLEW, GLFW
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>         // error handling and output
+#include <cstdio>           // snprintf
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
+#include <string>
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "ShaderVariants.h"
+#include "GpuTimer.h"
+#include "FrameProfiler.h"
+#include "Benchmark.h"
+#include "SceneFile.h"
+#include "RenderTarget.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// uniform blocks and cached uniform locations of the shader program
+	ShaderUniforms* g_ShaderUniforms = nullptr;
+	// program variants specialized for the features of each draw
+	ShaderVariants* g_ShaderVariants = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+	// measures the GPU time of the scene rendering
+	GpuTimer* g_SceneTimer = nullptr;
+	// offscreen HDR buffers the scene is drawn into, NULL when the
+	// post processing shaders could not be loaded
+	RenderTarget* g_RenderTarget = nullptr;
+
+	// number of frames averaged for each printed GPU time with --profile
+	const int g_TimerReportFrames = 300;
+
+	// frame profiler, only created with the --profile argument
+	FrameProfiler* g_FrameProfiler = nullptr;
+	// number of frames between window title updates of the profiler
+	const int g_ProfilerTitleFrames = 30;
+	// files the profiled frames are written to on exit
+	const char* const g_ProfileCsvFile = "profile.csv";
+	const char* const g_ProfileTraceFile = "profile.json";
+
+	// frames of the camera path timed by --benchmark when no count is given
+	const int g_DefaultBenchmarkFrames = 1000;
+	// file the benchmark results are written to
+	const char* const g_BenchmarkCsvFile = "benchmark.csv";
+
+	// point lights of the --stress scene when no count is given
+	const int g_DefaultStressLights = 256;
+
+	// samples per pixel of --msaa when no count is given
+	const int g_DefaultMsaaSamples = 4;
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the application has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// --benchmark [frames] renders a fixed camera path in a hidden
+	// window and exits, --profile adds the frame profiler and
+	// --stress <objects> [lights] replaces the scene with a grid
+	// of computers.  --scene <file> loads the scene from a scene
+	// file, --save-scene <file> writes the prepared scene to one
+	// and --compile-scene <text> <binary> converts a scene file
+	// without opening a window.  --hot-reload applies edits to the
+	// shader, texture and scene files while the scene is running.
+	// --scale <percent> sets the offscreen render size, --target-ms
+	// <ms> lowers it while the scene takes longer on the GPU and
+	// --msaa [samples] or --fxaa smooth the edges
+	int benchmarkFrames = 0;
+	bool bProfile = false;
+	bool bHotReload = false;
+	RenderTarget::TARGET_OPTIONS targetOptions;
+	targetOptions.resolutionScale = 1.0f;
+	targetOptions.targetMilliseconds = 0.0f;
+	targetOptions.antialiasing = RenderTarget::ANTIALIASING_NONE;
+	targetOptions.msaaSamples = g_DefaultMsaaSamples;
+	targetOptions.exposure = 1.0f;
+	int stressObjects = 0;
+	int stressLights = 0;
+	std::string sceneFilename;
+	std::string saveSceneFilename;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--benchmark") == 0)
+		{
+			benchmarkFrames = g_DefaultBenchmarkFrames;
+			if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+			{
+				benchmarkFrames = atoi(argv[++i]);
+			}
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			bProfile = true;
+		}
+		else if (strcmp(argv[i], "--hot-reload") == 0)
+		{
+			bHotReload = true;
+		}
+		else if ((strcmp(argv[i], "--scale") == 0) && ((i + 1) < argc))
+		{
+			targetOptions.resolutionScale = (float)atof(argv[++i]) / 100.0f;
+		}
+		else if ((strcmp(argv[i], "--target-ms") == 0) && ((i + 1) < argc))
+		{
+			targetOptions.targetMilliseconds = (float)atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--msaa") == 0)
+		{
+			targetOptions.antialiasing = RenderTarget::ANTIALIASING_MSAA;
+			if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+			{
+				targetOptions.msaaSamples = atoi(argv[++i]);
+			}
+		}
+		else if (strcmp(argv[i], "--fxaa") == 0)
+		{
+			targetOptions.antialiasing = RenderTarget::ANTIALIASING_FXAA;
+		}
+		else if ((strcmp(argv[i], "--stress") == 0) && ((i + 1) < argc))
+		{
+			stressObjects = atoi(argv[++i]);
+			stressLights = g_DefaultStressLights;
+			if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+			{
+				stressLights = atoi(argv[++i]);
+			}
+		}
+		else if ((strcmp(argv[i], "--scene") == 0) && ((i + 1) < argc))
+		{
+			sceneFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--save-scene") == 0) && ((i + 1) < argc))
+		{
+			saveSceneFilename = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--compile-scene") == 0) && ((i + 2) < argc))
+		{
+			SceneFile sceneFile;
+			bool bCompiled = (sceneFile.Load(argv[i + 1]) == true) && (sceneFile.SaveBinary(argv[i + 2]) == true);
+
+			if (bCompiled == true)
+			{
+				std::cout << "INFO: compiled scene file " << argv[i + 1] << " into " << argv[i + 2] << std::endl;
+			}
+			glfwTerminate();
+			return(bCompiled ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
+	if (benchmarkFrames > 0)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager);
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// load the shader code from the external GLSL files
+	g_ShaderManager->LoadShaders(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl");
+	g_ShaderManager->use();
+
+	// create the camera, light and material uniform blocks
+	g_ShaderUniforms = new ShaderUniforms(g_ShaderManager);
+	g_ShaderUniforms->CreateUniformBlocks();
+	g_ViewManager->SetShaderUniforms(g_ShaderUniforms);
+
+	// the scene is drawn in HDR at the scaled size and then
+	// tonemapped into the window
+	g_RenderTarget = new RenderTarget();
+	if (g_RenderTarget->LoadShaders(
+		"shaders/postVertexShader.glsl",
+		"shaders/tonemapFragmentShader.glsl",
+		"shaders/fxaaFragmentShader.glsl") == true)
+	{
+		g_RenderTarget->SetOptions(targetOptions);
+	}
+	else
+	{
+		delete g_RenderTarget;
+		g_RenderTarget = NULL;
+	}
+
+	// the variants are built from the same shader files when first used
+	g_ShaderVariants = new ShaderVariants(g_ShaderManager, g_ShaderUniforms);
+	g_ShaderVariants->LoadShaderSources(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl");
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager, g_ShaderUniforms);
+	g_SceneManager->SetShaderVariants(g_ShaderVariants);
+	if (stressObjects > 0)
+	{
+		g_SceneManager->SetStressScene(stressObjects, stressLights);
+	}
+	if (sceneFilename.empty() == false)
+	{
+		g_SceneManager->LoadSceneFile(sceneFilename);
+	}
+	g_SceneManager->PrepareScene();
+	// the instanced shapes stay on the CPU without compute shaders
+	g_SceneManager->EnableGpuCulling("shaders/cullComputeShader.glsl");
+	if (saveSceneFilename.empty() == false)
+	{
+		g_SceneManager->SaveSceneFile(saveSceneFilename);
+	}
+	// the benchmark times fixed files, so they are not watched
+	if ((bHotReload == true) && (benchmarkFrames == 0))
+	{
+		g_SceneManager->EnableHotReload();
+	}
+
+	// the scene GPU time drives the dynamic resolution scale, and
+	// its average is only printed every few seconds when profiling
+	g_SceneTimer = new GpuTimer("scene", (bProfile == true) ? g_TimerReportFrames : 0);
+
+	// the profiler times the parts of every frame, shows them over
+	// the scene and writes them out when the window is closed
+	if (bProfile == true)
+	{
+		g_FrameProfiler = new FrameProfiler();
+		g_SceneManager->SetFrameProfiler(g_FrameProfiler);
+	}
+	int frameCount = 0;
+
+	if (benchmarkFrames > 0)
+	{
+		Benchmark benchmark(g_Window, g_ViewManager, g_SceneManager);
+
+		benchmark.SetRenderTarget(g_RenderTarget);
+		benchmark.AddDefaultConfigurations();
+		benchmark.Run(benchmarkFrames);
+		benchmark.PrintResults();
+		benchmark.WriteCsv(g_BenchmarkCsvFile);
+
+		glfwSetWindowShouldClose(g_Window, true);
+	}
+
+	// loop will keep running until the application is closed 
+	// or until an error has occurred
+	while (!glfwWindowShouldClose(g_Window))
+	{
+		if (NULL != g_FrameProfiler)
+		{
+			g_FrameProfiler->BeginFrame();
+		}
+
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+
+		// the scene is drawn into the offscreen buffers, or into
+		// the window with a viewport that follows its size
+		glfwGetFramebufferSize(g_Window, &framebufferWidth, &framebufferHeight);
+		if (NULL != g_RenderTarget)
+		{
+			g_RenderTarget->BeginFrame(framebufferWidth, framebufferHeight);
+			g_ViewManager->SetRenderSize(g_RenderTarget->GetWidth(), g_RenderTarget->GetHeight());
+		}
+		else
+		{
+			glViewport(0, 0, framebufferWidth, framebufferHeight);
+		}
+
+		// Enable z-depth
+		glEnable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// convert from 3D object space to 2D view
+		{
+			ProfileScope scope(g_FrameProfiler, "PrepareSceneView");
+			g_ViewManager->PrepareSceneView();
+		}
+
+		// refresh the 3D scene
+		{
+			ProfileScope scope(g_FrameProfiler, "RenderScene");
+			g_SceneTimer->Begin();
+			g_SceneManager->RenderScene();
+			g_SceneTimer->End();
+		}
+
+		// resolve and tonemap the scene into the window, and fit the
+		// render size to the scene GPU time of a few frames ago
+		if (NULL != g_RenderTarget)
+		{
+			ProfileScope scope(g_FrameProfiler, "PostProcess");
+			g_RenderTarget->EndFrame();
+			g_RenderTarget->UpdateDynamicScale(g_SceneTimer->GetLatestMilliseconds());
+		}
+
+		if (NULL != g_FrameProfiler)
+		{
+			g_FrameProfiler->DrawOverlay(framebufferWidth, framebufferHeight);
+
+			// the overlay has no text, the numbers go in the title,
+			// which is built in place so the loop does not allocate
+			if ((frameCount % g_ProfilerTitleFrames) == 0)
+			{
+				char summary[256];
+				char title[320];
+
+				g_FrameProfiler->GetSummary(summary, (int)sizeof(summary));
+				snprintf(title, sizeof(title), "%s - %s", WINDOW_TITLE, summary);
+				glfwSetWindowTitle(g_Window, title);
+			}
+		}
+		frameCount++;
+
+		// all of the draws of the frame are submitted, so fence the
+		// stream buffer regions they read
+		g_SceneManager->EndFrame();
+
+		// Flips the the back buffer with the front buffer every frame.
+		{
+			ProfileScope scope(g_FrameProfiler, "SwapBuffers");
+			glfwSwapBuffers(g_Window);
+		}
+
+		if (NULL != g_FrameProfiler)
+		{
+			g_FrameProfiler->EndFrame();
+		}
+
+		// query the latest GLFW events
+		glfwPollEvents();
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_FrameProfiler)
+	{
+		g_FrameProfiler->WriteCsv(g_ProfileCsvFile);
+		g_FrameProfiler->WriteChromeTrace(g_ProfileTraceFile);
+		g_SceneManager->SetFrameProfiler(NULL);
+		delete g_FrameProfiler;
+		g_FrameProfiler = NULL;
+	}
+	if (NULL != g_SceneTimer)
+	{
+		delete g_SceneTimer;
+		g_SceneTimer = NULL;
+	}
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_RenderTarget)
+	{
+		delete g_RenderTarget;
+		g_RenderTarget = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderVariants)
+	{
+		delete g_ShaderVariants;
+		g_ShaderVariants = NULL;
+	}
+	if (NULL != g_ShaderUniforms)
+	{
+		delete g_ShaderUniforms;
+		g_ShaderUniforms = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS); 
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ * 
+ *  This function is used to initialize the GLFW library.   
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	// Displays a successful OpenGL initialization message
+	std::cout << "INFO: OpenGL Successfully Initialized\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionqueries.cpp
+// ============
+// find out which scene objects were hidden behind other geometry
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionQueries.h"
+
+/***********************************************************
+ *  OcclusionQueries()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OcclusionQueries::OcclusionQueries()
+{
+}
+
+/***********************************************************
+ *  ~OcclusionQueries()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OcclusionQueries::~OcclusionQueries()
+{
+	DeleteQueries();
+}
+
+/***********************************************************
+ *  DeleteQueries()
+ *
+ *  This method is used for freeing the queries of every
+ *  object.
+ ***********************************************************/
+void OcclusionQueries::DeleteQueries()
+{
+	for (QUERY_OBJECT& object : m_objects)
+	{
+		glDeleteQueries(1, &object.query);
+	}
+	m_objects.clear();
+}
+
+/***********************************************************
+ *  SetObjectCount()
+ *
+ *  This method is used for creating one query per object.
+ *  Every object is visible until a query shows otherwise.
+ ***********************************************************/
+void OcclusionQueries::SetObjectCount(int count)
+{
+	DeleteQueries();
+
+	m_objects.resize(count);
+	for (QUERY_OBJECT& object : m_objects)
+	{
+		glGenQueries(1, &object.query);
+		object.bPending = false;
+		object.bOccluded = false;
+	}
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of objects.
+ ***********************************************************/
+int OcclusionQueries::GetObjectCount() const
+{
+	return((int)m_objects.size());
+}
+
+/***********************************************************
+ *  ReadResults()
+ *
+ *  This method is used for collecting the results of the
+ *  queries that the GPU has finished, without waiting for
+ *  the others.
+ ***********************************************************/
+void OcclusionQueries::ReadResults()
+{
+	for (QUERY_OBJECT& object : m_objects)
+	{
+		GLint bAvailable = 0;
+		GLint bSamplesPassed = 0;
+
+		if (object.bPending == false)
+		{
+			continue;
+		}
+
+		glGetQueryObjectiv(object.query, GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+		if (bAvailable == 0)
+		{
+			continue;
+		}
+
+		glGetQueryObjectiv(object.query, GL_QUERY_RESULT, &bSamplesPassed);
+		object.bOccluded = (bSamplesPassed == 0);
+		object.bPending = false;
+	}
+}
+
+/***********************************************************
+ *  CanQuery()
+ *
+ *  This method is used for checking whether an object has
+ *  no query in flight, so a new one can be started.
+ ***********************************************************/
+bool OcclusionQueries::CanQuery(int object) const
+{
+	if ((object < 0) || (object >= (int)m_objects.size()))
+	{
+		return(false);
+	}
+
+	return(m_objects[object].bPending == false);
+}
+
+/***********************************************************
+ *  BeginQuery()
+ *
+ *  This method is used for starting to count the samples of
+ *  the proxy box of an object.
+ ***********************************************************/
+void OcclusionQueries::BeginQuery(int object)
+{
+	if (CanQuery(object) == false)
+	{
+		return;
+	}
+
+	glBeginQuery(GL_ANY_SAMPLES_PASSED, m_objects[object].query);
+	m_objects[object].bPending = true;
+}
+
+/***********************************************************
+ *  EndQuery()
+ *
+ *  This method is used for ending the running query.
+ ***********************************************************/
+void OcclusionQueries::EndQuery()
+{
+	glEndQuery(GL_ANY_SAMPLES_PASSED);
+}
+
+/***********************************************************
+ *  SetVisible()
+ *
+ *  This method is used for marking an object as visible
+ *  without a query.
+ ***********************************************************/
+void OcclusionQueries::SetVisible(int object)
+{
+	if ((object < 0) || (object >= (int)m_objects.size()))
+	{
+		return;
+	}
+
+	m_objects[object].bOccluded = false;
+}
+
+/***********************************************************
+ *  IsOccluded()
+ *
+ *  This method is used for checking whether the last result
+ *  of an object showed that none of its proxy box was seen.
+ ***********************************************************/
+bool OcclusionQueries::IsOccluded(int object) const
+{
+	if ((object < 0) || (object >= (int)m_objects.size()))
+	{
+		return(false);
+	}
+
+	return(m_objects[object].bOccluded);
+}
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionqueries.h
+// ============
+// find out which scene objects were hidden behind other geometry
+//
+//	Each object has one GL_ANY_SAMPLES_PASSED query for the proxy box that
+//	is drawn around it against the depth of the occluders.  The results
+//	are only read once the GPU has made them available, so they describe
+//	a frame or two ago and never stall the pipeline.  An object keeps its
+//	last known state until a newer result comes in.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+/***********************************************************
+ *  OcclusionQueries
+ *
+ *  This class contains the occlusion queries of the scene
+ *  objects and their last known results.
+ ***********************************************************/
+class OcclusionQueries
+{
+public:
+	// constructor
+	OcclusionQueries();
+	// destructor
+	~OcclusionQueries();
+
+	// set the number of objects, every object starts visible
+	void SetObjectCount(int count);
+	int GetObjectCount() const;
+
+	// collect the results of the queries that have finished
+	void ReadResults();
+
+	// check if an object has no query waiting for a result
+	bool CanQuery(int object) const;
+	// count the samples of the proxy drawn between these calls
+	void BeginQuery(int object);
+	void EndQuery();
+
+	// mark an object as visible without a query, used when the
+	// camera is inside its proxy box
+	void SetVisible(int object);
+	// true when the last result showed no samples
+	bool IsOccluded(int object) const;
+
+private:
+	struct QUERY_OBJECT
+	{
+		GLuint query;
+		// true while the result has not been read
+		bool bPending;
+		bool bOccluded;
+	};
+
+	std::vector<QUERY_OBJECT> m_objects;
+
+	// free the queries of every object
+	void DeleteQueries();
+};
@@ -0,0 +1,248 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.cpp
+// ============
+// collect the draw items of a frame and sort them by render state
+//
+//	Sort key layout, from the most significant bit:
+//	  63     - transparent layer, drawn after every opaque item
+//	  59..62 - coarse view depth bucket, so the near buckets fill the
+//	           depth buffer before the far ones are shaded
+//	  51..58 - shader program
+//	  35..50 - texture handle + 1, 0 for a solid color
+//	  19..34 - material handle + 1, 0 for no material
+//	  11..18 - mesh
+//	   0..10 - view depth, so equal state is drawn front to back
+//	The state is only sorted within a depth bucket, so each bucket
+//	costs at most one more change of every state.
+//	Transparent items store the inverted view depth in bits 31..54 and
+//	their submission order in the low bits, so they are drawn back to
+//	front and items at the same depth keep their order.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declaration of the global variables and defines
+namespace
+{
+	const int g_TransparentShift = 63;
+	const int g_DepthBucketShift = 59;
+	const int g_ShaderShift = 51;
+	const int g_TextureShift = 35;
+	const int g_MaterialShift = 19;
+	const int g_MeshShift = 11;
+	const int g_FarDepthShift = 31;
+
+	const uint64_t g_ShaderMask = 0xFF;
+	const uint64_t g_HandleMask = 0xFFFF;
+	const uint64_t g_MeshMask = 0xFF;
+	const uint64_t g_SequenceMask = 0x7FFFFFFF;
+	const uint64_t g_DepthBucketMask = 0xF;
+	const uint64_t g_OpaqueDepthMask = 0x7FF;
+	const uint64_t g_FarDepthMask = 0xFFFFFF;
+
+	// the keys are sorted one byte at a time, lowest byte first
+	const int g_RadixPasses = 8;
+	const int g_RadixValues = 256;
+
+	// scale a depth between 0 and 1 to the largest value of a mask
+	uint64_t QuantizeDepth(float depth, uint64_t mask)
+	{
+		depth = std::min(std::max(depth, 0.0f), 1.0f);
+
+		return((uint64_t)(depth * (float)mask) & mask);
+	}
+
+	// coarse depth bucket of an opaque draw, the square root spaces
+	// the buckets closer together near the camera, where the scene
+	// is and where a surface hides the most of what is behind it
+	uint64_t GetDepthBucket(float depth)
+	{
+		depth = std::min(std::max(depth, 0.0f), 1.0f);
+
+		return(std::min((uint64_t)(std::sqrt(depth) * (float)(g_DepthBucketMask + 1)), g_DepthBucketMask));
+	}
+}
+
+/***********************************************************
+ *  RenderQueue()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderQueue::RenderQueue()
+{
+	m_pArena = NULL;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing all of the draw items.
+ *  The items of the new frame are allocated in its arena,
+ *  with room for the passed in number of items, and grow
+ *  in the arena past that.
+ ***********************************************************/
+void RenderQueue::Clear(FrameArena* pArena, int capacity)
+{
+	m_pArena = pArena;
+	m_items.Reset(pArena, capacity);
+}
+
+/***********************************************************
+ *  Submit()
+ *
+ *  This method is used for adding a draw item to the queue.
+ ***********************************************************/
+void RenderQueue::Submit(const DRAW_ITEM& item)
+{
+	m_items.PushBack(item);
+}
+
+/***********************************************************
+ *  Submit()
+ *
+ *  This method is used for adding a list of draw items to
+ *  the queue with one copy.
+ ***********************************************************/
+void RenderQueue::Submit(const FrameArray<DRAW_ITEM>& items)
+{
+	m_items.Append(items.Data(), items.Size());
+}
+
+/***********************************************************
+ *  Sort()
+ *
+ *  This method is used for sorting the draw items by their
+ *  keys.  Each byte of the keys is a pass that spreads the
+ *  items into 256 runs in their current order, so the sort
+ *  is stable and equal keys are drawn in the order they
+ *  were submitted.  The counts of all of the bytes are taken
+ *  in one pass first, and a byte that every key shares,
+ *  such as the unused shader bits, is skipped.
+ ***********************************************************/
+void RenderQueue::Sort()
+{
+	int count = m_items.Size();
+	int counts[g_RadixPasses][g_RadixValues] = {};
+
+	if (count < 2)
+	{
+		return;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		uint64_t key = m_items[i].sortKey;
+
+		for (int pass = 0; pass < g_RadixPasses; pass++)
+		{
+			counts[pass][(key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	DRAW_ITEM* source = m_items.Data();
+	DRAW_ITEM* target = m_pArena->AllocateArray<DRAW_ITEM>(count);
+
+	for (int pass = 0; pass < g_RadixPasses; pass++)
+	{
+		int* passCounts = counts[pass];
+		int shift = pass * 8;
+
+		if (passCounts[(source[0].sortKey >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+
+		// the counts become the first index of each run
+		int offset = 0;
+		for (int value = 0; value < g_RadixValues; value++)
+		{
+			int valueCount = passCounts[value];
+
+			passCounts[value] = offset;
+			offset += valueCount;
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			target[passCounts[(source[i].sortKey >> shift) & 0xFF]++] = source[i];
+		}
+		std::swap(source, target);
+	}
+
+	if (source != m_items.Data())
+	{
+		std::copy(source, source + count, m_items.Data());
+	}
+}
+
+/***********************************************************
+ *  GetItems()
+ *
+ *  This method is used for getting the queued draw items.
+ ***********************************************************/
+const FrameArray<RenderQueue::DRAW_ITEM>& RenderQueue::GetItems() const
+{
+	return(m_items);
+}
+
+/***********************************************************
+ *  MakeOpaqueKey()
+ *
+ *  This method is used for packing the render state of an
+ *  opaque draw into a sort key.  Handles of -1 (no texture
+ *  or no material) sort before every valid handle.  The
+ *  coarse depth bucket comes first, so near draws are made
+ *  before far ones and hide their fragments, and the state
+ *  is grouped within each bucket.  The fine depth orders
+ *  the draws that share all of the state.
+ ***********************************************************/
+uint64_t RenderQueue::MakeOpaqueKey(
+	int shaderHandle,
+	int textureHandle,
+	int materialHandle,
+	int meshHandle,
+	float depth)
+{
+	uint64_t key = 0;
+
+	key |= GetDepthBucket(depth) << g_DepthBucketShift;
+	key |= ((uint64_t)shaderHandle & g_ShaderMask) << g_ShaderShift;
+	key |= ((uint64_t)(textureHandle + 1) & g_HandleMask) << g_TextureShift;
+	key |= ((uint64_t)(materialHandle + 1) & g_HandleMask) << g_MaterialShift;
+	key |= ((uint64_t)meshHandle & g_MeshMask) << g_MeshShift;
+	key |= QuantizeDepth(depth, g_OpaqueDepthMask);
+
+	return(key);
+}
+
+/***********************************************************
+ *  MakeTransparentKey()
+ *
+ *  This method is used for building the sort key of a
+ *  transparent draw.  Transparent draws are drawn after all
+ *  opaque draws, from the farthest to the nearest, so each
+ *  one blends over everything behind it.
+ ***********************************************************/
+uint64_t RenderQueue::MakeTransparentKey(float depth, int sequence)
+{
+	uint64_t key = (uint64_t)1 << g_TransparentShift;
+
+	key |= (g_FarDepthMask - QuantizeDepth(depth, g_FarDepthMask)) << g_FarDepthShift;
+	key |= (uint64_t)sequence & g_SequenceMask;
+
+	return(key);
+}
+
+/***********************************************************
+ *  IsTransparentKey()
+ *
+ *  This method is used for checking if a sort key belongs
+ *  to a draw of the transparent layer.
+ ***********************************************************/
+bool RenderQueue::IsTransparentKey(uint64_t sortKey)
+{
+	return(((sortKey >> g_TransparentShift) & 1) != 0);
+}
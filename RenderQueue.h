@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderqueue.h
+// ============
+// collect the draw items of a frame and sort them by render state
+//
+//	Items are sorted by a packed 64-bit key.  Opaque draws are split into
+//	a few coarse depth buckets, nearest first, so near surfaces hide the
+//	fragments behind them.  Within a bucket, draws sharing a shader,
+//	texture, material and mesh end up next to each other, which lets the
+//	submitting code skip the state changes between them.  Draws with the
+//	same state go front to back, and transparent draws come last and go
+//	back to front.  The items live in the frame arena and are
+//	sorted with a radix sort over the bytes of the keys, which keeps the
+//	submission order of equal keys and needs no memory but a second run
+//	of items from the arena.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameArena.h"
+
+#include <cstdint>
+
+/***********************************************************
+ *  RenderQueue
+ *
+ *  This class contains the list of draw items for a frame
+ *  and the code for building their sort keys and sorting.
+ ***********************************************************/
+class RenderQueue
+{
+public:
+	struct DRAW_ITEM
+	{
+		// packed render state used for sorting
+		uint64_t sortKey;
+		// program variant that the item is drawn with
+		int shaderHandle;
+		// scene node that supplies the mesh and surface state
+		int nodeIndex;
+		// static batch drawn instead of the node mesh, -1 for none
+		int staticBatch;
+		// run of the instance buffer for instanced draws
+		int firstInstance;
+		// number of instances, 0 for a draw with the model uniform
+		int instanceCount;
+		// tessellation of the instanced mesh, 0 for the full one
+		int lodLevel;
+		// bucket whose commands the GPU culler wrote, -1 for none
+		int gpuBucket;
+	};
+
+	// constructor
+	RenderQueue();
+
+	// remove all of the draw items from the queue and start the
+	// items of a new frame in the arena, with room for a number
+	// of items
+	void Clear(FrameArena* pArena, int capacity);
+	// add a draw item to the queue
+	void Submit(const DRAW_ITEM& item);
+	// add the draw items that a job has built, in their order
+	void Submit(const FrameArray<DRAW_ITEM>& items);
+	// sort the draw items by their keys
+	void Sort();
+	// get the sorted draw items
+	const FrameArray<DRAW_ITEM>& GetItems() const;
+
+	// pack the render state and view depth of an opaque draw into a
+	// sort key, the depth is 0 at the camera and 1 at the far plane
+	static uint64_t MakeOpaqueKey(
+		int shaderHandle,
+		int textureHandle,
+		int materialHandle,
+		int meshHandle,
+		float depth);
+	// transparent draws sort last, the farthest one first
+	static uint64_t MakeTransparentKey(float depth, int sequence);
+	// check if a sort key belongs to a transparent draw
+	static bool IsTransparentKey(uint64_t sortKey);
+
+private:
+	// arena of the current frame, which the sort buffer comes from
+	FrameArena* m_pArena;
+	// draw items of the current frame
+	FrameArray<DRAW_ITEM> m_items;
+};
@@ -0,0 +1,536 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendertarget.cpp
+// ============
+// render the scene offscreen in HDR at a scaled resolution
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderTarget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// range of the resolution scale
+	const float g_MinResolutionScale = 0.5f;
+	const float g_MaxResolutionScale = 2.0f;
+	// steps of the dynamic scale, so the buffers are not
+	// reallocated for every small change in the frame time
+	const float g_ScaleStep = 0.05f;
+	// frames between two changes of the dynamic scale, longer
+	// than the latency of the GPU timer
+	const int g_ScaleChangeFrames = 30;
+	// the scale is only raised when the scene time is below
+	// this part of the target, so it does not swing back and forth
+	const double g_ScaleUpHeadroom = 0.85;
+	// weight of the newest scene time in the smoothed time
+	const double g_TimeSmoothing = 0.1;
+
+	// names of the post processing uniforms
+	const char* g_HdrColorName = "hdrColor";
+	const char* g_LdrColorName = "ldrColor";
+	const char* g_ExposureName = "exposure";
+	const char* g_OutputLumaName = "bOutputLuma";
+	const char* g_TexelSizeName = "texelSize";
+
+	/***********************************************************
+	 *  IsProgramLinked()
+	 *
+	 *  Returns true if a program loaded by a shader manager was
+	 *  linked without errors.
+	 ***********************************************************/
+	bool IsProgramLinked(GLuint programID)
+	{
+		GLint status = GL_FALSE;
+
+		if (programID == 0)
+		{
+			return(false);
+		}
+		glGetProgramiv(programID, GL_LINK_STATUS, &status);
+
+		return(status == GL_TRUE);
+	}
+}
+
+/***********************************************************
+ *  RenderTarget()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderTarget::RenderTarget()
+{
+	m_options.resolutionScale = 1.0f;
+	m_options.targetMilliseconds = 0.0f;
+	m_options.antialiasing = ANTIALIASING_NONE;
+	m_options.msaaSamples = 4;
+	m_options.exposure = 1.0f;
+
+	m_tonemapShader = NULL;
+	m_fxaaShader = NULL;
+	m_vertexArray = 0;
+	m_sceneFramebuffer = 0;
+	m_sceneColorTexture = 0;
+	m_sceneDepthBuffer = 0;
+	m_msaaFramebuffer = 0;
+	m_msaaColorBuffer = 0;
+	m_msaaDepthBuffer = 0;
+	m_ldrFramebuffer = 0;
+	m_ldrColorTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_bufferAntialiasing = ANTIALIASING_NONE;
+	m_bufferSamples = 0;
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_bComplete = false;
+	m_dynamicScale = 1.0f;
+	m_smoothedMilliseconds = 0.0;
+	m_framesSinceScaleChange = 0;
+}
+
+/***********************************************************
+ *  ~RenderTarget()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RenderTarget::~RenderTarget()
+{
+	DestroyBuffers();
+	if (m_vertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArray);
+		m_vertexArray = 0;
+	}
+	delete m_tonemapShader;
+	m_tonemapShader = NULL;
+	delete m_fxaaShader;
+	m_fxaaShader = NULL;
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the programs of the
+ *  tonemapping and FXAA passes, which share the vertex
+ *  shader of the full screen triangle.  Without them the
+ *  scene is drawn straight into the window.
+ ***********************************************************/
+bool RenderTarget::LoadShaders(const char* vertexShaderPath, const char* tonemapShaderPath, const char* fxaaShaderPath)
+{
+	GLint currentProgram = 0;
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+
+	m_tonemapShader = new ShaderManager();
+	m_tonemapShader->LoadShaders(vertexShaderPath, tonemapShaderPath);
+	m_fxaaShader = new ShaderManager();
+	m_fxaaShader->LoadShaders(vertexShaderPath, fxaaShaderPath);
+
+	if ((IsProgramLinked(m_tonemapShader->m_programID) == false) || (IsProgramLinked(m_fxaaShader->m_programID) == false))
+	{
+		std::cout << "Could not load the post processing shaders, the scene is drawn straight into the window" << std::endl;
+		delete m_tonemapShader;
+		m_tonemapShader = NULL;
+		delete m_fxaaShader;
+		m_fxaaShader = NULL;
+		glUseProgram(currentProgram);
+		return(false);
+	}
+
+	// both passes read their input from texture unit 0
+	m_tonemapShader->use();
+	m_tonemapShader->setIntValue(g_HdrColorName, 0);
+	m_fxaaShader->use();
+	m_fxaaShader->setIntValue(g_LdrColorName, 0);
+	glUseProgram(currentProgram);
+
+	// the full screen triangle is made from the vertex index,
+	// but core profiles still need a vertex array to draw
+	glGenVertexArrays(1, &m_vertexArray);
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetOptions()
+ *
+ *  This method is used for getting the resolution scale,
+ *  antialiasing and tonemapping options.
+ ***********************************************************/
+RenderTarget::TARGET_OPTIONS RenderTarget::GetOptions() const
+{
+	return(m_options);
+}
+
+/***********************************************************
+ *  SetOptions()
+ *
+ *  This method is used for changing the options.  The scale
+ *  is limited to its range and the MSAA samples to what the
+ *  driver supports, and dynamic scaling starts again from
+ *  the new scale.
+ ***********************************************************/
+void RenderTarget::SetOptions(const TARGET_OPTIONS& options)
+{
+	GLint maxSamples = 0;
+
+	m_options = options;
+	m_options.resolutionScale = std::min(std::max(options.resolutionScale, g_MinResolutionScale), g_MaxResolutionScale);
+	m_options.targetMilliseconds = std::max(options.targetMilliseconds, 0.0f);
+
+	glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+	m_options.msaaSamples = std::min(std::max(options.msaaSamples, 2), (int)maxSamples);
+	if ((m_options.antialiasing == ANTIALIASING_MSAA) && (m_options.msaaSamples < 2))
+	{
+		std::cout << "Multisampled render targets are not supported, drawing without MSAA" << std::endl;
+		m_options.antialiasing = ANTIALIASING_NONE;
+	}
+
+	m_dynamicScale = m_options.resolutionScale;
+	m_smoothedMilliseconds = 0.0;
+	m_framesSinceScaleChange = 0;
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for binding the buffers that the
+ *  scene is drawn into and setting the viewport to their
+ *  size.  The buffers are created again when the window
+ *  size, the scale or the antialiasing has changed.
+ ***********************************************************/
+void RenderTarget::BeginFrame(int windowWidth, int windowHeight)
+{
+	m_windowWidth = std::max(windowWidth, 1);
+	m_windowHeight = std::max(windowHeight, 1);
+
+	if (NULL == m_tonemapShader)
+	{
+		m_bComplete = false;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		return;
+	}
+
+	int width = std::max((int)((float)m_windowWidth * m_dynamicScale + 0.5f), 1);
+	int height = std::max((int)((float)m_windowHeight * m_dynamicScale + 0.5f), 1);
+	int samples = (m_options.antialiasing == ANTIALIASING_MSAA) ? m_options.msaaSamples : 0;
+
+	if ((width != m_width) || (height != m_height) ||
+		(m_options.antialiasing != m_bufferAntialiasing) || (samples != m_bufferSamples))
+	{
+		CreateBuffers(width, height);
+	}
+
+	if (m_bComplete == false)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		return;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, (m_bufferAntialiasing == ANTIALIASING_MSAA) ? m_msaaFramebuffer : m_sceneFramebuffer);
+	glViewport(0, 0, m_width, m_height);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for turning the HDR scene colors into
+ *  the window image.  The multisampled colors are resolved
+ *  first, then the tonemapping pass scales them to the
+ *  window, or writes them at the render size for the FXAA
+ *  pass to smooth and scale.  The program, blending and
+ *  vertex array that the scene uses are restored after.
+ ***********************************************************/
+void RenderTarget::EndFrame()
+{
+	if (m_bComplete == false)
+	{
+		return;
+	}
+
+	GLint currentProgram = 0;
+	bool bFxaa = (m_bufferAntialiasing == ANTIALIASING_FXAA);
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+
+	if (m_bufferAntialiasing == ANTIALIASING_MSAA)
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_msaaFramebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_sceneFramebuffer);
+		glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	}
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glActiveTexture(GL_TEXTURE0);
+	glBindVertexArray(m_vertexArray);
+
+	// tonemap into the window, or into the FXAA input at the render size
+	if (bFxaa == true)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_ldrFramebuffer);
+		glViewport(0, 0, m_width, m_height);
+	}
+	else
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+	}
+	glBindTexture(GL_TEXTURE_2D, m_sceneColorTexture);
+	m_tonemapShader->use();
+	m_tonemapShader->setFloatValue(g_ExposureName, m_options.exposure);
+	m_tonemapShader->setBoolValue(g_OutputLumaName, bFxaa);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+
+	if (bFxaa == true)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		glBindTexture(GL_TEXTURE_2D, m_ldrColorTexture);
+		m_fxaaShader->use();
+		m_fxaaShader->setVec2Value(g_TexelSizeName, glm::vec2(1.0f / (float)m_width, 1.0f / (float)m_height));
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindVertexArray(0);
+	glEnable(GL_BLEND);
+	glUseProgram(currentProgram);
+}
+
+/***********************************************************
+ *  UpdateDynamicScale()
+ *
+ *  This method is used for moving the resolution scale
+ *  towards the frame time target.  The fragment work grows
+ *  with the pixel count, the square of the scale, so the
+ *  scale is changed by the square root of the time ratio.
+ *  It is lowered as soon as the smoothed time is over the
+ *  target and raised one step at a time when there is room.
+ ***********************************************************/
+void RenderTarget::UpdateDynamicScale(double sceneMilliseconds)
+{
+	if ((m_options.targetMilliseconds <= 0.0f) || (sceneMilliseconds <= 0.0))
+	{
+		return;
+	}
+
+	if (m_smoothedMilliseconds <= 0.0)
+	{
+		m_smoothedMilliseconds = sceneMilliseconds;
+	}
+	else
+	{
+		m_smoothedMilliseconds += (sceneMilliseconds - m_smoothedMilliseconds) * g_TimeSmoothing;
+	}
+
+	m_framesSinceScaleChange++;
+	if (m_framesSinceScaleChange < g_ScaleChangeFrames)
+	{
+		return;
+	}
+
+	double target = (double)m_options.targetMilliseconds;
+	float scale = m_dynamicScale * (float)std::sqrt(target / m_smoothedMilliseconds);
+
+	if (m_smoothedMilliseconds > target)
+	{
+		scale = std::floor(scale / g_ScaleStep) * g_ScaleStep;
+	}
+	else if (m_smoothedMilliseconds < (target * g_ScaleUpHeadroom))
+	{
+		scale = std::min(scale, m_dynamicScale + g_ScaleStep);
+		scale = std::floor((scale / g_ScaleStep) + 0.01f) * g_ScaleStep;
+	}
+	else
+	{
+		return;
+	}
+	scale = std::min(std::max(scale, g_MinResolutionScale), m_options.resolutionScale);
+
+	if (std::fabs(scale - m_dynamicScale) < (g_ScaleStep * 0.5f))
+	{
+		return;
+	}
+
+	m_dynamicScale = scale;
+	m_smoothedMilliseconds = 0.0;
+	m_framesSinceScaleChange = 0;
+
+	std::cout << "INFO: render scale " << (int)(scale * 100.0f + 0.5f) << "%" << std::endl;
+}
+
+/***********************************************************
+ *  GetWidth()
+ *
+ *  This method is used for getting the width that the scene
+ *  is drawn at this frame.
+ ***********************************************************/
+int RenderTarget::GetWidth() const
+{
+	return((m_bComplete == true) ? m_width : m_windowWidth);
+}
+
+/***********************************************************
+ *  GetHeight()
+ *
+ *  This method is used for getting the height that the
+ *  scene is drawn at this frame.
+ ***********************************************************/
+int RenderTarget::GetHeight() const
+{
+	return((m_bComplete == true) ? m_height : m_windowHeight);
+}
+
+/***********************************************************
+ *  GetResolutionScale()
+ *
+ *  This method is used for getting the scale of the render
+ *  size to the window size.
+ ***********************************************************/
+float RenderTarget::GetResolutionScale() const
+{
+	return(m_dynamicScale);
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the HDR color texture
+ *  and the depth buffer, the multisampled buffers for MSAA
+ *  and the tonemapped color texture for FXAA.  The textures
+ *  are filtered linearly, since the last pass scales them
+ *  to the window.
+ ***********************************************************/
+void RenderTarget::CreateBuffers(int width, int height)
+{
+	DestroyBuffers();
+
+	m_width = width;
+	m_height = height;
+	m_bufferAntialiasing = m_options.antialiasing;
+	m_bufferSamples = (m_bufferAntialiasing == ANTIALIASING_MSAA) ? m_options.msaaSamples : 0;
+
+	glGenTextures(1, &m_sceneColorTexture);
+	glBindTexture(GL_TEXTURE_2D, m_sceneColorTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glGenFramebuffers(1, &m_sceneFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_sceneColorTexture, 0);
+
+	// with MSAA the depth is only needed by the multisampled buffers
+	if (m_bufferSamples == 0)
+	{
+		glGenRenderbuffers(1, &m_sceneDepthBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_sceneDepthBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_sceneDepthBuffer);
+	}
+	m_bComplete = CheckFramebuffer(m_sceneFramebuffer, "HDR");
+
+	if (m_bufferSamples > 0)
+	{
+		glGenRenderbuffers(1, &m_msaaColorBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_msaaColorBuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_bufferSamples, GL_RGBA16F, width, height);
+		glGenRenderbuffers(1, &m_msaaDepthBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_msaaDepthBuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_bufferSamples, GL_DEPTH_COMPONENT24, width, height);
+
+		glGenFramebuffers(1, &m_msaaFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_msaaFramebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_msaaColorBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_msaaDepthBuffer);
+		m_bComplete = (CheckFramebuffer(m_msaaFramebuffer, "MSAA") == true) && (m_bComplete == true);
+	}
+
+	if (m_bufferAntialiasing == ANTIALIASING_FXAA)
+	{
+		glGenTextures(1, &m_ldrColorTexture);
+		glBindTexture(GL_TEXTURE_2D, m_ldrColorTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenFramebuffers(1, &m_ldrFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_ldrFramebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ldrColorTexture, 0);
+		m_bComplete = (CheckFramebuffer(m_ldrFramebuffer, "FXAA") == true) && (m_bComplete == true);
+	}
+
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (m_bComplete == true)
+	{
+		const char* antialiasingNames[] = { "no antialiasing", "MSAA", "FXAA" };
+
+		std::cout << "INFO: offscreen render target " << width << "x" << height << " with "
+			<< antialiasingNames[m_bufferAntialiasing];
+		if (m_bufferSamples > 0)
+		{
+			std::cout << " " << m_bufferSamples << "x";
+		}
+		std::cout << std::endl;
+	}
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the offscreen buffers.
+ ***********************************************************/
+void RenderTarget::DestroyBuffers()
+{
+	GLuint framebuffers[3] = { m_sceneFramebuffer, m_msaaFramebuffer, m_ldrFramebuffer };
+	GLuint renderbuffers[3] = { m_sceneDepthBuffer, m_msaaColorBuffer, m_msaaDepthBuffer };
+	GLuint textures[2] = { m_sceneColorTexture, m_ldrColorTexture };
+
+	// names of 0 are ignored by the delete calls
+	glDeleteFramebuffers(3, framebuffers);
+	glDeleteRenderbuffers(3, renderbuffers);
+	glDeleteTextures(2, textures);
+
+	m_sceneFramebuffer = 0;
+	m_sceneColorTexture = 0;
+	m_sceneDepthBuffer = 0;
+	m_msaaFramebuffer = 0;
+	m_msaaColorBuffer = 0;
+	m_msaaDepthBuffer = 0;
+	m_ldrFramebuffer = 0;
+	m_ldrColorTexture = 0;
+	m_bComplete = false;
+}
+
+/***********************************************************
+ *  CheckFramebuffer()
+ *
+ *  This method is used for checking that a framebuffer is
+ *  complete.  Returns false and prints the status if not.
+ ***********************************************************/
+bool RenderTarget::CheckFramebuffer(GLuint framebuffer, const char* name)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Offscreen " << name << " framebuffer is not complete:" << status << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendertarget.h
+// ============
+// render the scene offscreen in HDR at a scaled resolution
+//
+//	The scene is drawn into a half float color buffer whose size is the
+//	window size times a resolution scale, so the fragment cost can be
+//	traded against sharpness.  With a frame time target the scale is
+//	lowered while the scene takes longer than the target on the GPU and
+//	raised again once there is room, in 5% steps so the buffers are only
+//	reallocated now and then.  The edges are smoothed either by rendering
+//	with multisampling, which is resolved before the post processing, or
+//	by an FXAA pass over the tonemapped colors.  The tonemapping keeps the
+//	colors below a shoulder as they are and rolls the brighter ones off
+//	towards white, so the scene looks as before where it was not clipped.
+//	The result is scaled to the window by the last pass.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  RenderTarget
+ *
+ *  This class contains the offscreen buffers and the code
+ *  for the resolve, tonemapping and FXAA passes.
+ ***********************************************************/
+class RenderTarget
+{
+public:
+	// edge smoothing of the offscreen rendering
+	enum ANTIALIASING
+	{
+		ANTIALIASING_NONE,
+		ANTIALIASING_MSAA,
+		ANTIALIASING_FXAA
+	};
+
+	struct TARGET_OPTIONS
+	{
+		// render size relative to the window, 0.5 to 2.0, and the
+		// largest scale that dynamic scaling goes up to
+		float resolutionScale;
+		// scene GPU time the scale is adjusted for, 0 for a fixed scale
+		float targetMilliseconds;
+		ANTIALIASING antialiasing;
+		// samples per pixel of MSAA
+		int msaaSamples;
+		// factor of the HDR colors before the tonemapping
+		float exposure;
+	};
+
+	// constructor
+	RenderTarget();
+	// destructor
+	~RenderTarget();
+
+	// build the post processing programs, false if they do not link
+	bool LoadShaders(const char* vertexShaderPath, const char* tonemapShaderPath, const char* fxaaShaderPath);
+
+	// get and change the options, the buffers follow in BeginFrame()
+	TARGET_OPTIONS GetOptions() const;
+	void SetOptions(const TARGET_OPTIONS& options);
+
+	// bind the offscreen buffers, sized for the window framebuffer
+	void BeginFrame(int windowWidth, int windowHeight);
+	// resolve, tonemap and smooth the offscreen colors into the window
+	void EndFrame();
+	// adjust the dynamic scale to the latest scene GPU time
+	void UpdateDynamicScale(double sceneMilliseconds);
+
+	// size of the offscreen buffers of the current frame
+	int GetWidth() const;
+	int GetHeight() const;
+	// scale of the current frame, below the option while dynamic
+	// scaling has lowered it
+	float GetResolutionScale() const;
+
+private:
+	TARGET_OPTIONS m_options;
+	// programs of the tonemapping and FXAA passes
+	ShaderManager* m_tonemapShader;
+	ShaderManager* m_fxaaShader;
+	// empty vertex array of the full screen triangle
+	GLuint m_vertexArray;
+
+	// HDR color texture and its depth buffer, the depth buffer
+	// is only used without multisampling
+	GLuint m_sceneFramebuffer;
+	GLuint m_sceneColorTexture;
+	GLuint m_sceneDepthBuffer;
+	// multisampled buffers that the scene is drawn into with MSAA
+	GLuint m_msaaFramebuffer;
+	GLuint m_msaaColorBuffer;
+	GLuint m_msaaDepthBuffer;
+	// tonemapped colors with the luma in alpha, read by FXAA
+	GLuint m_ldrFramebuffer;
+	GLuint m_ldrColorTexture;
+
+	// size and settings that the buffers were created with
+	int m_width;
+	int m_height;
+	ANTIALIASING m_bufferAntialiasing;
+	int m_bufferSamples;
+	// size of the window framebuffer of the current frame
+	int m_windowWidth;
+	int m_windowHeight;
+	// false when the buffers could not be created, the scene is
+	// then drawn straight into the window
+	bool m_bComplete;
+
+	// scale that dynamic scaling has settled on
+	float m_dynamicScale;
+	// smoothed scene GPU time, 0 before the first one
+	double m_smoothedMilliseconds;
+	// frames since the scale was last changed
+	int m_framesSinceScaleChange;
+
+	// create the buffers for a size and the current options
+	void CreateBuffers(int width, int height);
+	void DestroyBuffers();
+	// check that a framebuffer can be drawn into
+	bool CheckFramebuffer(GLuint framebuffer, const char* name);
+};
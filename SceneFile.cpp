@@ -0,0 +1,1029 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// scene textures, materials, lights and nodes stored outside of the code
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// header of the binary form, followed by the record arrays at
+	// the stored byte offsets, all values in little endian order
+	struct FILE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t textureCount;
+		uint32_t textureOffset;
+		uint32_t materialCount;
+		uint32_t materialOffset;
+		uint32_t lightCount;
+		uint32_t lightOffset;
+		uint32_t nodeCount;
+		uint32_t nodeOffset;
+	};
+
+	// the records are read in place, so their layout is part of
+	// the file format
+	static_assert(sizeof(FILE_HEADER) == 40, "FILE_HEADER must be 40 bytes");
+	static_assert(sizeof(SceneFile::FILE_TEXTURE) == 160, "FILE_TEXTURE must be 160 bytes");
+	static_assert(sizeof(SceneFile::FILE_MATERIAL) == 60, "FILE_MATERIAL must be 60 bytes");
+	static_assert(sizeof(SceneFile::FILE_LIGHT) == 60, "FILE_LIGHT must be 60 bytes");
+	static_assert(sizeof(SceneFile::FILE_NODE) == 80, "FILE_NODE must be 80 bytes");
+
+	const uint32_t g_SceneMagic = 0x4E435343;	// "CSCN"
+	const uint32_t g_SceneVersion = 1;
+	const char* g_BinaryExtension = ".bin";
+
+	// mesh names of the text form, in SceneManager::MESH_TYPE order
+	const char* g_MeshNames[] = { "none", "box", "plane", "cylinder", "sphere", "torus" };
+	const int g_MeshCount = sizeof(g_MeshNames) / sizeof(g_MeshNames[0]);
+
+	/***********************************************************
+	 *  FindMeshName()
+	 *
+	 *  Returns the mesh type of a mesh name, or -1 when the
+	 *  name is not known.
+	 ***********************************************************/
+	int FindMeshName(const std::string& name)
+	{
+		for (int i = 0; i < g_MeshCount; i++)
+		{
+			if (name == g_MeshNames[i])
+			{
+				return(i);
+			}
+		}
+
+		return(-1);
+	}
+
+	/***********************************************************
+	 *  ReadFloats()
+	 *
+	 *  Reads count numbers from a stream.  Returns false if the
+	 *  stream runs out or holds something else.
+	 ***********************************************************/
+	bool ReadFloats(std::istream& stream, float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (!(stream >> values[i]))
+			{
+				return(false);
+			}
+		}
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  WriteFloats()
+	 *
+	 *  Writes count numbers to a stream, each after a space.
+	 ***********************************************************/
+	void WriteFloats(std::ostream& stream, const float* values, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			stream << " " << values[i];
+		}
+	}
+
+	/***********************************************************
+	 *  IsNameTerminated()
+	 *
+	 *  Returns true if a fixed size name read from a file ends
+	 *  inside of its array.
+	 ***********************************************************/
+	bool IsNameTerminated(const char* name, int length)
+	{
+		return(memchr(name, '\0', (size_t)length) != NULL);
+	}
+
+	/***********************************************************
+	 *  IsArrayInFile()
+	 *
+	 *  Returns true if an array of count records of recordSize
+	 *  bytes at offset lies inside of a file of fileSize bytes
+	 *  and starts on a 4 byte boundary.
+	 ***********************************************************/
+	bool IsArrayInFile(uint32_t offset, uint32_t count, size_t recordSize, size_t fileSize)
+	{
+		if (((offset % 4) != 0) || (offset > fileSize))
+		{
+			return(false);
+		}
+
+		return((size_t)count <= (fileSize - offset) / recordSize);
+	}
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_pMappedData = NULL;
+	m_mappedSize = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_pMappedTextures = NULL;
+	m_pMappedMaterials = NULL;
+	m_pMappedLights = NULL;
+	m_pMappedNodes = NULL;
+	m_mappedTextureCount = 0;
+	m_mappedMaterialCount = 0;
+	m_mappedLightCount = 0;
+	m_mappedNodeCount = 0;
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+	UnmapFile();
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every record and
+ *  unmapping a loaded binary file.
+ ***********************************************************/
+void SceneFile::Clear()
+{
+	UnmapFile();
+	m_textures.clear();
+	m_materials.clear();
+	m_lights.clear();
+	m_nodes.clear();
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading a scene file in either
+ *  form.  Files that start with the binary header are mapped
+ *  and everything else is parsed as text.
+ ***********************************************************/
+bool SceneFile::Load(const std::string& filename)
+{
+	uint32_t magic = 0;
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cout << "Could not open scene file:" << filename << std::endl;
+		return(false);
+	}
+	file.read((char*)&magic, sizeof(magic));
+	file.close();
+
+	if (magic == g_SceneMagic)
+	{
+		return(LoadBinary(filename));
+	}
+
+	return(LoadText(filename));
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing the scene in binary form
+ *  to a file ending in ".bin" and in text form otherwise.
+ ***********************************************************/
+bool SceneFile::Save(const std::string& filename) const
+{
+	size_t extensionLength = strlen(g_BinaryExtension);
+
+	if ((filename.size() >= extensionLength) &&
+		(filename.compare(filename.size() - extensionLength, extensionLength, g_BinaryExtension) == 0))
+	{
+		return(SaveBinary(filename));
+	}
+
+	return(SaveText(filename));
+}
+
+/***********************************************************
+ *  LoadText()
+ *
+ *  This method is used for parsing the text form of a scene
+ *  into the records.  Nothing is kept when a line can not be
+ *  parsed, and the line is reported.
+ ***********************************************************/
+bool SceneFile::LoadText(const std::string& filename)
+{
+	std::ifstream file(filename);
+	std::string line;
+	std::string error;
+	int lineNumber = 0;
+
+	Clear();
+	if (!file.is_open())
+	{
+		std::cout << "Could not open scene file:" << filename << std::endl;
+		return(false);
+	}
+
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+		if (ParseLine(line, error) == false)
+		{
+			std::cout << "Scene file error in " << filename << " line " << lineNumber << ":" << error << std::endl;
+			Clear();
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ParseLine()
+ *
+ *  This method is used for adding the record of one line of
+ *  the text form.  Empty and comment lines add nothing.
+ ***********************************************************/
+bool SceneFile::ParseLine(const std::string& line, std::string& error)
+{
+	std::istringstream stream(line.substr(0, line.find('#')));
+	std::string keyword;
+
+	if (!(stream >> keyword))
+	{
+		return(true);
+	}
+
+	if (keyword == "texture")
+	{
+		std::string tag;
+		std::string filename;
+
+		// the file name is the rest of the line, spaces included
+		stream >> tag;
+		std::getline(stream >> std::ws, filename);
+		filename.erase(filename.find_last_not_of(" \t\r") + 1);
+		if ((tag.empty() == true) || (filename.empty() == true))
+		{
+			error = "texture needs a tag and a file name";
+			return(false);
+		}
+		if (((int)tag.size() >= MAX_TAG_LENGTH) || ((int)filename.size() >= MAX_FILENAME_LENGTH))
+		{
+			error = "texture tag or file name is too long";
+			return(false);
+		}
+		if (AddTexture(tag, filename) < 0)
+		{
+			error = "texture tag is already used:" + tag;
+			return(false);
+		}
+	}
+	else if (keyword == "material")
+	{
+		FILE_MATERIAL material;
+		std::string tag;
+
+		memset(&material, 0, sizeof(material));
+		if (!(stream >> tag) ||
+			(ReadFloats(stream, material.diffuseColor, 3) == false) ||
+			(ReadFloats(stream, material.specularColor, 3) == false) ||
+			(ReadFloats(stream, &material.shininess, 1) == false))
+		{
+			error = "material needs a tag, 6 colors and a shininess";
+			return(false);
+		}
+		if ((int)tag.size() >= MAX_TAG_LENGTH)
+		{
+			error = "material tag is too long";
+			return(false);
+		}
+		CopyName(material.tag, MAX_TAG_LENGTH, tag);
+		if (AddMaterial(material) < 0)
+		{
+			error = "material tag is already used:" + tag;
+			return(false);
+		}
+	}
+	else if (keyword == "light")
+	{
+		FILE_LIGHT light;
+
+		if ((ReadFloats(stream, light.position, 3) == false) ||
+			(ReadFloats(stream, light.ambient, 3) == false) ||
+			(ReadFloats(stream, light.diffuse, 3) == false) ||
+			(ReadFloats(stream, light.specular, 3) == false) ||
+			(ReadFloats(stream, &light.constant, 1) == false) ||
+			(ReadFloats(stream, &light.linear, 1) == false) ||
+			(ReadFloats(stream, &light.quadratic, 1) == false))
+		{
+			error = "light needs a position, 9 colors and 3 attenuation values";
+			return(false);
+		}
+		AddLight(light);
+	}
+	else if (keyword == "node")
+	{
+		FILE_NODE node;
+		std::string meshName;
+		std::string option;
+
+		memset(&node, 0, sizeof(node));
+		node.textureIndex = -1;
+		node.blendTextureIndex = -1;
+		node.materialIndex = -1;
+		node.bStatic = 1;
+		for (int i = 0; i < 4; i++)
+		{
+			node.color[i] = 1.0f;
+		}
+
+		if (!(stream >> meshName >> node.parentIndex) ||
+			(ReadFloats(stream, node.scale, 3) == false) ||
+			(ReadFloats(stream, node.rotation, 3) == false) ||
+			(ReadFloats(stream, node.position, 3) == false))
+		{
+			error = "node needs a mesh, a parent, a scale, a rotation and a position";
+			return(false);
+		}
+		node.mesh = FindMeshName(meshName);
+		if (node.mesh < 0)
+		{
+			error = "unknown mesh:" + meshName;
+			return(false);
+		}
+		if ((node.parentIndex < -1) || (node.parentIndex >= GetNodeCount()))
+		{
+			error = "the parent must be an earlier node";
+			return(false);
+		}
+
+		// the options are name=value words in any order
+		while (stream >> option)
+		{
+			size_t equals = option.find('=');
+			std::string name = option.substr(0, equals);
+			std::string value = (equals == std::string::npos) ? "" : option.substr(equals + 1);
+			std::replace(value.begin(), value.end(), ',', ' ');
+			std::istringstream values(value);
+
+			if (name == "texture")
+			{
+				node.textureIndex = FindTexture(value);
+				if (node.textureIndex < 0)
+				{
+					error = "unknown texture:" + value;
+					return(false);
+				}
+			}
+			else if (name == "blend")
+			{
+				std::string tag;
+				if (!(values >> tag) || (ReadFloats(values, &node.blendFactor, 1) == false))
+				{
+					error = "blend needs a texture and a factor";
+					return(false);
+				}
+				node.blendTextureIndex = FindTexture(tag);
+				if (node.blendTextureIndex < 0)
+				{
+					error = "unknown texture:" + tag;
+					return(false);
+				}
+			}
+			else if (name == "color")
+			{
+				if (ReadFloats(values, node.color, 4) == false)
+				{
+					error = "color needs 4 values";
+					return(false);
+				}
+			}
+			else if (name == "material")
+			{
+				node.materialIndex = FindMaterial(value);
+				if (node.materialIndex < 0)
+				{
+					error = "unknown material:" + value;
+					return(false);
+				}
+			}
+			else if (name == "dynamic")
+			{
+				node.bStatic = 0;
+			}
+			else
+			{
+				error = "unknown node option:" + option;
+				return(false);
+			}
+		}
+		if ((node.blendTextureIndex >= 0) && (node.textureIndex < 0))
+		{
+			error = "blend needs a texture";
+			return(false);
+		}
+		AddNode(node);
+	}
+	else
+	{
+		error = "unknown record:" + keyword;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveText()
+ *
+ *  This method is used for writing the records in text form.
+ *  The numbers are written with enough digits to read back
+ *  the same scene, and node options are only written where
+ *  a node differs from the defaults.
+ ***********************************************************/
+bool SceneFile::SaveText(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::trunc);
+	const FILE_TEXTURE* pTextures = GetTextures();
+	const FILE_MATERIAL* pMaterials = GetMaterials();
+	const FILE_LIGHT* pLights = GetLights();
+	const FILE_NODE* pNodes = GetNodes();
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not write scene file:" << filename << std::endl;
+		return(false);
+	}
+	file << std::setprecision(7);
+
+	file << "# textures: tag file" << std::endl;
+	for (int i = 0; i < GetTextureCount(); i++)
+	{
+		file << "texture " << pTextures[i].tag << " " << pTextures[i].filename << std::endl;
+	}
+
+	file << std::endl << "# materials: tag diffuse specular shininess" << std::endl;
+	for (int i = 0; i < GetMaterialCount(); i++)
+	{
+		file << "material " << pMaterials[i].tag;
+		WriteFloats(file, pMaterials[i].diffuseColor, 3);
+		WriteFloats(file, pMaterials[i].specularColor, 3);
+		WriteFloats(file, &pMaterials[i].shininess, 1);
+		file << std::endl;
+	}
+
+	file << std::endl << "# lights: position ambient diffuse specular constant linear quadratic" << std::endl;
+	for (int i = 0; i < GetLightCount(); i++)
+	{
+		file << "light";
+		WriteFloats(file, pLights[i].position, 3);
+		WriteFloats(file, pLights[i].ambient, 3);
+		WriteFloats(file, pLights[i].diffuse, 3);
+		WriteFloats(file, pLights[i].specular, 3);
+		WriteFloats(file, &pLights[i].constant, 1);
+		WriteFloats(file, &pLights[i].linear, 1);
+		WriteFloats(file, &pLights[i].quadratic, 1);
+		file << std::endl;
+	}
+
+	file << std::endl << "# nodes: mesh parent scale rotation position options" << std::endl;
+	for (int i = 0; i < GetNodeCount(); i++)
+	{
+		const FILE_NODE& node = pNodes[i];
+
+		file << "node " << (((node.mesh >= 0) && (node.mesh < g_MeshCount)) ? g_MeshNames[node.mesh] : "none")
+			<< " " << node.parentIndex;
+		WriteFloats(file, node.scale, 3);
+		WriteFloats(file, node.rotation, 3);
+		WriteFloats(file, node.position, 3);
+		if (node.textureIndex >= 0)
+		{
+			file << " texture=" << pTextures[node.textureIndex].tag;
+			if (node.blendTextureIndex >= 0)
+			{
+				file << " blend=" << pTextures[node.blendTextureIndex].tag << "," << node.blendFactor;
+			}
+		}
+		else if ((node.color[0] != 1.0f) || (node.color[1] != 1.0f) || (node.color[2] != 1.0f) || (node.color[3] != 1.0f))
+		{
+			// the color is only drawn on untextured nodes
+			file << " color=" << node.color[0] << "," << node.color[1] << "," << node.color[2] << "," << node.color[3];
+		}
+		if (node.materialIndex >= 0)
+		{
+			file << " material=" << pMaterials[node.materialIndex].tag;
+		}
+		if (node.bStatic == 0)
+		{
+			file << " dynamic";
+		}
+		file << std::endl;
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  LoadBinary()
+ *
+ *  This method is used for mapping the binary form of a
+ *  scene into memory and pointing the record arrays at it.
+ *  Only the header and the record indices are checked, the
+ *  records themselves are used as they are in the file.
+ ***********************************************************/
+bool SceneFile::LoadBinary(const std::string& filename)
+{
+	FILE_HEADER header;
+
+	Clear();
+	if (MapFile(filename) == false)
+	{
+		std::cout << "Could not map scene file:" << filename << std::endl;
+		return(false);
+	}
+
+	if (m_mappedSize < sizeof(FILE_HEADER))
+	{
+		std::cout << "Ignoring truncated scene file:" << filename << std::endl;
+		UnmapFile();
+		return(false);
+	}
+	memcpy(&header, m_pMappedData, sizeof(FILE_HEADER));
+
+	if ((header.magic != g_SceneMagic) || (header.version != g_SceneVersion) ||
+		(IsArrayInFile(header.textureOffset, header.textureCount, sizeof(FILE_TEXTURE), m_mappedSize) == false) ||
+		(IsArrayInFile(header.materialOffset, header.materialCount, sizeof(FILE_MATERIAL), m_mappedSize) == false) ||
+		(IsArrayInFile(header.lightOffset, header.lightCount, sizeof(FILE_LIGHT), m_mappedSize) == false) ||
+		(IsArrayInFile(header.nodeOffset, header.nodeCount, sizeof(FILE_NODE), m_mappedSize) == false))
+	{
+		std::cout << "Ignoring unsupported scene file:" << filename << std::endl;
+		UnmapFile();
+		return(false);
+	}
+
+	m_pMappedTextures = (const FILE_TEXTURE*)(m_pMappedData + header.textureOffset);
+	m_pMappedMaterials = (const FILE_MATERIAL*)(m_pMappedData + header.materialOffset);
+	m_pMappedLights = (const FILE_LIGHT*)(m_pMappedData + header.lightOffset);
+	m_pMappedNodes = (const FILE_NODE*)(m_pMappedData + header.nodeOffset);
+	m_mappedTextureCount = (int)header.textureCount;
+	m_mappedMaterialCount = (int)header.materialCount;
+	m_mappedLightCount = (int)header.lightCount;
+	m_mappedNodeCount = (int)header.nodeCount;
+
+	if (CheckMappedRecords() == false)
+	{
+		std::cout << "Ignoring scene file with invalid records:" << filename << std::endl;
+		UnmapFile();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CheckMappedRecords()
+ *
+ *  This method is used for checking that every name of the
+ *  mapped records is terminated and every index points at
+ *  a record that exists, so the records can be used without
+ *  any further checks.
+ ***********************************************************/
+bool SceneFile::CheckMappedRecords() const
+{
+	for (int i = 0; i < m_mappedTextureCount; i++)
+	{
+		if ((IsNameTerminated(m_pMappedTextures[i].tag, MAX_TAG_LENGTH) == false) ||
+			(IsNameTerminated(m_pMappedTextures[i].filename, MAX_FILENAME_LENGTH) == false))
+		{
+			return(false);
+		}
+	}
+
+	for (int i = 0; i < m_mappedMaterialCount; i++)
+	{
+		if (IsNameTerminated(m_pMappedMaterials[i].tag, MAX_TAG_LENGTH) == false)
+		{
+			return(false);
+		}
+	}
+
+	for (int i = 0; i < m_mappedNodeCount; i++)
+	{
+		const FILE_NODE& node = m_pMappedNodes[i];
+
+		if ((node.mesh < 0) || (node.mesh >= g_MeshCount) ||
+			(node.parentIndex < -1) || (node.parentIndex >= i) ||
+			(node.textureIndex < -1) || (node.textureIndex >= m_mappedTextureCount) ||
+			(node.blendTextureIndex < -1) || (node.blendTextureIndex >= m_mappedTextureCount) ||
+			(node.materialIndex < -1) || (node.materialIndex >= m_mappedMaterialCount))
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveBinary()
+ *
+ *  This method is used for writing the header and the record
+ *  arrays of the binary form, one array after another.
+ ***********************************************************/
+bool SceneFile::SaveBinary(const std::string& filename) const
+{
+	FILE_HEADER header;
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		std::cout << "Could not write scene file:" << filename << std::endl;
+		return(false);
+	}
+
+	header.magic = g_SceneMagic;
+	header.version = g_SceneVersion;
+	header.textureCount = (uint32_t)GetTextureCount();
+	header.textureOffset = (uint32_t)sizeof(FILE_HEADER);
+	header.materialCount = (uint32_t)GetMaterialCount();
+	header.materialOffset = header.textureOffset + header.textureCount * (uint32_t)sizeof(FILE_TEXTURE);
+	header.lightCount = (uint32_t)GetLightCount();
+	header.lightOffset = header.materialOffset + header.materialCount * (uint32_t)sizeof(FILE_MATERIAL);
+	header.nodeCount = (uint32_t)GetNodeCount();
+	header.nodeOffset = header.lightOffset + header.lightCount * (uint32_t)sizeof(FILE_LIGHT);
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)GetTextures(), (std::streamsize)(header.textureCount * sizeof(FILE_TEXTURE)));
+	file.write((const char*)GetMaterials(), (std::streamsize)(header.materialCount * sizeof(FILE_MATERIAL)));
+	file.write((const char*)GetLights(), (std::streamsize)(header.lightCount * sizeof(FILE_LIGHT)));
+	file.write((const char*)GetNodes(), (std::streamsize)(header.nodeCount * sizeof(FILE_NODE)));
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  MapFile()
+ *
+ *  This method is used for mapping a whole file into memory
+ *  read-only.  The pages are only read from the disk when
+ *  the records on them are first used.
+ ***********************************************************/
+bool SceneFile::MapFile(const std::string& filename)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER fileSize;
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return(false);
+	}
+	if ((GetFileSizeEx(file, &fileSize) == FALSE) || (fileSize.QuadPart <= 0))
+	{
+		CloseHandle(file);
+		return(false);
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+		return(false);
+	}
+
+	void* pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (pData == NULL)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return(false);
+	}
+
+	m_fileHandle = file;
+	m_mappingHandle = mapping;
+	m_pMappedData = (const unsigned char*)pData;
+	m_mappedSize = (size_t)fileSize.QuadPart;
+#else
+	int file = open(filename.c_str(), O_RDONLY);
+	struct stat fileStatus;
+
+	if (file < 0)
+	{
+		return(false);
+	}
+	if ((fstat(file, &fileStatus) != 0) || (fileStatus.st_size <= 0))
+	{
+		close(file);
+		return(false);
+	}
+
+	// the mapping stays valid after the file is closed
+	void* pData = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (pData == MAP_FAILED)
+	{
+		return(false);
+	}
+
+	m_pMappedData = (const unsigned char*)pData;
+	m_mappedSize = (size_t)fileStatus.st_size;
+#endif
+
+	return(true);
+}
+
+/***********************************************************
+ *  UnmapFile()
+ *
+ *  This method is used for unmapping the mapped file and
+ *  forgetting the records inside of it.
+ ***********************************************************/
+void SceneFile::UnmapFile()
+{
+	if (m_pMappedData != NULL)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_pMappedData);
+		CloseHandle((HANDLE)m_mappingHandle);
+		CloseHandle((HANDLE)m_fileHandle);
+#else
+		munmap((void*)m_pMappedData, m_mappedSize);
+#endif
+	}
+
+	m_pMappedData = NULL;
+	m_mappedSize = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+	m_pMappedTextures = NULL;
+	m_pMappedMaterials = NULL;
+	m_pMappedLights = NULL;
+	m_pMappedNodes = NULL;
+	m_mappedTextureCount = 0;
+	m_mappedMaterialCount = 0;
+	m_mappedLightCount = 0;
+	m_mappedNodeCount = 0;
+}
+
+/***********************************************************
+ *  CopyMappedRecords()
+ *
+ *  This method is used for copying the records of a mapped
+ *  file into the vectors and unmapping it, so records can
+ *  be added to a scene that was loaded in binary form.
+ ***********************************************************/
+void SceneFile::CopyMappedRecords()
+{
+	if (m_pMappedData == NULL)
+	{
+		return;
+	}
+
+	m_textures.assign(m_pMappedTextures, m_pMappedTextures + m_mappedTextureCount);
+	m_materials.assign(m_pMappedMaterials, m_pMappedMaterials + m_mappedMaterialCount);
+	m_lights.assign(m_pMappedLights, m_pMappedLights + m_mappedLightCount);
+	m_nodes.assign(m_pMappedNodes, m_pMappedNodes + m_mappedNodeCount);
+	UnmapFile();
+}
+
+/***********************************************************
+ *  AddTexture()
+ *
+ *  This method is used for adding a texture record and
+ *  returning its index, or -1 if the tag is already used.
+ ***********************************************************/
+int SceneFile::AddTexture(const std::string& tag, const std::string& filename)
+{
+	FILE_TEXTURE texture;
+
+	if (FindTexture(tag) >= 0)
+	{
+		return(-1);
+	}
+
+	CopyMappedRecords();
+	CopyName(texture.tag, MAX_TAG_LENGTH, tag);
+	CopyName(texture.filename, MAX_FILENAME_LENGTH, filename);
+	m_textures.push_back(texture);
+
+	return((int)m_textures.size() - 1);
+}
+
+/***********************************************************
+ *  AddMaterial()
+ *
+ *  This method is used for adding a material record and
+ *  returning its index, or -1 if the tag is already used.
+ ***********************************************************/
+int SceneFile::AddMaterial(const FILE_MATERIAL& material)
+{
+	if (FindMaterial(material.tag) >= 0)
+	{
+		return(-1);
+	}
+
+	CopyMappedRecords();
+	m_materials.push_back(material);
+
+	return((int)m_materials.size() - 1);
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a light record and
+ *  returning its index.
+ ***********************************************************/
+int SceneFile::AddLight(const FILE_LIGHT& light)
+{
+	CopyMappedRecords();
+	m_lights.push_back(light);
+
+	return((int)m_lights.size() - 1);
+}
+
+/***********************************************************
+ *  AddNode()
+ *
+ *  This method is used for adding a node record and
+ *  returning its index.  The parent must already be added.
+ ***********************************************************/
+int SceneFile::AddNode(const FILE_NODE& node)
+{
+	CopyMappedRecords();
+	m_nodes.push_back(node);
+
+	return((int)m_nodes.size() - 1);
+}
+
+/***********************************************************
+ *  GetTextureCount()
+ *
+ *  This method is used for getting the number of textures.
+ ***********************************************************/
+int SceneFile::GetTextureCount() const
+{
+	return((m_pMappedData != NULL) ? m_mappedTextureCount : (int)m_textures.size());
+}
+
+/***********************************************************
+ *  GetTextures()
+ *
+ *  This method is used for getting the texture records.
+ ***********************************************************/
+const SceneFile::FILE_TEXTURE* SceneFile::GetTextures() const
+{
+	return((m_pMappedData != NULL) ? m_pMappedTextures : m_textures.data());
+}
+
+/***********************************************************
+ *  GetMaterialCount()
+ *
+ *  This method is used for getting the number of materials.
+ ***********************************************************/
+int SceneFile::GetMaterialCount() const
+{
+	return((m_pMappedData != NULL) ? m_mappedMaterialCount : (int)m_materials.size());
+}
+
+/***********************************************************
+ *  GetMaterials()
+ *
+ *  This method is used for getting the material records.
+ ***********************************************************/
+const SceneFile::FILE_MATERIAL* SceneFile::GetMaterials() const
+{
+	return((m_pMappedData != NULL) ? m_pMappedMaterials : m_materials.data());
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of lights.
+ ***********************************************************/
+int SceneFile::GetLightCount() const
+{
+	return((m_pMappedData != NULL) ? m_mappedLightCount : (int)m_lights.size());
+}
+
+/***********************************************************
+ *  GetLights()
+ *
+ *  This method is used for getting the light records.
+ ***********************************************************/
+const SceneFile::FILE_LIGHT* SceneFile::GetLights() const
+{
+	return((m_pMappedData != NULL) ? m_pMappedLights : m_lights.data());
+}
+
+/***********************************************************
+ *  GetNodeCount()
+ *
+ *  This method is used for getting the number of nodes.
+ ***********************************************************/
+int SceneFile::GetNodeCount() const
+{
+	return((m_pMappedData != NULL) ? m_mappedNodeCount : (int)m_nodes.size());
+}
+
+/***********************************************************
+ *  GetNodes()
+ *
+ *  This method is used for getting the node records.
+ ***********************************************************/
+const SceneFile::FILE_NODE* SceneFile::GetNodes() const
+{
+	return((m_pMappedData != NULL) ? m_pMappedNodes : m_nodes.data());
+}
+
+/***********************************************************
+ *  FindTexture()
+ *
+ *  This method is used for getting the index of the texture
+ *  with the passed in tag, or -1 if no texture has the tag.
+ ***********************************************************/
+int SceneFile::FindTexture(const std::string& tag) const
+{
+	const FILE_TEXTURE* pTextures = GetTextures();
+
+	for (int i = 0; i < GetTextureCount(); i++)
+	{
+		if (tag == pTextures[i].tag)
+		{
+			return(i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting the index of the material
+ *  with the passed in tag, or -1 if no material has the tag.
+ ***********************************************************/
+int SceneFile::FindMaterial(const std::string& tag) const
+{
+	const FILE_MATERIAL* pMaterials = GetMaterials();
+
+	for (int i = 0; i < GetMaterialCount(); i++)
+	{
+		if (tag == pMaterials[i].tag)
+		{
+			return(i);
+		}
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  CopyName()
+ *
+ *  This method is used for copying a string into a fixed
+ *  size name, cutting it off so that it is always
+ *  terminated and clearing the rest of the name.
+ ***********************************************************/
+void SceneFile::CopyName(char* destination, int length, const std::string& source)
+{
+	size_t count = std::min(source.size(), (size_t)(length - 1));
+
+	memset(destination, 0, (size_t)length);
+	memcpy(destination, source.data(), count);
+}
@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// scene textures, materials, lights and nodes stored outside of the code
+//
+//	A scene has a text form that can be edited by hand and a compiled
+//	binary form.  The binary form is a header followed by flat arrays of
+//	fixed size records, so loading it only maps the file into memory and
+//	points the arrays at it, without parsing or copying anything.  The
+//	text form is parsed into the same records, with one line per record:
+//
+//	  texture <tag> <filename>
+//	  material <tag> <diffuse rgb> <specular rgb> <shininess>
+//	  light <position xyz> <ambient rgb> <diffuse rgb> <specular rgb>
+//	        <constant> <linear> <quadratic>
+//	  node <mesh> <parent> <scale xyz> <rotation xyz> <position xyz>
+//	       [texture=<tag>] [blend=<tag>,<factor>] [color=<r>,<g>,<b>,<a>]
+//	       [material=<tag>] [dynamic]
+//
+//	The mesh is none, box, plane, cylinder, sphere or torus, rotations are
+//	in degrees and the parent is the index of an earlier node in the file,
+//	-1 for the scene root.  Everything after a # is a comment.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class contains the records of a scene and the code
+ *  for reading and writing its text and binary forms.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// maximum lengths of the stored tags and file names
+	static const int MAX_TAG_LENGTH = 32;
+	static const int MAX_FILENAME_LENGTH = 128;
+
+	struct FILE_TEXTURE
+	{
+		char tag[MAX_TAG_LENGTH];
+		char filename[MAX_FILENAME_LENGTH];
+	};
+
+	struct FILE_MATERIAL
+	{
+		char tag[MAX_TAG_LENGTH];
+		float diffuseColor[3];
+		float specularColor[3];
+		float shininess;
+	};
+
+	struct FILE_LIGHT
+	{
+		float position[3];
+		float ambient[3];
+		float diffuse[3];
+		float specular[3];
+		float constant;
+		float linear;
+		float quadratic;
+	};
+
+	struct FILE_NODE
+	{
+		// SceneManager::MESH_TYPE of the node
+		int32_t mesh;
+		// index of an earlier node, -1 for the scene root
+		int32_t parentIndex;
+		float scale[3];
+		// rotations in degrees
+		float rotation[3];
+		float position[3];
+		// indices into the textures, -1 for none
+		int32_t textureIndex;
+		int32_t blendTextureIndex;
+		float blendFactor;
+		float color[4];
+		// index into the materials, -1 for none
+		int32_t materialIndex;
+		// 0 for nodes that are moved after the scene is built
+		int32_t bStatic;
+	};
+
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// read the text or binary form, told apart by the first bytes
+	bool Load(const std::string& filename);
+	// write the text form, or the binary form for a ".bin" file
+	bool Save(const std::string& filename) const;
+	bool LoadText(const std::string& filename);
+	bool SaveText(const std::string& filename) const;
+	// map the binary form into memory and use its records in place
+	bool LoadBinary(const std::string& filename);
+	bool SaveBinary(const std::string& filename) const;
+	// remove every record and unmap a loaded binary file
+	void Clear();
+
+	// add records, copying a mapped file into memory first
+	int AddTexture(const std::string& tag, const std::string& filename);
+	int AddMaterial(const FILE_MATERIAL& material);
+	int AddLight(const FILE_LIGHT& light);
+	int AddNode(const FILE_NODE& node);
+
+	// records of the scene, valid until the file is changed
+	int GetTextureCount() const;
+	const FILE_TEXTURE* GetTextures() const;
+	int GetMaterialCount() const;
+	const FILE_MATERIAL* GetMaterials() const;
+	int GetLightCount() const;
+	const FILE_LIGHT* GetLights() const;
+	int GetNodeCount() const;
+	const FILE_NODE* GetNodes() const;
+
+	// find a record by tag, -1 when no record has the tag
+	int FindTexture(const std::string& tag) const;
+	int FindMaterial(const std::string& tag) const;
+
+	// copy a string into a fixed size tag or file name
+	static void CopyName(char* destination, int length, const std::string& source);
+
+private:
+	// records added or parsed from the text form
+	std::vector<FILE_TEXTURE> m_textures;
+	std::vector<FILE_MATERIAL> m_materials;
+	std::vector<FILE_LIGHT> m_lights;
+	std::vector<FILE_NODE> m_nodes;
+
+	// mapped binary file, NULL when the records are in the vectors
+	const unsigned char* m_pMappedData;
+	size_t m_mappedSize;
+	// file and mapping handles of the mapped file on Windows
+	void* m_fileHandle;
+	void* m_mappingHandle;
+	// records inside the mapped file
+	const FILE_TEXTURE* m_pMappedTextures;
+	const FILE_MATERIAL* m_pMappedMaterials;
+	const FILE_LIGHT* m_pMappedLights;
+	const FILE_NODE* m_pMappedNodes;
+	int m_mappedTextureCount;
+	int m_mappedMaterialCount;
+	int m_mappedLightCount;
+	int m_mappedNodeCount;
+
+	// map a whole file read-only, false when it can not be mapped
+	bool MapFile(const std::string& filename);
+	void UnmapFile();
+	// copy the records of a mapped file into the vectors
+	void CopyMappedRecords();
+	// check that the indices of the mapped records are in range
+	bool CheckMappedRecords() const;
+	// parse one line of the text form
+	bool ParseLine(const std::string& line, std::string& error);
+};
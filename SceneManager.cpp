@@ -1,4441 +1,3833 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.cpp
-// ================
-// This file contains the implementation of the `SceneManager` class, which is 
-// responsible for managing the preparation and rendering of 3D scenes. It 
-// handles textures, materials, lighting configurations, and object rendering.
-//
-// AUTHOR: Brian Battersby
-// INSTITUTION: Southern New Hampshire University (SNHU)
-// COURSE: CS-330 Computational Graphics and Visualization
-//
-// INITIAL VERSION: November 1, 2023
-// LAST REVISED: December 1, 2024
-//
-// RESPONSIBILITIES:
-// - Load, bind, and manage textures in OpenGL.
-// - Define materials and lighting properties for 3D objects.
-// - Manage transformations and shader configurations.
-// - Render complex 3D scenes using basic meshes.
-//
-// NOTE: This implementation leverages external libraries like `stb_image` for 
-// texture loading and GLM for matrix and vector operations.
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/transform.hpp>
-
-// declaration of global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-
-		// ensure no leftover texture blending affects this draw
-		m_pShaderManager->setFloatValue("blendFactor", 0.0f);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-
-		// neutralize any prior two-texture/color blend
-		m_pShaderManager->setSampler2DValue("blendTexture", textureID);
-		m_pShaderManager->setFloatValue("blendFactor", 0.0f); // no mix
-
-	}
-}
-
-
-
-void SceneManager::SetShaderTextures(
-	std::string textureTag, std::string textureTag2)
-{
-	
-	//I do not know what to put here to mix two textures
-
-}
-
-
-
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
-
-//Used to load textures into memory for the scene.
-void SceneManager::LoadSceneTextures()
-{
-	bool bReturn = false;
-
-	//fan texture
-	bReturn = CreateGLTexture("textures/black plastic.jpg", "blackPlastic");
-	//Stand texture
-	bReturn = CreateGLTexture("textures/wood.jpg", "stand");
-	//fan blade texture
-	bReturn = CreateGLTexture("textures/fanblade.jpg", "blade");
-	//wall texture
-	bReturn = CreateGLTexture("textures/wall.jpg", "wall");
-	//motherboard texture
-	bReturn = CreateGLTexture("textures/microchip.jpg", "chip");
-	//gpu texture
-	bReturn = CreateGLTexture("textures/gpu.jpg", "gpu");
-
-
-
-	BindGLTextures();
-
-}
-
-
-//*************DefineObjects********************//
-void SceneManager::DefineObjectMaterials()
-{
-
-	OBJECT_MATERIAL plasticMaterial;
-	plasticMaterial.diffuseColor = glm::vec3(5.0f, 5.0f, 5.0f);
-	plasticMaterial.specularColor = glm::vec3(5.0f, 5.0f, 5.0f);
-	plasticMaterial.shininess = 30.0;
-	plasticMaterial.tag = "plastic";
-
-	m_objectMaterials.push_back(plasticMaterial);
-
-	OBJECT_MATERIAL woodMaterial;
-	woodMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.3f);
-	woodMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
-	woodMaterial.shininess = 0.1;
-	woodMaterial.tag = "wood";
-
-	m_objectMaterials.push_back(woodMaterial);
-
-	OBJECT_MATERIAL middleMaterial;
-	middleMaterial.diffuseColor = glm::vec3(.0f, 0.0f, 0.0f);
-	middleMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
-	middleMaterial.shininess = 5.0;
-	middleMaterial.tag = "middle";
-
-	m_objectMaterials.push_back(middleMaterial);
-	
-
-	//mootherboard material
-	OBJECT_MATERIAL motherMaterial;
-	motherMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.3f);
-	motherMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
-	motherMaterial.shininess = 20.03;
-	motherMaterial.tag = "mother";
-
-	m_objectMaterials.push_back(motherMaterial);
-	
-	//glass panels
-	OBJECT_MATERIAL glassMaterial;
-	glassMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
-	glassMaterial.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
-	glassMaterial.shininess = 95.0;
-	glassMaterial.tag = "glass";
-
-	m_objectMaterials.push_back(glassMaterial);
-
-}
-
-void SceneManager::SetupSceneLights()
-{
-
-		m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	//main light
-	m_pShaderManager->setVec3Value("pointLights[0].position", -4.0f, 8.0f, 5.0f);
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.5f, 0.5f, 0.5f);
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 0.1f, 0.1f, 0.1f);
-	m_pShaderManager->setFloatValue("pointLights[0].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[0].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[0].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-
-
-	//fan light 1
-	m_pShaderManager->setVec3Value("pointLights[1].position", 4.0f, 11.5f, -3.0f);
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", .4f, .4f, .4f);
-	m_pShaderManager->setVec3Value("pointLights[1].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[1].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[1].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[1].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
-
-	//fan light 2
-	m_pShaderManager->setVec3Value("pointLights[2].position", 4.0f, 7.25f, -3.0f);
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[2].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[2].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[2].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[2].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);
-
-	//fan light 3
-	m_pShaderManager->setVec3Value("pointLights[3].position", 4.0f, 3.0f, -3.0f);
-	m_pShaderManager->setVec3Value("pointLights[3].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[3].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[3].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[3].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[3].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[3].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[3].bActive", true);
-
-	//fan light 4
-	m_pShaderManager->setVec3Value("pointLights[4].position", -7.0f, 11.5f, 0.5f);
-	m_pShaderManager->setVec3Value("pointLights[4].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[4].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[4].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[4].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[4].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[4].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[4].bActive", true);
-
-	//fan light 5
-	m_pShaderManager->setVec3Value("pointLights[5].position", -3.5f, 13.0f, 0.5f);
-	m_pShaderManager->setVec3Value("pointLights[5].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[5].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[5].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[5].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[5].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[5].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[5].bActive", true);
-
-	//fan light 6
-	m_pShaderManager->setVec3Value("pointLights[6].position", 1.0f, 13.0f, 0.5f);
-	m_pShaderManager->setVec3Value("pointLights[6].ambient", .01f, .01f, .01f);
-	m_pShaderManager->setVec3Value("pointLights[6].diffuse", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("pointLights[6].specular", .0f, .0f, .0f);
-	m_pShaderManager->setFloatValue("pointLights[6].constant", 1.0f);
-	m_pShaderManager->setFloatValue("pointLights[6].linear", 0.09f);
-	m_pShaderManager->setFloatValue("pointLights[6].quadratic", 0.032f);
-	m_pShaderManager->setBoolValue("pointLights[6].bActive", true);
-
-
-
-
-}
-
-/***********************************************************
- *  PrepareScene()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- ***********************************************************/
-void SceneManager::PrepareScene()
-{
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-	LoadSceneTextures();
-
-	DefineObjectMaterials();
-
-	SetupSceneLights();
-
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadTorusMesh();
-	m_basicMeshes->LoadExtraTorusMesh1();
-	m_basicMeshes->LoadExtraTorusMesh2();
-
-}
-
-/***********************************************************
- *  RenderScene()
- *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
- ***********************************************************/
-void SceneManager::RenderScene()
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.	                    ***/
-	/***                                                            ***/
-	/*** Stand for the computer to rest on                          ***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 15.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	
-	//Sets the stands texture
-	SetShaderTexture("stand");
-	SetShaderMaterial("wood");
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-	
-
-
-
-	/****************************************************************/
-
-
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 25.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, -10.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//wall texture
-	SetShaderTexture("wall");
-	
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-
-
-	//My added code//
-	// 
-	// Matrix for fan parts position
-	//(6.0f, 11.5f, -2.5f)
-	//(2.0f, 11.5f, -2.5f)
-	//(4.0f, 9.5f, -2.5f)
-	//(4.0f, 13.5f, -2.5f)
-	//(4.0f, 11.5f, -3.0f)
-	//(2.0f, 13.5f, -3.0f)
-	//(2.0f, 9.5f, -3.0f)
-	//(6.0f, 13.5f, -3.0f)
-	//(6.0f, 9.5f, -3.0f)
-	//(4.0f, 11.5f, -2.1f)
-	//(4.0f, 10.5f, -2.5f)
-	//(4.75f, 12.25f, -2.5f)
-	//(3.25f, 12.25f, -2.5f)
-	// 
-	// 
-	//********************************************//
-	//********************************************//
-	// Computer Fan
-	// (6.0f, 11.5f, -2.5f)
-	// (2.0f, 11.5f, -2.5f)
-	// (4.0f, 9.5f, -2.5f)
-	// (4.0f, 13.5f, -2.5f)
-	// (4.0f, 11.5f, -3.0f)
-	// 
-	
-	//add texture for all parts of the fan
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 11.5f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 11.5f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 9.5f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 13.5f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 11.5f, -3.0f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderMaterial("middle");
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-	
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	//
-	// matrix for position
-	//(2.0f, 13.5f, -3.0f)
-	//(2.0f, 9.5f, -3.0f)
-	//(6.0f, 13.5f, -3.0f)
-	//(6.0f, 9.5f, -3.0f)
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	// 
-	SetShaderMaterial("plastic");
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 13.5f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 9.5f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 13.5f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	 
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 9.5f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	// 
-	// Matrix for position
-	// (4.0f, 11.5f, -2.1f)
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 11.5f, -2.15f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 36.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 72.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 108.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 144.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-
-
-
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	// Matrix for position
-	//(4.0f, 10.5f, -2.5f)
-	//(4.75f, 12.25f, -2.5f)
-	//(3.25f, 12.25f, -2.5f)
-	//
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.45f, 0.75f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 10.5f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -45.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.75f, 12.25f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 45.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.25f, 12.25f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-
-
-
-	// 
-	// Matrix for fan parts position
-	//(6.0f, 7.25f, -2.5f)
-	//(2.0f, 7.25f, -2.5f)
-	//(4.0f, 5.25f, -2.5f)
-	//(4.0f, 9.25f, -2.5f)
-	//(4.0f, 7.25f, -3.0f)
-	//(2.0f, 9.25f, -3.0f)
-	//(2.0f, 5.25f, -3.0f)
-	//(6.0f, 9.25f, -3.0f)
-	//(6.0f, 5.25f, -3.0f)
-	//(4.0f, 7.25f, -2.15f)
-	//(4.0f, 6.25f, -2.5f)
-	//(4.75f, 8.0f, -2.5f)
-	//(3.25f, 8.0f, -2.5f)
-	// 
-	// 
-	//********************************************//
-	//********************************************//
-	// Computer Fan
-	// (6.0f, 11.5f, -2.5f)
-	// (2.0f, 11.5f, -2.5f)
-	// (4.0f, 9.5f, -2.5f)
-	// (4.0f, 13.5f, -2.5f)
-	// (4.0f, 11.5f, -3.0f)
-	// 
-
-	//add texture for all parts of the fan
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 7.25f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 7.25f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 5.25f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 9.25f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 7.25f, -3.0f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	//
-	// matrix for position
-	//(2.0f, 13.5f, -3.0f)
-	//(2.0f, 9.5f, -3.0f)
-	//(6.0f, 13.5f, -3.0f)
-	//(6.0f, 9.5f, -3.0f)
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 9.25f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 5.25f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 9.25f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 5.25f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	// 
-	// Matrix for position
-	// (4.0f, 11.5f, -2.15f)
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 7.25f, -2.15f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 36.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 72.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 108.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 144.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-
-
-
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	// Matrix for position
-	//(4.0f, 10.5f, -2.5f)
-	//(4.75f, 12.25f, -2.5f)
-	//(3.25f, 12.25f, -2.5f)
-	//
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.45f, 0.75f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 6.25f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -45.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.75f, 8.0f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 45.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.25f, 8.0f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-
-	// 
-	// Matrix for fan parts position
-	//(6.0f, 3.0f, -2.5f)
-	//(2.0f, 3.0f, -2.5f)
-	//(4.0f, 1.0f, -2.5f)
-	//(4.0f, 5.0f, -2.5f)
-	//(4.0f, 3.0f, -3.0f)
-	//(2.0f, 5.0f, -3.0f)
-	//(2.0f, 1.0f, -3.0f)
-	//(6.0f, 5.0f, -3.0f)
-	//(6.0f, 1.0f, -3.0f)
-	//(4.0f, 3.0f, -2.15f)
-	//(4.0f, 2.0f, -2.5f)
-	//(4.75f, 3.75f, -2.5f)
-	//(3.25f, 3.75f, -2.5f)
-	// 
-	// 
-	//********************************************//
-	//********************************************//
-	// Computer Fan
-	// 
-	// 
-
-	//add texture for all parts of the fan
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 3.0f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 3.0f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 1.0f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 5.0f, -2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 3.0f, -3.0f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 5.0f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(2.0f, 1.0f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 5.0f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 1.0f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 3.0f, -2.15f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 36.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 72.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(4.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 108.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(5.0f, 0.1f, 0.25f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 144.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.45f, 0.75f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 2.0f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -45.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.75f, 3.75f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 45.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.25f, 3.75f, -2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-		// Matrix for fan parts position
-	//(-6.5f, 11.5f, -1.5f)
-	//(-6.5f, 11.5f, 2.5f)
-	//(-6.5f, 9.5f, 0.5f)
-	//(-6.5f, 13.5f, 0.5f)
-	//(-7.0f, 11.5f, 0.5f)
-	//(-7.0f, 13.5f, 2.5f)
-	//(-7.0f, 9.5f, 2.5f)
-	//(-7.0f, 13.5f, -1.5f)
-	//(-7.0f, 9.5f, -1.5f)
-	//(-6.15f, 11.5f, 0.5f)
-	//(-6.5f, 10.5f, 0.5f)
-	//(-6.5f, 12.25f, -0.25f)
-	//(-6.5, 12.25f, 1.25f)
-	// 
-
-
-
-
-
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 11.5f, -1.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 11.5f, 2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 9.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 13.5f, 0.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 11.5f, 0.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	//
-	// matrix for position
-	//(2.0f, 13.5f, -3.0f)
-	//(2.0f, 9.5f, -3.0f)
-	//(6.0f, 13.5f, -3.0f)
-	//(6.0f, 9.5f, -3.0f)
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 13.5f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 9.5f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 13.5f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 9.5f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	// 
-	// Matrix for position
-	//(-6.15f, 11.5f, 0.5f)
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(0.25f, 0.1f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.15f, 11.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.25f, 0.1f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 36.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.25f, 0.1f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 72.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.25f, 0.1f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 108.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.25f, 0.1f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 144.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-
-
-
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	// Matrix for position
-	//(-6.5f, 10.5f, 0.5f)
-	//(-6.5f, 12.25f, -0.25f)
-	//(-6.5, 12.25f, 1.25f)
-	//
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.1f, 0.75f, 0.45f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 10.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = -45.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5f, 12.25f, -0.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.5, 12.25f, 1.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-
-
-
-
-
-	//********************************************//
-
-		// Matrix for fan parts position
-	//(-3.5f, 13.5f, -1.5f)
-	//(-3.5f, 13.5f, 2.5f)
-	//(-1.5f, 13.5f, 0.5f)
-	//(-5.5f, 13.5f, 0.5f)
-	//(-3.5f, 13.0f, 0.5f)
-	//(-5.5f, 13.0f, 2.5f)
-	//(-1.5f, 13.0f, 2.5f)
-	//(-5.5f, 13.0f, -1.5f)
-	//(-1.5f, 13.0f, -1.5f)
-	//(-3.5f, 13.15f, 0.5f)
-	//(-4.5f, 13.5f, 0.5f)
-	//(-3.0f, 13.5f, 1.25f)
-	//(-3.0, 13.5f, -0.25f)
-	// 
-
-
-
-
-
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.5f, 13.5f, -1.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.5f, 13.5f, 2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.5f, 13.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-5.5f, 13.5f, 0.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.5f, 13.0f, 0.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	//
-	// matrix for position
-	//(-5.5f, 13.0f, 2.5f)
-	//(-1.5f, 13.0f, 2.5f)
-	//(-5.5f, 13.0f, -1.5f)
-	//(-1.5f, 13.0f, -1.5f)
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-5.5f, 13.0f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.5f, 13.0f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-5.5f, 13.0f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.5f, 13.0f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	// 
-	// Matrix for position
-	//(-3.5f, 13.15f, 0.5f)
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.5f, 13.15f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 36.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 72.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 108.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 144.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	// Matrix for position
-	//(-4.5f, 13.5f, 0.5f)
-	//(-3.0f, 13.5f, 1.25f)
-	//(-3.0, 13.5f, -0.25f)
-	//
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.75f, 0.1f, 0.45f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-4.5f, 13.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = -45.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 13.5f, 1.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 45.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0, 13.5f, -0.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-
-
-
-	// Matrix for fan parts position
-	//(1.0f, 13.5f, 2.5f)
-	//(1.0f, 13.5f, -1.5f)
-	//(3.0f, 13.5f, 0.5f)
-	//(-1.0f, 13.5f, 0.5f)
-	//(1.0f, 13.0f, 0.5f)
-	//(-5.5f, 13.0f, 2.5f)
-	//(-1.5f, 13.0f, 2.5f)
-	//(-5.5f, 13.0f, -1.5f)
-	//(-1.5f, 13.0f, -1.5f)
-	//(-3.5f, 13.15f, 0.5f)
-	//(-4.5f, 13.5f, 0.5f)
-	//(-3.0f, 13.5f, 1.25f)
-	//(-3.0, 13.5f, -0.25f)
-	// 
-
-
-
-
-
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-
-
-	//Set the scale for all four sides
-	scaleXYZ = glm::vec3(0.25f, 4.0f, 1.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.0f, 13.5f, 2.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.0f, 13.5f, -1.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-	//Draw the mesh
-
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.0f, 13.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.0f, 13.5f, 0.5f);
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//*****************************//
-	//Middle Cylinder of the fan
-	//Set the scale
-	scaleXYZ = glm::vec3(0.65f, 1.0f, 0.65f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.0f, 13.0f, 0.5f); 
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//********************************************//
-
-
-
-	//********************************************//
-	//********************************************//
-	//Corner Cylinders
-	//
-	// matrix for position
-	//(-1.0f, 13.0f, 2.5f)
-	//(3.0f, 13.0f, 2.5f)
-	//(-1.0f, 13.0f, -1.5f)
-	//(3.0f, 13.0f, -1.5f)
-	// 
-	// 
-	//
-	//****** Top Left ******//
-	//Set the scale
-	scaleXYZ = glm::vec3(0.13f, 1.0f, 0.13f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.0f, 13.0f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Bottom left corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.0f, 13.0f, 2.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//****** Top Right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.0f, 13.0f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//****** Bottom right corner ******//
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.0f, 13.0f, -1.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//********************************************//
-	//********************************************//
-	//Supports
-	// 
-	// Matrix for position
-	//(1.0f, 13.15f, 0.5f)
-	//
-	// 
-	// 
-	// 
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.0f, 13.15f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 36.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 72.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 108.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 0.25f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 144.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//********************************************//
-
-	//********************************************//
-	//********************************************//
-	//Fan blades
-	// 
-	// Matrix for position
-	//(0.0f, 13.5f, 0.5f)
-	//(1.5f, 13.5f, 1.25f)
-	//(1.5, 13.5f, -0.25f)
-	//
-	//
-	SetShaderTexture("blade");
-	//Set the scale
-	scaleXYZ = glm::vec3(.75f, 0.1f, 0.45f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.0f, 13.5f, 0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = -45.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.5f, 13.5f, 1.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 45.0f;
-	ZrotationDegrees = 0.0f;
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.5, 13.5f, -0.25f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-	//********************************************//
-
-
-
-
-
-
-	//**************Case************//
-	//Matrix for position//
-	//(0.0f, 7.5f, -3.0f)
-	//(0.0f, 14.0f, 0.0f)
-	//(-7.0f, 7.5f, 0.0f)
-	//(0.0f, 1.0f, 0.0f)
-	//(-6.0f, 0.75f, 2.9f)
-	//(6.0f, 0.75f, 2.9f)
-	//(6.0f, 0.75f, -2.9f)
-	//(-6.0f, 0.75f, -2.9f)
-	// 
-	// 
-	// 
-	// Set shader texture for case
-	SetShaderTexture("blackPlastic");
-	//Set the scale
-	scaleXYZ = glm::vec3(14.0f, 13.0f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.0f, 7.5f, -3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 0.1, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(14.0f, 0.1f, 6.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.0f, 14.0f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 0.1, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 13.0f, 6.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-7.0f, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 0.1, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-	
-	//Set the scale
-	scaleXYZ = glm::vec3(14.0f, 0.1f, 6.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.0f, 1.0f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 0.1, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(1.5f, 0.5f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.0f, 0.75f, 2.9f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(1.5f, 0.5f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 0.75f, 2.9f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(1.5f, 0.5f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(6.0f, 0.75f, -2.9f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(1.5f, 0.5f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-6.0f, 0.75f, -2.9f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(8.5f, 3.0f, 5.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-2.7f, 2.5f, -0.5f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-
-
-
-	//***********MotherBoard*********//
-
-	SetShaderTexture("chip");
-	SetShaderMaterial("mother");
-	//Set the scale
-	scaleXYZ = glm::vec3(8.0f, 9.0f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-2.5f, 9.0f, -2.8f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//*****************************************************//
-
-
-
-	//*******GPU*************//
-
-
-
-	SetShaderTexture("gpu");
-	SetShaderMaterial("plastic");
-	//Set the scale
-	scaleXYZ = glm::vec3(8.5f, 1.5f, 3.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-2.75f, 6.0f, -1.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-
-	//*********************************************//
-
-	//**********RAM*******************//
-
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-	//Set the scale
-	scaleXYZ = glm::vec3(.3f, 4.0f, 1.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-0.5f, 9.0f, -2.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.5f, 9.0f, -2.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.1, 1.0, 0.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(.3f, 4.0f, 0.3f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-0.5f, 9.0f, -1.1f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(1.0, 1.0, 1.0, 1.0);
-	//SetShaderMaterial("plastic");
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.5f, 9.0f, -1.1f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(1.1, 1.1, 1.1, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//************CPU fan**********//
-
-	
-	//Set scale
-	scaleXYZ = glm::vec3(0.85f, 2.0f, 0.85f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 9.5f, -2.75f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.01, 0.01, 0.01, 1.0);
-	//SetShaderMaterial("plastic");
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.40f, 2.0f, 0.40f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 9.5f, -2.55f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.01, 0.01, 0.01, 1.0);
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(1.0f, 1.0f, 4.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 9.5f, -1.75f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.01, 0.01, 0.01, 1.0);
-	SetShaderTexture("blackPlastic");
-	SetShaderMaterial("plastic");
-	//Draw the mesh
-	m_basicMeshes->DrawTorusMesh();
-
-	///**********Middle bars of CPU**************///
-
-	//Set scale
-	scaleXYZ = glm::vec3(1.75f, .02f, 0.2f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 9.5f, -0.75f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1.0, .5, 0.5, 1.0);
-	SetShaderTexture("blade");
-	//SetShaderMaterial("plastic");
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 10.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 20.0f;
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 30.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 40.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 50.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 60.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 70.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 80.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 100.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 110.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 120.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 130.0f;
-
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 140.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 150.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 160.0f;
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 170.0f;
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	m_basicMeshes->DrawBoxMesh();
-
-	//***************************//
-
-	//***************cooling tube************************//
-
-	
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 1.0f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 7.5f, -2.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.01, 0.01, 0.01, 1.0);
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 1.0f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 40.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 7.5f, -2.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 0.5f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 40.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-3.0f, 7.5f, -2.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 1.75f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 40.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-2.4f, 7.5f, -1.3f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 2.90f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 90.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.4, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 0.5f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(-1.33f, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 1.0f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 13.0f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 3.0f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 10.0f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 1.0f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(3.2f, 9.25f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 0.5f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(4.0f, 10.0f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 2.75f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 45.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.45f, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	
-	//Set scale
-	scaleXYZ = glm::vec3(0.5f, 0.5f, 0.5f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(1.45f, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//Draw the mesh
-	m_basicMeshes->DrawSphereMesh();
-
-
-
-
-
-	//********************Glass panels********************//
-	//*******************MUST BE LAST*******************//
-
-	//Set scale
-	scaleXYZ = glm::vec3(14.0f, 13.0f, 0.1f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(0.0f, 7.5f, 3.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.1, 0.1, 0.1, 0.2);
-	SetShaderMaterial("glass");
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-	//Set the scale
-	scaleXYZ = glm::vec3(0.1f, 13.0f, 6.0f);
-
-	//Set the XYZ rotation
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-
-	//Set the XYZposition
-	positionXYZ = glm::vec3(7.0f, 7.5f, 0.0f);
-
-
-	//Set the transformation into memory
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.1, 0.1, 0.1, 0.2);
-	SetShaderMaterial("glass");
-	//Draw the mesh
-	m_basicMeshes->DrawBoxMesh();
-
-
-
-}
-
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.cpp
+// ================
+// This file contains the implementation of the `SceneManager` class, which is 
+// responsible for managing the preparation and rendering of 3D scenes. It 
+// handles textures, materials, lighting configurations, and object rendering.
+//
+// AUTHOR: Brian Battersby
+// INSTITUTION: Southern New Hampshire University (SNHU)
+// COURSE: CS-330 Computational Graphics and Visualization
+//
+// INITIAL VERSION: November 1, 2023
+// LAST REVISED: December 1, 2024
+//
+// RESPONSIBILITIES:
+// - Load, bind, and manage textures in OpenGL.
+// - Define materials and lighting properties for 3D objects.
+// - Manage transformations and shader configurations.
+// - Render complex 3D scenes using basic meshes.
+//
+// NOTE: This implementation leverages external libraries like `stb_image` for 
+// texture loading and GLM for matrix and vector operations.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// declaration of global variables
+namespace
+{
+	// strings rather than literals, so setting a uniform by name
+	// does not build a temporary string for the location lookup
+	const std::string g_ModelName = "model";
+	const std::string g_ColorValueName = "objectColor";
+	const std::string g_TextureArraysName = "textureArrays";
+	const std::string g_TextureArrayName = "textureArray";
+	const std::string g_TextureLayerName = "textureLayer";
+	const std::string g_UseTextureName = "bUseTexture";
+	const std::string g_BlendTextureArrayName = "blendTextureArray";
+	const std::string g_BlendTextureLayerName = "blendTextureLayer";
+	const std::string g_BlendFactorName = "blendFactor";
+	const std::string g_UseLightingName = "bUseLighting";
+	const std::string g_UseInstancingName = "bUseInstancing";
+	const std::string g_UseInstanceMaterialsName = "bUseInstanceMaterials";
+	const std::string g_MaterialIndexName = "materialIndex";
+	const std::string g_UseLightClustersName = "bUseLightClusters";
+	const std::string g_ClusterGridName = "clusterLightGrid";
+	const std::string g_ClusterIndicesName = "clusterLightIndices";
+	const std::string g_PointLightDataName = "pointLightData";
+	const std::string g_MaterialDataName = "materialData";
+
+	// attenuated light below this fraction of full brightness
+	// is treated as out of reach
+	const float g_LightCutoff = 5.0f / 256.0f;
+
+	// smallest projected diameter in pixels of each level of
+	// detail but the last, and how far past a limit the size
+	// has to go before the level changes
+	const float g_LodScreenSizes[MESH_LOD_LEVELS - 1] = { 96.0f, 24.0f };
+	const float g_LodHysteresis = 0.2f;
+
+	// commands of each GPU bucket, the box and then every level
+	// of the cylinder and of the sphere
+	const int g_BucketCommands = 1 + (2 * MESH_LOD_LEVELS);
+	// occlusion group of the objects outside of every group
+	const GLuint g_NoOcclusionGroup = 0xFFFFFFFFu;
+
+	// shader features of the untextured, textured and texture
+	// blended scene nodes
+	const int g_NodeFeatureSets[3] = { 0, SHADER_TEXTURED, SHADER_TEXTURED | SHADER_TEXTURE_BLEND };
+
+	// scene nodes handled by one job of the parallel loops, large
+	// enough that a job outweighs the cost of handing it out
+	const int g_NodesPerJob = 1024;
+
+	// scratch memory that each frame starts with, and the frames
+	// whose memory is kept, the current one and the one before
+	const size_t g_FrameArenaBytes = 1024 * 1024;
+	const int g_FrameArenaFrames = 2;
+
+	// most mesh nodes of a generated stress scene
+	const int g_MaxStressObjects = 100000;
+	// distance between the computers of the stress scene grid
+	const float g_StressSpacingX = 18.0f;
+	const float g_StressSpacingZ = 12.0f;
+	// seed of the stress scene light placement, so every run
+	// lights the scene the same way
+	const uint32_t g_StressLightSeed = 0x9E3779B9u;
+
+	// time between two polls of the hot reloaded files
+	const int g_HotReloadCheckMilliseconds = 250;
+
+	/***********************************************************
+	 *  NextRandom()
+	 *
+	 *  Returns the next value of a xorshift generator between
+	 *  0 and 1.  The same seed always gives the same sequence.
+	 ***********************************************************/
+	float NextRandom(uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		return((float)(state >> 8) / 16777216.0f);
+	}
+
+	/***********************************************************
+	 *  CalculateLightRadius()
+	 *
+	 *  Returns the distance where the attenuation brings the
+	 *  brightest color channel of a light down to the cutoff.
+	 ***********************************************************/
+	float CalculateLightRadius(
+		glm::vec3 intensity,
+		float constant,
+		float linear,
+		float quadratic)
+	{
+		float maxIntensity = std::max(std::max(intensity.r, intensity.g), intensity.b);
+		// solve constant + linear * d + quadratic * d^2 = maxIntensity / cutoff
+		float target = maxIntensity / g_LightCutoff - constant;
+
+		if (target <= 0.0f)
+		{
+			return(0.0f);
+		}
+		if (quadratic > 0.0f)
+		{
+			return((-linear + std::sqrt(linear * linear + 4.0f * quadratic * target)) / (2.0f * quadratic));
+		}
+		if (linear > 0.0f)
+		{
+			return(target / linear);
+		}
+
+		// lights without attenuation reach everything
+		return(std::numeric_limits<float>::max());
+	}
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager, ShaderUniforms* pShaderUniforms)
+{
+	m_pShaderManager = pShaderManager;
+	m_pShaderUniforms = pShaderUniforms;
+	m_pShaderVariants = NULL;
+	m_pFrameProfiler = NULL;
+	m_basicMeshes = new ShapeMeshes();
+	m_instancedMeshes = new InstancedMeshes();
+	m_staticBatches = new StaticBatches();
+	m_textureManager = new TextureManager();
+	m_textureLoader = new TextureLoader(m_textureManager, 0);
+	m_lightClusters = new LightClusters();
+	m_jobPool = new JobPool(0);
+	m_frameArena = new FrameArena(g_FrameArenaBytes, g_FrameArenaFrames);
+	m_bUseLightClusters = true;
+	m_bUseLighting = false;
+	m_bTransformsDirty = false;
+	m_bUseStaticBatching = true;
+	m_bStaticBatchesDirty = false;
+	m_textureAlphaChanges = 0;
+	m_bUseInstancing = true;
+	m_bUseMultiDraw = true;
+	m_gpuCuller = NULL;
+	m_bUseGpuCulling = true;
+	m_bGpuObjectsDirty = true;
+	m_bInstanceTransformsDirty = false;
+	m_bUseFrustumCulling = true;
+	m_bBoundsDirty = true;
+	m_bUseOcclusionCulling = true;
+	m_bUseLevelOfDetail = true;
+	m_culledObjectCount = 0;
+	m_occludedObjectCount = 0;
+	m_reportedCulledCount = -1;
+	m_reportedOccludedCount = -1;
+	m_bLightsDirty = false;
+	m_lightBlock = {};
+	m_stressObjectCount = 0;
+	m_stressLightCount = 0;
+	m_bUseSceneFile = false;
+	m_fileWatcher = NULL;
+
+	// default surface state for newly added scene nodes
+	m_nodeState.mesh = MESH_BOX;
+	m_nodeState.parentIndex = -1;
+	m_nodeState.textureSlot = -1;
+	m_nodeState.blendTextureSlot = -1;
+	m_nodeState.blendFactor = 0.0f;
+	m_nodeState.color = glm::vec4(1.0f);
+	m_nodeState.materialIndex = -1;
+	m_nodeState.bStatic = true;
+	m_nodeState.staticBatch = -1;
+	m_nodeState.lodLevel = 0;
+
+	m_usedFeatureSets = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		m_nodeShaders[i] = 0;
+	}
+
+	ResetDrawState();
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	m_pShaderManager = NULL;
+	m_pShaderUniforms = NULL;
+	m_pShaderVariants = NULL;
+	m_pFrameProfiler = NULL;
+	delete m_basicMeshes;
+	m_basicMeshes = NULL;
+	delete m_instancedMeshes;
+	m_instancedMeshes = NULL;
+	delete m_staticBatches;
+	m_staticBatches = NULL;
+	delete m_lightClusters;
+	m_lightClusters = NULL;
+	delete m_jobPool;
+	m_jobPool = NULL;
+	delete m_frameArena;
+	m_frameArena = NULL;
+	delete m_textureLoader;
+	m_textureLoader = NULL;
+	delete m_textureManager;
+	m_textureManager = NULL;
+	delete m_fileWatcher;
+	m_fileWatcher = NULL;
+	delete m_gpuCuller;
+	m_gpuCuller = NULL;
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files
+ *  into the next available texture slot.  There is no limit
+ *  on the number of slots.  The slot shows a placeholder
+ *  until the texture loader has decoded the image on a worker
+ *  thread and it has been copied into its array texture.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, const std::string& tag)
+{
+	TEXTURE_INFO textureInfo;
+
+	// register the texture and associate it with the special tag string
+	if (m_textureTags.Register(tag) == TagRegistry::INVALID_HANDLE)
+	{
+		std::cout << "Texture tag is already loaded:" << tag << std::endl;
+		return(false);
+	}
+	textureInfo.ID = (uint32_t)m_textureManager->CreateTexture();
+	textureInfo.tag = tag;
+	textureInfo.filename = filename;
+	m_textureIDs.push_back(textureInfo);
+
+	m_textureLoader->QueueTexture(filename, (int)textureInfo.ID);
+	if (NULL != m_fileWatcher)
+	{
+		m_fileWatcher->WatchFile(filename);
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the array textures to
+ *  their texture units.  Draws then select a texture by its
+ *  array and layer, without binding anything.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	m_textureManager->BindTextureArrays();
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots and forgetting their tags.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	m_textureManager->DestroyTextures();
+	m_textureIDs.clear();
+	m_textureTags.Clear();
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag,
+ *  or -1 if no texture has been loaded with that tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const std::string& tag) const
+{
+	int textureSlot = FindTextureSlot(tag);
+
+	if (textureSlot < 0)
+	{
+		return(-1);
+	}
+
+	return((int)m_textureIDs[textureSlot].ID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag,
+ *  or -1 if no texture has been loaded with that tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const std::string& tag) const
+{
+	return(m_textureTags.Find(tag));
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method is used for adding a material to the defined
+ *  materials list and returning its handle, or -1 if a
+ *  material has already been defined with the same tag or
+ *  the material buffer of the shader is full.
+ ***********************************************************/
+int SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	if ((int)m_objectMaterials.size() >= MAX_MATERIALS)
+	{
+		std::cout << "Could not add object material, only " << MAX_MATERIALS << " materials are supported by the shader:" << material.tag << std::endl;
+		return(-1);
+	}
+
+	int materialIndex = m_materialTags.Register(material.tag);
+
+	if (materialIndex == TagRegistry::INVALID_HANDLE)
+	{
+		std::cout << "Object material is already defined:" << material.tag << std::endl;
+		return(-1);
+	}
+	m_objectMaterials.push_back(material);
+
+	return(materialIndex);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ *  False is returned when no material has that tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material) const
+{
+	int materialIndex = FindMaterialIndex(tag);
+
+	if (materialIndex < 0)
+	{
+		return(false);
+	}
+
+	material.diffuseColor = m_objectMaterials[materialIndex].diffuseColor;
+	material.specularColor = m_objectMaterials[materialIndex].specularColor;
+	material.shininess = m_objectMaterials[materialIndex].shininess;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the index of the previously
+ *  defined material that is associated with the passed in tag,
+ *  or -1 if no material has been defined with that tag.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag) const
+{
+	return(m_materialTags.Find(tag));
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+
+	modelView = ComposeTransformations(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+	}
+}
+
+/***********************************************************
+ *  ComposeTransformations()
+ *
+ *  This method is used for building the model matrix from
+ *  the passed in transformation values.
+ ***********************************************************/
+glm::mat4 SceneManager::ComposeTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// the closed form gives translation * Rz * Ry * Rx * scale
+	// without building and multiplying the five matrices
+	return(TransformSystem::ComposeMatrix(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ));
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, false);
+		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+
+		// ensure no leftover texture blending affects this draw
+		m_pShaderManager->setFloatValue(g_BlendFactorName, 0.0f);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in ID into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	const std::string& textureTag)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, true);
+
+		TextureManager::TEXTURE_LOCATION location = m_textureManager->GetTextureLocation(FindTextureSlot(textureTag));
+		m_pShaderManager->setIntValue(g_TextureArrayName, location.arrayIndex);
+		m_pShaderManager->setIntValue(g_TextureLayerName, location.layer);
+
+		// neutralize any prior two-texture blend
+		m_pShaderManager->setFloatValue(g_BlendFactorName, 0.0f);
+	}
+}
+
+
+/***********************************************************
+ *  SetShaderTextures()
+ *
+ *  This method is used for setting two textures into the
+ *  shader for the next draw command.  The second texture is
+ *  mixed over the first one by the passed in blend factor.
+ ***********************************************************/
+void SceneManager::SetShaderTextures(
+	const std::string& textureTag,
+	const std::string& textureTag2,
+	float blendFactor)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, true);
+
+		TextureManager::TEXTURE_LOCATION location = m_textureManager->GetTextureLocation(FindTextureSlot(textureTag));
+		TextureManager::TEXTURE_LOCATION blendLocation = m_textureManager->GetTextureLocation(FindTextureSlot(textureTag2));
+
+		m_pShaderManager->setIntValue(g_TextureArrayName, location.arrayIndex);
+		m_pShaderManager->setIntValue(g_TextureLayerName, location.layer);
+		m_pShaderManager->setIntValue(g_BlendTextureArrayName, blendLocation.arrayIndex);
+		m_pShaderManager->setIntValue(g_BlendTextureLayerName, blendLocation.layer);
+		m_pShaderManager->setFloatValue(g_BlendFactorName, blendFactor);
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for passing the material values
+ *  into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	const std::string& materialTag)
+{
+	int materialIndex = FindMaterialIndex(materialTag);
+
+	if (materialIndex < 0)
+	{
+		std::cout << "Could not find object material:" << materialTag << std::endl;
+		return;
+	}
+
+	SetShaderMaterial(materialIndex);
+}
+
+/***********************************************************
+ *  SetShaderTextureSlot()
+ *
+ *  This method is used for setting the array and layer of an
+ *  already resolved texture slot into the shader, skipping
+ *  the tag lookup.
+ ***********************************************************/
+void SceneManager::SetShaderTextureSlot(int textureSlot)
+{
+	if (NULL != m_pShaderUniforms)
+	{
+		TextureManager::TEXTURE_LOCATION location = m_textureManager->GetTextureLocation(textureSlot);
+
+		m_pShaderUniforms->SetIntValue(g_TextureArrayName, location.arrayIndex);
+		m_pShaderUniforms->SetIntValue(g_TextureLayerName, location.layer);
+	}
+}
+
+/***********************************************************
+ *  SetShaderBlendTextureSlot()
+ *
+ *  This method is used for setting the array and layer of
+ *  the texture that is mixed over the first one.
+ ***********************************************************/
+void SceneManager::SetShaderBlendTextureSlot(int textureSlot)
+{
+	if (NULL != m_pShaderUniforms)
+	{
+		TextureManager::TEXTURE_LOCATION location = m_textureManager->GetTextureLocation(textureSlot);
+
+		m_pShaderUniforms->SetIntValue(g_BlendTextureArrayName, location.arrayIndex);
+		m_pShaderUniforms->SetIntValue(g_BlendTextureLayerName, location.layer);
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for selecting an already resolved
+ *  material in the shader.  The material values themselves
+ *  are uploaded once into the material buffer.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	int materialIndex)
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+	if ((materialIndex < 0) || (materialIndex >= (int)m_objectMaterials.size()))
+	{
+		std::cout << "Could not set object material, the material handle is not defined:" << materialIndex << std::endl;
+		return;
+	}
+
+	m_pShaderUniforms->SetIntValue(g_MaterialIndexName, materialIndex);
+}
+
+/***********************************************************
+ *  UploadMaterials()
+ *
+ *  This method is used for copying the defined object
+ *  materials into the material buffer of the shader, one
+ *  entry per material handle.
+ ***********************************************************/
+void SceneManager::UploadMaterials()
+{
+	std::vector<ShaderUniforms::MATERIAL> materials(m_objectMaterials.size());
+
+	for (int i = 0; i < (int)m_objectMaterials.size(); i++)
+	{
+		materials[i].diffuseColor = m_objectMaterials[i].diffuseColor;
+		materials[i].specularColor = m_objectMaterials[i].specularColor;
+		materials[i].shininess = m_objectMaterials[i].shininess;
+		materials[i].padding = 0.0f;
+	}
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetMaterials(materials);
+	}
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light to the scene
+ *  light list and returning its index.  The distance where
+ *  the attenuated light stops making a visible difference is
+ *  worked out here so the shader can skip lights that are
+ *  out of reach of a fragment.
+ ***********************************************************/
+int SceneManager::AddPointLight(
+	glm::vec3 position,
+	glm::vec3 ambient,
+	glm::vec3 diffuse,
+	glm::vec3 specular,
+	float constant,
+	float linear,
+	float quadratic)
+{
+	ShaderUniforms::POINT_LIGHT light;
+
+	if ((int)m_pointLights.size() >= MAX_POINT_LIGHTS)
+	{
+		std::cout << "Only " << MAX_POINT_LIGHTS << " point lights are supported by the shader" << std::endl;
+		return(-1);
+	}
+
+	light.position = position;
+	light.ambient = ambient;
+	light.diffuse = diffuse;
+	light.specular = specular;
+	light.constant = constant;
+	light.linear = linear;
+	light.quadratic = quadratic;
+	light.radius = CalculateLightRadius(ambient + diffuse + specular, constant, linear, quadratic);
+
+	m_pointLights.push_back(light);
+	m_bLightsDirty = true;
+
+	return((int)m_pointLights.size() - 1);
+}
+
+/***********************************************************
+ *  UploadSceneLights()
+ *
+ *  This method is used for copying the scene light list into
+ *  the point light buffer and the light count into the light
+ *  block of the shader.
+ ***********************************************************/
+void SceneManager::UploadSceneLights()
+{
+	m_lightBlock.pointLightCount = (int)m_pointLights.size();
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetPointLights(m_pointLights);
+		m_pShaderUniforms->SetLightBlock(m_lightBlock);
+	}
+	m_bLightsDirty = false;
+}
+
+/***********************************************************
+ *  UpdateLightClusters()
+ *
+ *  This method is used for binning the point lights into the
+ *  clusters of the camera view that was set for this frame
+ *  and making the cluster light lists available to the
+ *  fragment shader.
+ ***********************************************************/
+void SceneManager::UpdateLightClusters()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	// the point lights and the materials are read from their buffers
+	// with or without clusters
+	m_pShaderUniforms->BindPointLightTexture();
+	m_pShaderUniforms->BindMaterialTexture();
+	m_pShaderUniforms->SetBoolValue(g_UseLightClustersName, m_bUseLightClusters);
+	if (m_bUseLightClusters == false)
+	{
+		return;
+	}
+
+	const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+
+	m_lightClusters->BuildClusters(
+		camera.view,
+		camera.projection,
+		camera.nearPlane,
+		camera.farPlane,
+		m_pointLights,
+		m_frameArena);
+	m_lightClusters->UploadClusters();
+	m_lightClusters->BindClusterTextures();
+}
+
+/***********************************************************
+ *  SetNodeTexture()
+ *
+ *  This method is used for setting the texture that the
+ *  next added scene nodes will be drawn with.  The tag is
+ *  resolved to a texture slot once here instead of per draw.
+ ***********************************************************/
+void SceneManager::SetNodeTexture(
+	const std::string& textureTag)
+{
+	m_nodeState.textureSlot = FindTextureSlot(textureTag);
+	m_nodeState.blendTextureSlot = -1;
+	m_nodeState.blendFactor = 0.0f;
+	if (m_nodeState.textureSlot < 0)
+	{
+		std::cout << "Scene node texture not found:" << textureTag << std::endl;
+	}
+}
+
+/***********************************************************
+ *  SetNodeTextures()
+ *
+ *  This method is used for setting two textures that the
+ *  next added scene nodes will be drawn with, the second
+ *  one mixed over the first by the blend factor.  A layered
+ *  surface is then a single mesh instead of stacked copies.
+ ***********************************************************/
+void SceneManager::SetNodeTextures(
+	const std::string& textureTag,
+	const std::string& textureTag2,
+	float blendFactor)
+{
+	SetNodeTexture(textureTag);
+
+	m_nodeState.blendTextureSlot = FindTextureSlot(textureTag2);
+	if (m_nodeState.blendTextureSlot < 0)
+	{
+		std::cout << "Scene node texture not found:" << textureTag2 << std::endl;
+		return;
+	}
+	m_nodeState.blendFactor = blendFactor;
+}
+
+/***********************************************************
+ *  SetNodeColor()
+ *
+ *  This method is used for setting the solid color that the
+ *  next added scene nodes will be drawn with.
+ ***********************************************************/
+void SceneManager::SetNodeColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	m_nodeState.textureSlot = -1;
+	m_nodeState.blendTextureSlot = -1;
+	m_nodeState.blendFactor = 0.0f;
+	m_nodeState.color = glm::vec4(redColorValue, greenColorValue, blueColorValue, alphaValue);
+}
+
+/***********************************************************
+ *  SetNodeMaterial()
+ *
+ *  This method is used for setting the material that the
+ *  next added scene nodes will be drawn with.  The tag is
+ *  resolved to a material index once here instead of per draw.
+ ***********************************************************/
+void SceneManager::SetNodeMaterial(
+	const std::string& materialTag)
+{
+	m_nodeState.materialIndex = FindMaterialIndex(materialTag);
+	if (m_nodeState.materialIndex < 0)
+	{
+		std::cout << "Scene node material not found:" << materialTag << std::endl;
+	}
+}
+
+/***********************************************************
+ *  AddSceneNode()
+ *
+ *  This method is used for adding a mesh to the retained
+ *  scene as a child of the current parent node.  The
+ *  transformation is stored for the next batched update of
+ *  the world matrices and the current node texture/color and
+ *  material are captured.  MESH_NONE adds a group node that
+ *  only carries a transformation.
+ ***********************************************************/
+int SceneManager::AddSceneNode(
+	MESH_TYPE mesh,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	SCENE_NODE node = m_nodeState;
+
+	node.mesh = mesh;
+	if (mesh != MESH_NONE)
+	{
+		m_usedFeatureSets |= 1 << GetNodeFeatureSet(node);
+	}
+	m_transforms.AddTransform(
+		node.parentIndex,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	m_bTransformsDirty = true;
+
+	m_sceneNodes.push_back(node);
+
+	return((int)m_sceneNodes.size() - 1);
+}
+
+/***********************************************************
+ *  SetNodeTransformations()
+ *
+ *  This method is used for changing the local transformation
+ *  of a scene node.  The world matrices of the node and its
+ *  children are updated before the next frame is drawn.
+ ***********************************************************/
+void SceneManager::SetNodeTransformations(
+	int nodeIndex,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if ((nodeIndex < 0) || (nodeIndex >= (int)m_sceneNodes.size()))
+	{
+		return;
+	}
+
+	m_transforms.SetTransform(
+		nodeIndex,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	m_bTransformsDirty = true;
+
+	// the baked vertices of a static node are out of date now
+	if (m_sceneNodes[nodeIndex].bStatic == true)
+	{
+		m_bStaticBatchesDirty = true;
+	}
+}
+
+/***********************************************************
+ *  UpdateSceneTransforms()
+ *
+ *  This method is used for recalculating the world matrices
+ *  of added and moved scene nodes and everything below them.
+ *  Only the changed local matrices are composed, in batches.
+ ***********************************************************/
+void SceneManager::UpdateSceneTransforms()
+{
+	if (m_bTransformsDirty == false)
+	{
+		return;
+	}
+
+	m_transforms.UpdateTransforms();
+	m_bTransformsDirty = false;
+
+	// the instance buffer and the bounding boxes follow the
+	// world matrices
+	m_bInstanceTransformsDirty = true;
+	m_bGpuObjectsDirty = true;
+	m_bBoundsDirty = true;
+}
+
+/***********************************************************
+ *  DrawSceneNode()
+ *
+ *  This method is used for setting the world matrix of a
+ *  scene node into the shader and drawing its mesh.  The
+ *  texture/color and material are set by ApplyDrawState().
+ ***********************************************************/
+void SceneManager::DrawSceneNode(int nodeIndex)
+{
+	const SCENE_NODE& node = m_sceneNodes[nodeIndex];
+
+	// group nodes only carry a transformation for their children
+	if (node.mesh == MESH_NONE)
+	{
+		return;
+	}
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetMat4Value(g_ModelName, m_transforms.GetWorldMatrix(nodeIndex));
+	}
+
+	switch (node.mesh)
+	{
+	case MESH_BOX:
+		m_basicMeshes->DrawBoxMesh();
+		break;
+	case MESH_PLANE:
+		m_basicMeshes->DrawPlaneMesh();
+		break;
+	case MESH_CYLINDER:
+		m_basicMeshes->DrawCylinderMesh();
+		break;
+	case MESH_SPHERE:
+		m_basicMeshes->DrawSphereMesh();
+		break;
+	case MESH_TORUS:
+		m_basicMeshes->DrawTorusMesh();
+		break;
+	default:
+		break;
+	}
+
+	// ShapeMeshes is counted as one draw per mesh
+	FrameProfiler::CountDrawCall();
+}
+
+/***********************************************************
+ *  IsSameTexturing()
+ *
+ *  This method is used for checking whether two scene nodes
+ *  are drawn with the same texture or color, which also
+ *  gives them the same program variant.  Their materials
+ *  may differ, which lets them share one GPU bucket.
+ ***********************************************************/
+bool SceneManager::IsSameTexturing(const SCENE_NODE& first, const SCENE_NODE& second)
+{
+	if (first.textureSlot != second.textureSlot)
+	{
+		return(false);
+	}
+
+	if (first.textureSlot >= 0)
+	{
+		return((first.blendTextureSlot == second.blendTextureSlot) &&
+			(first.blendFactor == second.blendFactor));
+	}
+
+	return(first.color == second.color);
+}
+
+/***********************************************************
+ *  IsSameAppearance()
+ *
+ *  This method is used for checking whether two scene nodes
+ *  are drawn with the same texture or color and material,
+ *  which lets them share one static batch.
+ ***********************************************************/
+bool SceneManager::IsSameAppearance(const SCENE_NODE& first, const SCENE_NODE& second)
+{
+	return((first.materialIndex == second.materialIndex) && IsSameTexturing(first, second));
+}
+
+/***********************************************************
+ *  IsSameSurface()
+ *
+ *  This method is used for checking whether two scene nodes
+ *  draw the same mesh with the same texture or color and
+ *  material, which lets them share one instanced draw.
+ ***********************************************************/
+bool SceneManager::IsSameSurface(const SCENE_NODE& first, const SCENE_NODE& second)
+{
+	return((first.mesh == second.mesh) && IsSameAppearance(first, second));
+}
+
+/***********************************************************
+ *  BuildStaticBatches()
+ *
+ *  This method is used for baking the world matrices of the
+ *  opaque nodes that never move into one vertex buffer per
+ *  texture or color and material, so all of them are drawn
+ *  in a handful of draw calls.  Nodes below a moving node,
+ *  the torus and the transparent nodes keep their own draws.
+ ***********************************************************/
+void SceneManager::BuildStaticBatches()
+{
+	// true when a node and all of its parents are static
+	std::vector<bool> bFixed(m_sceneNodes.size(), false);
+
+	m_staticBatches->Clear();
+	m_staticBatchNodes.clear();
+	m_bStaticBatchesDirty = false;
+
+	for (int i = 0; i < (int)m_sceneNodes.size(); i++)
+	{
+		SCENE_NODE& node = m_sceneNodes[i];
+		ShapeGeometry::SHAPE_TYPE shape = ShapeGeometry::SHAPE_COUNT;
+
+		node.staticBatch = -1;
+		bFixed[i] = (node.bStatic == true) &&
+			((node.parentIndex < 0) || (bFixed[node.parentIndex] == true));
+
+		if ((m_bUseStaticBatching == false) || (bFixed[i] == false) || (IsTransparent(node) == true))
+		{
+			continue;
+		}
+
+		switch (node.mesh)
+		{
+		case MESH_BOX:
+			shape = ShapeGeometry::SHAPE_BOX;
+			break;
+		case MESH_PLANE:
+			shape = ShapeGeometry::SHAPE_PLANE;
+			break;
+		case MESH_CYLINDER:
+			shape = ShapeGeometry::SHAPE_CYLINDER;
+			break;
+		case MESH_SPHERE:
+			shape = ShapeGeometry::SHAPE_SPHERE;
+			break;
+		default:
+			break;
+		}
+		if (shape == ShapeGeometry::SHAPE_COUNT)
+		{
+			continue;
+		}
+
+		int batch = 0;
+		while ((batch < (int)m_staticBatchNodes.size()) &&
+			(IsSameAppearance(m_sceneNodes[m_staticBatchNodes[batch]], node) == false))
+		{
+			batch++;
+		}
+		if (batch == (int)m_staticBatchNodes.size())
+		{
+			batch = m_staticBatches->AddBatch();
+			m_staticBatchNodes.push_back(i);
+		}
+
+		m_staticBatches->AddShape(batch, shape, m_transforms.GetWorldMatrix(i));
+		node.staticBatch = batch;
+	}
+
+	m_staticBatches->UploadBatches();
+	m_bBoundsDirty = true;
+}
+
+/***********************************************************
+ *  DrawStaticBatch()
+ *
+ *  This method is used for drawing a static batch.  Its
+ *  vertices are already in world space, so the model matrix
+ *  is the identity.
+ ***********************************************************/
+void SceneManager::DrawStaticBatch(const RenderQueue::DRAW_ITEM& item)
+{
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetMat4Value(g_ModelName, glm::mat4(1.0f));
+	}
+
+	m_staticBatches->DrawBatch(item.staticBatch);
+}
+
+/***********************************************************
+ *  BuildInstanceBatches()
+ *
+ *  This method is used for grouping the opaque box, cylinder
+ *  and sphere nodes into batches that share a mesh, texture
+ *  or color and material.  Every other node is kept in
+ *  scene order to be drawn one at a time afterwards, so the
+ *  transparent glass panels are still drawn last.  Nodes in
+ *  a static batch are skipped.
+ ***********************************************************/
+void SceneManager::BuildInstanceBatches()
+{
+	std::vector<std::vector<int>> batchNodes;
+
+	m_instanceBatches.clear();
+	m_instanceNodes.clear();
+	m_singleNodes.clear();
+
+	for (int i = 0; i < (int)m_sceneNodes.size(); i++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[i];
+		bool bInstanced = false;
+
+		if ((node.mesh == MESH_NONE) || (node.staticBatch >= 0))
+		{
+			continue;
+		}
+
+		bInstanced = ((node.mesh == MESH_BOX) || (node.mesh == MESH_CYLINDER) || (node.mesh == MESH_SPHERE)) &&
+			(IsTransparent(node) == false);
+		if (bInstanced == false)
+		{
+			m_singleNodes.push_back(i);
+			continue;
+		}
+
+		int batch = 0;
+		while ((batch < (int)m_instanceBatches.size()) &&
+			(IsSameSurface(m_sceneNodes[m_instanceBatches[batch].nodeIndex], node) == false))
+		{
+			batch++;
+		}
+		if (batch == (int)m_instanceBatches.size())
+		{
+			INSTANCE_BATCH newBatch;
+			newBatch.nodeIndex = i;
+			newBatch.firstInstance = 0;
+			newBatch.instanceCount = 0;
+			m_instanceBatches.push_back(newBatch);
+			batchNodes.push_back(std::vector<int>());
+		}
+		batchNodes[batch].push_back(i);
+	}
+
+	// lay the instances out so each batch is one contiguous run
+	for (int batch = 0; batch < (int)m_instanceBatches.size(); batch++)
+	{
+		m_instanceBatches[batch].firstInstance = (int)m_instanceNodes.size();
+		m_instanceBatches[batch].instanceCount = (int)batchNodes[batch].size();
+		m_instanceNodes.insert(m_instanceNodes.end(), batchNodes[batch].begin(), batchNodes[batch].end());
+	}
+
+	// large batches are split so their instances are gathered by
+	// several jobs
+	m_instanceJobs.clear();
+	for (int batch = 0; batch < (int)m_instanceBatches.size(); batch++)
+	{
+		const INSTANCE_BATCH& instanceBatch = m_instanceBatches[batch];
+
+		for (int first = 0; first < instanceBatch.instanceCount; first += g_NodesPerJob)
+		{
+			INSTANCE_JOB job;
+			job.batch = batch;
+			job.first = instanceBatch.firstInstance + first;
+			job.last = instanceBatch.firstInstance + std::min(first + g_NodesPerJob, instanceBatch.instanceCount);
+			m_instanceJobs.push_back(job);
+		}
+	}
+
+	m_bInstanceTransformsDirty = true;
+
+	if (NULL != m_gpuCuller)
+	{
+		BuildGpuBuckets();
+	}
+}
+
+/***********************************************************
+ *  UploadInstanceTransforms()
+ *
+ *  This method is used for copying the world matrices of the
+ *  instanced nodes that passed culling into the instance
+ *  stream.  The matrices are gathered straight into the
+ *  mapped memory of the stream.
+ ***********************************************************/
+void SceneManager::UploadInstanceTransforms()
+{
+	int count = m_visibleInstanceNodes.Size();
+
+	if (count > 0)
+	{
+		glm::mat4* transforms = m_instancedMeshes->BeginInstanceTransforms(count);
+
+		if (NULL != transforms)
+		{
+			m_transforms.GatherWorldMatrices(m_visibleInstanceNodes.Data(), count, transforms);
+		}
+		m_instancedMeshes->EndInstanceTransforms();
+	}
+	m_uploadedInstanceNodes.assign(m_visibleInstanceNodes.begin(), m_visibleInstanceNodes.end());
+	m_bInstanceTransformsDirty = false;
+}
+
+/***********************************************************
+ *  DrawInstanceBatch()
+ *
+ *  This method is used for drawing a run of instances from
+ *  the instance buffer with a single instanced draw call.
+ *  The node of the item supplies the mesh to draw.
+ ***********************************************************/
+void SceneManager::DrawInstanceBatch(const RenderQueue::DRAW_ITEM& item)
+{
+	const SCENE_NODE& node = m_sceneNodes[item.nodeIndex];
+
+	switch (node.mesh)
+	{
+	case MESH_BOX:
+		m_instancedMeshes->DrawBoxMeshInstanced(item.firstInstance, item.instanceCount);
+		break;
+	case MESH_CYLINDER:
+		m_instancedMeshes->DrawCylinderMeshInstanced(item.firstInstance, item.instanceCount, item.lodLevel);
+		break;
+	case MESH_SPHERE:
+		m_instancedMeshes->DrawSphereMeshInstanced(item.firstInstance, item.instanceCount, item.lodLevel);
+		break;
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  GetInstanceCommand()
+ *
+ *  This method is used for getting the multi-draw command
+ *  that draws the instance run of a draw item.
+ ***********************************************************/
+InstancedMeshes::DRAW_COMMAND SceneManager::GetInstanceCommand(const RenderQueue::DRAW_ITEM& item) const
+{
+	switch (m_sceneNodes[item.nodeIndex].mesh)
+	{
+	case MESH_CYLINDER:
+		return(m_instancedMeshes->GetCylinderCommand(item.firstInstance, item.instanceCount, item.lodLevel));
+	case MESH_SPHERE:
+		return(m_instancedMeshes->GetSphereCommand(item.firstInstance, item.instanceCount, item.lodLevel));
+	default:
+		return(m_instancedMeshes->GetBoxCommand(item.firstInstance, item.instanceCount));
+	}
+}
+
+/***********************************************************
+ *  IsGpuCullingActive()
+ *
+ *  This method is used for checking whether the instanced
+ *  nodes are culled and drawn by the GPU culler this frame.
+ *  Without a culler, or with it or instancing switched off,
+ *  they go through the CPU culling and instance upload.
+ ***********************************************************/
+bool SceneManager::IsGpuCullingActive() const
+{
+	return((NULL != m_gpuCuller) && (m_gpuCuller->IsReady() == true) &&
+		(m_bUseGpuCulling == true) && (m_bUseInstancing == true));
+}
+
+/***********************************************************
+ *  BuildGpuBuckets()
+ *
+ *  This method is used for grouping the instance batches by
+ *  texture or color into buckets, since the material of
+ *  each instance is read from the instance buffer.  Every
+ *  bucket gets a command for the box and for each level of
+ *  the cylinder and the sphere, and each command gets room
+ *  for all of the bucket's instances of its mesh, which
+ *  could all be drawn at the same level.
+ ***********************************************************/
+void SceneManager::BuildGpuBuckets()
+{
+	std::vector<InstancedMeshes::DRAW_COMMAND> commands;
+	std::vector<std::vector<int>> bucketBatches;
+	int instanceCount = 0;
+
+	m_gpuBuckets.clear();
+	m_gpuObjectNodes.clear();
+	m_gpuObjectCommands.clear();
+	m_bGpuObjectsDirty = true;
+
+	if (NULL == m_gpuCuller)
+	{
+		return;
+	}
+
+	for (int batch = 0; batch < (int)m_instanceBatches.size(); batch++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[m_instanceBatches[batch].nodeIndex];
+
+		int bucket = 0;
+		while ((bucket < (int)m_gpuBuckets.size()) &&
+			(IsSameTexturing(m_sceneNodes[m_gpuBuckets[bucket].nodeIndex], node) == false))
+		{
+			bucket++;
+		}
+		if (bucket == (int)m_gpuBuckets.size())
+		{
+			GPU_BUCKET newBucket;
+			newBucket.nodeIndex = m_instanceBatches[batch].nodeIndex;
+			newBucket.firstCommand = 0;
+			newBucket.objectCount = 0;
+			m_gpuBuckets.push_back(newBucket);
+			bucketBatches.push_back(std::vector<int>());
+		}
+		bucketBatches[bucket].push_back(batch);
+	}
+
+	for (int bucket = 0; bucket < (int)m_gpuBuckets.size(); bucket++)
+	{
+		GPU_BUCKET& gpuBucket = m_gpuBuckets[bucket];
+		int boxCount = 0;
+		int cylinderCount = 0;
+		int sphereCount = 0;
+
+		gpuBucket.firstCommand = (int)commands.size();
+		for (int batch : bucketBatches[bucket])
+		{
+			const INSTANCE_BATCH& instanceBatch = m_instanceBatches[batch];
+			MESH_TYPE mesh = m_sceneNodes[instanceBatch.nodeIndex].mesh;
+			// the box command comes first, then the cylinder levels
+			// and then the sphere levels
+			int command = gpuBucket.firstCommand;
+
+			if (mesh == MESH_BOX)
+			{
+				boxCount += instanceBatch.instanceCount;
+			}
+			else if (mesh == MESH_CYLINDER)
+			{
+				cylinderCount += instanceBatch.instanceCount;
+				command += 1;
+			}
+			else
+			{
+				sphereCount += instanceBatch.instanceCount;
+				command += 1 + MESH_LOD_LEVELS;
+			}
+
+			for (int i = 0; i < instanceBatch.instanceCount; i++)
+			{
+				m_gpuObjectNodes.push_back(m_instanceNodes[instanceBatch.firstInstance + i]);
+				m_gpuObjectCommands.push_back(command);
+			}
+			gpuBucket.objectCount += instanceBatch.instanceCount;
+		}
+
+		commands.push_back(m_instancedMeshes->GetBoxCommand(instanceCount, 0));
+		instanceCount += boxCount;
+		for (int level = 0; level < MESH_LOD_LEVELS; level++)
+		{
+			commands.push_back(m_instancedMeshes->GetCylinderCommand(instanceCount, 0, level));
+			instanceCount += cylinderCount;
+		}
+		for (int level = 0; level < MESH_LOD_LEVELS; level++)
+		{
+			commands.push_back(m_instancedMeshes->GetSphereCommand(instanceCount, 0, level));
+			instanceCount += sphereCount;
+		}
+	}
+
+	m_gpuCuller->SetCommands(commands, instanceCount);
+}
+
+/***********************************************************
+ *  UploadGpuObjects()
+ *
+ *  This method is used for writing the world matrix, local
+ *  box, material and occlusion group of every instanced
+ *  node into the object records of the GPU culler.  It only
+ *  runs when the nodes have moved or been regrouped.
+ ***********************************************************/
+void SceneManager::UploadGpuObjects()
+{
+	std::vector<GLuint> nodeGroups(m_sceneNodes.size(), g_NoOcclusionGroup);
+	std::vector<GpuCuller::OBJECT_RECORD> objects(m_gpuObjectNodes.size());
+
+	for (int group = 0; group < (int)m_occlusionGroups.size(); group++)
+	{
+		for (int i = m_occlusionGroups[group].nodeIndex + 1; i <= m_occlusionGroups[group].lastNode; i++)
+		{
+			nodeGroups[i] = (GLuint)group;
+		}
+	}
+
+	m_jobPool->ParallelFor((int)objects.size(), g_NodesPerJob, [&](int /*job*/, int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			int nodeIndex = m_gpuObjectNodes[i];
+			const SCENE_NODE& node = m_sceneNodes[nodeIndex];
+			GpuCuller::OBJECT_RECORD& object = objects[i];
+			glm::vec3 minPoint;
+			glm::vec3 maxPoint;
+
+			GetMeshBounds(node.mesh, minPoint, maxPoint);
+			object.world = m_transforms.GetWorldMatrix(nodeIndex);
+			object.minPoint = glm::vec4(minPoint, 1.0f);
+			object.maxPoint = glm::vec4(maxPoint, 1.0f);
+			object.firstCommand = (GLuint)m_gpuObjectCommands[i];
+			object.lodCount = (node.mesh == MESH_BOX) ? 1 : MESH_LOD_LEVELS;
+			object.materialIndex = node.materialIndex;
+			object.occlusionGroup = nodeGroups[nodeIndex];
+		}
+	});
+
+	m_gpuCuller->SetObjects(objects);
+	m_bGpuObjectsDirty = false;
+}
+
+/***********************************************************
+ *  CullGpuInstances()
+ *
+ *  This method is used for running the GPU culling pass of
+ *  the frame.  It uses the frustum of CullScene() and the
+ *  occlusion results it applied, so the CPU culling only
+ *  counts the skipped instanced nodes.  The compute program
+ *  replaces the current one, which is made current again.
+ ***********************************************************/
+void SceneManager::CullGpuInstances()
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	if (m_bGpuObjectsDirty == true)
+	{
+		UploadGpuObjects();
+	}
+
+	m_groupVisibility.resize(m_occlusionGroups.size());
+	for (int group = 0; group < (int)m_occlusionGroups.size(); group++)
+	{
+		m_groupVisibility[group] = (m_occlusionQueries.IsOccluded(group) == true) ? 0 : 1;
+	}
+	m_gpuCuller->SetGroupVisibility(m_groupVisibility);
+
+	const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+	GpuCuller::CULL_VIEW view;
+
+	view.viewProjection = camera.projection * camera.view;
+	for (int plane = 0; plane < 6; plane++)
+	{
+		view.planes[plane] = m_frustumCuller.GetPlane(plane);
+	}
+	view.bFrustumCulling = m_bUseFrustumCulling;
+	view.bOcclusionCulling = m_bUseOcclusionCulling;
+	view.bLevelOfDetail = m_bUseLevelOfDetail;
+	view.nearPlane = camera.nearPlane;
+	view.lodScale = camera.projection[1][1] * camera.screenSize.y;
+	for (int level = 0; level < (MESH_LOD_LEVELS - 1); level++)
+	{
+		view.lodScreenSizes[level] = g_LodScreenSizes[level];
+	}
+	view.lodHysteresis = g_LodHysteresis;
+
+	m_gpuCuller->CullObjects(view);
+
+	m_pShaderUniforms->UseProgram(m_pShaderUniforms->GetCurrentProgram());
+}
+
+/***********************************************************
+ *  DrawGpuBucket()
+ *
+ *  This method is used for drawing the instances that the
+ *  GPU culler left in the commands of a bucket, with one
+ *  multi-draw and the material of each instance.
+ ***********************************************************/
+void SceneManager::DrawGpuBucket(const RenderQueue::DRAW_ITEM& item)
+{
+	const GPU_BUCKET& bucket = m_gpuBuckets[item.gpuBucket];
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetBoolValue(g_UseInstanceMaterialsName, true);
+	}
+
+	m_instancedMeshes->MultiDrawCulled(m_gpuCuller->GetCommandBuffer(), bucket.firstCommand, g_BucketCommands,
+		m_gpuCuller->GetInstanceBuffer());
+
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->SetBoolValue(g_UseInstanceMaterialsName, false);
+	}
+}
+
+/***********************************************************
+ *  IsTransparent()
+ *
+ *  This method is used for checking whether a scene node is
+ *  drawn see-through, with a solid color whose alpha is below
+ *  one or with a texture that has an alpha channel.
+ *  Transparent nodes are drawn after the opaque ones, back
+ *  to front, with blending on.
+ ***********************************************************/
+bool SceneManager::IsTransparent(const SCENE_NODE& node) const
+{
+	if (node.textureSlot >= 0)
+	{
+		return(m_textureManager->HasAlpha(node.textureSlot));
+	}
+
+	return(node.color.a < 1.0f);
+}
+
+/***********************************************************
+ *  UpdateNodeShaders()
+ *
+ *  This method is used for getting the program variants that
+ *  match the features the scene nodes can be drawn with.  A
+ *  variant may have to be built, which needs the GL thread,
+ *  so this runs before the jobs that look the variants up.
+ *  Without variants every node uses the base program,
+ *  handle 0.
+ ***********************************************************/
+void SceneManager::UpdateNodeShaders()
+{
+	if (NULL == m_pShaderVariants)
+	{
+		return;
+	}
+
+	int features = 0;
+
+	if (m_bUseLighting == true)
+	{
+		features |= SHADER_LIT;
+		if (m_bUseLightClusters == true)
+		{
+			features |= SHADER_CLUSTERED_LIGHTS;
+		}
+		if (m_lightBlock.directionalLight.bActive != 0)
+		{
+			features |= SHADER_DIRECTIONAL_LIGHT;
+		}
+		if (m_lightBlock.spotLight.bActive != 0)
+		{
+			features |= SHADER_SPOT_LIGHT;
+		}
+	}
+
+	// only the variants of feature sets that some node has are
+	// built, the others are never looked up
+	for (int featureSet = 0; featureSet < 3; featureSet++)
+	{
+		if ((m_usedFeatureSets & (1 << featureSet)) != 0)
+		{
+			m_nodeShaders[featureSet] = m_pShaderVariants->GetVariant(features | g_NodeFeatureSets[featureSet]);
+		}
+	}
+}
+
+/***********************************************************
+ *  GetNodeFeatureSet()
+ *
+ *  This method is used for getting whether a scene node is
+ *  drawn untextured (0), textured (1) or with two blended
+ *  textures (2).
+ ***********************************************************/
+int SceneManager::GetNodeFeatureSet(const SCENE_NODE& node) const
+{
+	if (node.textureSlot < 0)
+	{
+		return(0);
+	}
+	if ((node.blendTextureSlot >= 0) && (node.blendFactor > 0.0f))
+	{
+		return(2);
+	}
+
+	return(1);
+}
+
+/***********************************************************
+ *  GetNodeShader()
+ *
+ *  This method is used for getting the program variant that
+ *  matches the features a scene node is drawn with, out of
+ *  the variants found by UpdateNodeShaders().
+ ***********************************************************/
+int SceneManager::GetNodeShader(const SCENE_NODE& node) const
+{
+	return(m_nodeShaders[GetNodeFeatureSet(node)]);
+}
+
+/***********************************************************
+ *  MakeNodeSortKey()
+ *
+ *  This method is used for building the render queue sort
+ *  key of a scene node from its pre-resolved handles and
+ *  its view depth.
+ ***********************************************************/
+uint64_t SceneManager::MakeNodeSortKey(const SCENE_NODE& node, int shaderHandle, int sequence, float depth) const
+{
+	if (IsTransparent(node) == true)
+	{
+		return(RenderQueue::MakeTransparentKey(depth, sequence));
+	}
+
+	return(RenderQueue::MakeOpaqueKey(shaderHandle, node.textureSlot, node.materialIndex, (int)node.mesh, depth));
+}
+
+/***********************************************************
+ *  GetViewDepth()
+ *
+ *  This method is used for getting the distance of a point
+ *  in front of the camera, scaled so the far plane is at 1.
+ ***********************************************************/
+float SceneManager::GetViewDepth(const glm::vec3& point) const
+{
+	if (NULL == m_pShaderUniforms)
+	{
+		return(0.0f);
+	}
+
+	const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+	float viewDepth = -(camera.view * glm::vec4(point, 1.0f)).z;
+
+	return(std::min(std::max(viewDepth / camera.farPlane, 0.0f), 1.0f));
+}
+
+/***********************************************************
+ *  GetMeshBounds()
+ *
+ *  This method is used for getting the local bounding box of
+ *  a basic shape.  ShapeMeshes does not publish the radii of
+ *  its torus, so a generous box is used for it.
+ ***********************************************************/
+void SceneManager::GetMeshBounds(MESH_TYPE mesh, glm::vec3& minPoint, glm::vec3& maxPoint)
+{
+	switch (mesh)
+	{
+	case MESH_BOX:
+		minPoint = glm::vec3(-0.5f);
+		maxPoint = glm::vec3(0.5f);
+		break;
+	case MESH_PLANE:
+		minPoint = glm::vec3(-1.0f, 0.0f, -1.0f);
+		maxPoint = glm::vec3(1.0f, 0.0f, 1.0f);
+		break;
+	case MESH_CYLINDER:
+		minPoint = glm::vec3(-1.0f, 0.0f, -1.0f);
+		maxPoint = glm::vec3(1.0f, 1.0f, 1.0f);
+		break;
+	case MESH_SPHERE:
+		minPoint = glm::vec3(-1.0f);
+		maxPoint = glm::vec3(1.0f);
+		break;
+	case MESH_TORUS:
+		minPoint = glm::vec3(-1.5f);
+		maxPoint = glm::vec3(1.5f);
+		break;
+	default:
+		minPoint = glm::vec3(0.0f);
+		maxPoint = glm::vec3(0.0f);
+		break;
+	}
+}
+
+/***********************************************************
+ *  UpdateSceneBounds()
+ *
+ *  This method is used for calculating the world bounding
+ *  box of every scene node from its mesh and world matrix.
+ *  The boxes of the static batches and then of the
+ *  occlusion groups follow the node boxes, each holding the
+ *  boxes of all of its nodes.
+ ***********************************************************/
+void SceneManager::UpdateSceneBounds()
+{
+	int nodeCount = (int)m_sceneNodes.size();
+	int batchCount = (int)m_staticBatchNodes.size();
+	int groupBase = nodeCount + batchCount;
+	std::vector<glm::vec3> nodeMin(nodeCount);
+	std::vector<glm::vec3> nodeMax(nodeCount);
+	std::vector<glm::vec3> batchMin(batchCount, glm::vec3(std::numeric_limits<float>::max()));
+	std::vector<glm::vec3> batchMax(batchCount, glm::vec3(-std::numeric_limits<float>::max()));
+
+	m_frustumCuller.SetBoundsCount(groupBase + (int)m_occlusionGroups.size());
+	m_nodeSpheres.resize(nodeCount + batchCount);
+
+	// every job writes the boxes of its own nodes only
+	m_jobPool->ParallelFor(nodeCount, g_NodesPerJob, [&](int /*job*/, int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			GetMeshBounds(m_sceneNodes[i].mesh, nodeMin[i], nodeMax[i]);
+			FrustumCuller::TransformBounds(m_transforms.GetWorldMatrix(i), nodeMin[i], nodeMax[i], nodeMin[i], nodeMax[i]);
+			m_frustumCuller.SetBounds(i, nodeMin[i], nodeMax[i]);
+			m_nodeSpheres[i] = glm::vec4((nodeMin[i] + nodeMax[i]) * 0.5f, glm::length(nodeMax[i] - nodeMin[i]) * 0.5f);
+		}
+	});
+
+	for (int i = 0; i < nodeCount; i++)
+	{
+		int batch = m_sceneNodes[i].staticBatch;
+
+		if (batch >= 0)
+		{
+			batchMin[batch] = glm::min(batchMin[batch], nodeMin[i]);
+			batchMax[batch] = glm::max(batchMax[batch], nodeMax[i]);
+		}
+	}
+
+	for (int batch = 0; batch < batchCount; batch++)
+	{
+		m_frustumCuller.SetBounds(nodeCount + batch, batchMin[batch], batchMax[batch]);
+		m_nodeSpheres[nodeCount + batch] = glm::vec4((batchMin[batch] + batchMax[batch]) * 0.5f,
+			glm::length(batchMax[batch] - batchMin[batch]) * 0.5f);
+	}
+
+	// the groups are independent runs of nodes, so a job only
+	// needs a few of them to have enough work
+	m_jobPool->ParallelFor((int)m_occlusionGroups.size(), 16, [&](int /*job*/, int first, int last)
+	{
+		for (int group = first; group < last; group++)
+		{
+			OCCLUSION_GROUP& occlusionGroup = m_occlusionGroups[group];
+
+			occlusionGroup.minPoint = glm::vec3(std::numeric_limits<float>::max());
+			occlusionGroup.maxPoint = glm::vec3(-std::numeric_limits<float>::max());
+			for (int i = occlusionGroup.nodeIndex + 1; i <= occlusionGroup.lastNode; i++)
+			{
+				if (m_sceneNodes[i].mesh != MESH_NONE)
+				{
+					occlusionGroup.minPoint = glm::min(occlusionGroup.minPoint, nodeMin[i]);
+					occlusionGroup.maxPoint = glm::max(occlusionGroup.maxPoint, nodeMax[i]);
+				}
+			}
+			m_frustumCuller.SetBounds(groupBase + group, occlusionGroup.minPoint, occlusionGroup.maxPoint);
+		}
+	});
+
+	m_bBoundsDirty = false;
+}
+
+/***********************************************************
+ *  CullScene()
+ *
+ *  This method is used for testing the bounding boxes of
+ *  the nodes and static batches against the frustum of the
+ *  camera, and for hiding the groups found occluded.  The
+ *  number of skipped mesh nodes is printed whenever it
+ *  changes.
+ ***********************************************************/
+void SceneManager::CullScene()
+{
+	int nodeCount = (int)m_sceneNodes.size();
+
+	if (m_bBoundsDirty == true)
+	{
+		UpdateSceneBounds();
+	}
+
+	if ((m_bUseFrustumCulling == true) && (NULL != m_pShaderUniforms))
+	{
+		const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+
+		m_frustumCuller.SetFrustum(camera.projection * camera.view);
+		m_visibleBounds.resize(m_frustumCuller.GetBoundsCount());
+		m_jobPool->ParallelFor(m_frustumCuller.GetBoundsCount(), g_NodesPerJob, [this](int /*job*/, int first, int last)
+		{
+			m_frustumCuller.CullBounds(m_visibleBounds, first, last);
+		});
+	}
+	else
+	{
+		m_visibleBounds.assign(m_frustumCuller.GetBoundsCount(), 1);
+	}
+
+	// each job counts its own nodes, the counts are added up after
+	m_jobCulledCounts.assign(JobPool::GetJobCount(nodeCount, g_NodesPerJob), 0);
+	m_jobPool->ParallelFor(nodeCount, g_NodesPerJob, [this, nodeCount](int job, int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			const SCENE_NODE& node = m_sceneNodes[i];
+			int boundsIndex = (node.staticBatch >= 0) ? (nodeCount + node.staticBatch) : i;
+
+			if ((node.mesh != MESH_NONE) && (m_visibleBounds[boundsIndex] == 0))
+			{
+				m_jobCulledCounts[job]++;
+			}
+		}
+	});
+
+	m_culledObjectCount = 0;
+	for (int culledCount : m_jobCulledCounts)
+	{
+		m_culledObjectCount += culledCount;
+	}
+
+	ApplyOcclusionResults();
+
+	if ((m_culledObjectCount != m_reportedCulledCount) || (m_occludedObjectCount != m_reportedOccludedCount))
+	{
+		std::cout << "INFO: frustum culling skipped " << m_culledObjectCount << " and occlusion culling skipped "
+			<< m_occludedObjectCount << " of the scene objects" << std::endl;
+		m_reportedCulledCount = m_culledObjectCount;
+		m_reportedOccludedCount = m_occludedObjectCount;
+	}
+}
+
+/***********************************************************
+ *  UpdateLodLevels()
+ *
+ *  This method is used for picking the level of detail of
+ *  every visible instanced cylinder and sphere from the
+ *  projected diameter of its bounding sphere.
+ ***********************************************************/
+void SceneManager::UpdateLodLevels()
+{
+	// the GPU culler picks the levels of the instanced nodes
+	if ((NULL == m_pShaderUniforms) || (IsGpuCullingActive() == true))
+	{
+		return;
+	}
+
+	const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+	glm::mat4 viewProjection = camera.projection * camera.view;
+
+	// every instanced node is in m_instanceNodes once, so the
+	// jobs never touch the same node
+	m_jobPool->ParallelFor((int)m_instanceNodes.size(), g_NodesPerJob, [&](int /*job*/, int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			SCENE_NODE& node = m_sceneNodes[m_instanceNodes[i]];
+
+			if ((node.mesh != MESH_CYLINDER) && (node.mesh != MESH_SPHERE))
+			{
+				continue;
+			}
+			if (m_bUseLevelOfDetail == false)
+			{
+				node.lodLevel = 0;
+				continue;
+			}
+			if (m_visibleBounds[m_instanceNodes[i]] == 0)
+			{
+				continue;
+			}
+
+			// clip w is the view depth for a perspective projection
+			// and 1 for an orthographic one
+			const glm::vec4& sphere = m_nodeSpheres[m_instanceNodes[i]];
+			float clipW = (viewProjection * glm::vec4(glm::vec3(sphere), 1.0f)).w;
+			float screenSize = std::numeric_limits<float>::max();
+			if (clipW > camera.nearPlane)
+			{
+				screenSize = (sphere.w * camera.projection[1][1] / clipW) * camera.screenSize.y;
+			}
+
+			node.lodLevel = SelectLodLevel(node.lodLevel, screenSize);
+		}
+	});
+}
+
+/***********************************************************
+ *  SelectLodLevel()
+ *
+ *  This method is used for getting the level of detail for
+ *  a projected size in pixels.  The level only changes once
+ *  the size is clearly past the limit, so shapes sitting at
+ *  a limit do not flicker between two levels.
+ ***********************************************************/
+int SceneManager::SelectLodLevel(int currentLevel, float screenSize)
+{
+	int level = currentLevel;
+
+	// finer while the size is well above the limit of the next finer level
+	while ((level > 0) && (screenSize > (g_LodScreenSizes[level - 1] * (1.0f + g_LodHysteresis))))
+	{
+		level--;
+	}
+	// coarser while the size is well below the limit of this level
+	while ((level < (MESH_LOD_LEVELS - 1)) && (screenSize < (g_LodScreenSizes[level] * (1.0f - g_LodHysteresis))))
+	{
+		level++;
+	}
+
+	return(level);
+}
+
+/***********************************************************
+ *  BuildOcclusionGroups()
+ *
+ *  This method is used for finding the top level group
+ *  nodes, such as the computer fans, whose subtrees are
+ *  hidden as a whole when their box is occluded.  Children
+ *  are added right after their parents, so every subtree is
+ *  one run of nodes.
+ ***********************************************************/
+void SceneManager::BuildOcclusionGroups()
+{
+	m_occlusionGroups.clear();
+
+	for (int i = 0; i < (int)m_sceneNodes.size(); i++)
+	{
+		if ((m_sceneNodes[i].mesh != MESH_NONE) || (m_sceneNodes[i].parentIndex >= 0))
+		{
+			continue;
+		}
+
+		OCCLUSION_GROUP group;
+		group.nodeIndex = i;
+		group.lastNode = i;
+		group.minPoint = glm::vec3(0.0f);
+		group.maxPoint = glm::vec3(0.0f);
+
+		bool bInSubtree = true;
+		while ((bInSubtree == true) && ((group.lastNode + 1) < (int)m_sceneNodes.size()))
+		{
+			int parent = m_sceneNodes[group.lastNode + 1].parentIndex;
+			while (parent > i)
+			{
+				parent = m_sceneNodes[parent].parentIndex;
+			}
+
+			bInSubtree = (parent == i);
+			if (bInSubtree == true)
+			{
+				group.lastNode++;
+			}
+		}
+
+		if (group.lastNode > i)
+		{
+			m_occlusionGroups.push_back(group);
+		}
+	}
+
+	m_occlusionQueries.SetObjectCount((int)m_occlusionGroups.size());
+	m_bBoundsDirty = true;
+	m_bGpuObjectsDirty = true;
+}
+
+/***********************************************************
+ *  ApplyOcclusionResults()
+ *
+ *  This method is used for hiding the mesh nodes of every
+ *  group whose box was occluded in the latest finished
+ *  query.  The results are a frame or two old, which is
+ *  what keeps the queries from stalling the pipeline.
+ ***********************************************************/
+void SceneManager::ApplyOcclusionResults()
+{
+	int groupBase = (int)m_sceneNodes.size() + (int)m_staticBatchNodes.size();
+
+	m_occludedObjectCount = 0;
+	if (m_bUseOcclusionCulling == false)
+	{
+		return;
+	}
+
+	m_occlusionQueries.ReadResults();
+
+	for (int group = 0; group < (int)m_occlusionGroups.size(); group++)
+	{
+		const OCCLUSION_GROUP& occlusionGroup = m_occlusionGroups[group];
+
+		// an old result would hide a group coming back into view
+		if (m_visibleBounds[groupBase + group] == 0)
+		{
+			m_occlusionQueries.SetVisible(group);
+			continue;
+		}
+		if (m_occlusionQueries.IsOccluded(group) == false)
+		{
+			continue;
+		}
+
+		for (int i = occlusionGroup.nodeIndex + 1; i <= occlusionGroup.lastNode; i++)
+		{
+			const SCENE_NODE& node = m_sceneNodes[i];
+
+			if ((node.mesh != MESH_NONE) && (node.staticBatch < 0) && (m_visibleBounds[i] != 0))
+			{
+				m_visibleBounds[i] = 0;
+				m_occludedObjectCount++;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  DrawOcclusionPass()
+ *
+ *  This method is used for drawing the depth of the visible
+ *  static batches, which hold the wall, the stand and the
+ *  opaque case panels, and then the box of every group in
+ *  view inside an occlusion query.  Nothing is written to
+ *  the color buffer.  The depth also saves the main pass
+ *  from shading fragments hidden behind the static batches.
+ ***********************************************************/
+void SceneManager::DrawOcclusionPass()
+{
+	int nodeCount = (int)m_sceneNodes.size();
+	int groupBase = nodeCount + (int)m_staticBatchNodes.size();
+
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	// depth only needs the cheapest program variant
+	if (NULL != m_pShaderVariants)
+	{
+		m_pShaderVariants->UseVariant(m_pShaderVariants->GetVariant(0));
+	}
+	ResetDrawState();
+	m_pShaderUniforms->SetBoolValue(g_UseInstancingName, false);
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+	for (int batch = 0; batch < (int)m_staticBatchNodes.size(); batch++)
+	{
+		if (m_visibleBounds[nodeCount + batch] != 0)
+		{
+			m_pShaderUniforms->SetMat4Value(g_ModelName, glm::mat4(1.0f));
+			m_staticBatches->DrawBatch(batch);
+		}
+	}
+
+	// the group boxes are tested against the depth, not added to it
+	glDepthMask(GL_FALSE);
+
+	const ShaderUniforms::CAMERA_BLOCK& camera = m_pShaderUniforms->GetCameraBlock();
+	for (int group = 0; group < (int)m_occlusionGroups.size(); group++)
+	{
+		const OCCLUSION_GROUP& occlusionGroup = m_occlusionGroups[group];
+
+		if ((m_visibleBounds[groupBase + group] == 0) || (m_occlusionQueries.CanQuery(group) == false))
+		{
+			continue;
+		}
+
+		// the near plane would clip the box of a group that the
+		// camera is inside of, so such a group is always visible
+		glm::vec3 nearMin = occlusionGroup.minPoint - glm::vec3(camera.nearPlane);
+		glm::vec3 nearMax = occlusionGroup.maxPoint + glm::vec3(camera.nearPlane);
+		if ((camera.viewPosition.x >= nearMin.x) && (camera.viewPosition.x <= nearMax.x) &&
+			(camera.viewPosition.y >= nearMin.y) && (camera.viewPosition.y <= nearMax.y) &&
+			(camera.viewPosition.z >= nearMin.z) && (camera.viewPosition.z <= nearMax.z))
+		{
+			m_occlusionQueries.SetVisible(group);
+			continue;
+		}
+
+		// the box mesh is a unit cube centered on the origin
+		m_pShaderUniforms->SetMat4Value(g_ModelName,
+			glm::translate((occlusionGroup.minPoint + occlusionGroup.maxPoint) * 0.5f) *
+			glm::scale(occlusionGroup.maxPoint - occlusionGroup.minPoint));
+
+		m_occlusionQueries.BeginQuery(group);
+		m_basicMeshes->DrawBoxMesh();
+		FrameProfiler::CountDrawCall();
+		m_occlusionQueries.EndQuery();
+	}
+
+	glDepthMask(GL_TRUE);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+/***********************************************************
+ *  QueueSceneDraws()
+ *
+ *  This method is used for filling the render queue with the
+ *  instance batches and single node draws of the frame and
+ *  sorting them so that draws sharing a program variant,
+ *  texture and material are submitted next to each other.
+ *  The visible instances and the single node draw items are
+ *  gathered by jobs into buffers of their own, which are
+ *  merged in job order, so the queue comes out the same as
+ *  with a single thread.  All of the lists are allocated in
+ *  the frame arena, and the buffers of the jobs get all the
+ *  room they can need before the jobs start.
+ ***********************************************************/
+void SceneManager::QueueSceneDraws()
+{
+	RenderQueue::DRAW_ITEM item;
+	int sequence = 0;
+
+	int nodeCount = (int)m_sceneNodes.size();
+	int singleCount = nodeCount;
+
+	if (m_bUseInstancing == true)
+	{
+		singleCount = (int)m_singleNodes.size();
+	}
+
+	// a static batch, a run of each batch and level, or a node per item
+	m_renderQueue.Clear(m_frameArena, (int)m_staticBatchNodes.size() +
+		((m_bUseInstancing == true) ? ((int)m_instanceBatches.size() * MESH_LOD_LEVELS) : 0) + singleCount);
+
+	// variants may need to be built, which the jobs cannot do
+	UpdateNodeShaders();
+
+	for (int batch = 0; batch < (int)m_staticBatchNodes.size(); batch++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[m_staticBatchNodes[batch]];
+
+		if (m_visibleBounds[nodeCount + batch] == 0)
+		{
+			continue;
+		}
+
+		item.shaderHandle = GetNodeShader(node);
+		item.sortKey = MakeNodeSortKey(node, item.shaderHandle, sequence++,
+			GetViewDepth(glm::vec3(m_nodeSpheres[nodeCount + batch])));
+		item.nodeIndex = m_staticBatchNodes[batch];
+		item.staticBatch = batch;
+		item.firstInstance = 0;
+		item.instanceCount = 0;
+		item.lodLevel = 0;
+		item.gpuBucket = -1;
+		m_renderQueue.Submit(item);
+	}
+
+	// the remaining draws come from the scene nodes themselves
+	item.staticBatch = -1;
+	item.lodLevel = 0;
+	item.gpuBucket = -1;
+
+	if (IsGpuCullingActive() == true)
+	{
+		// the GPU culler already wrote the commands of every
+		// bucket, so a bucket is queued whole with no depth
+		for (int bucket = 0; bucket < (int)m_gpuBuckets.size(); bucket++)
+		{
+			const SCENE_NODE& bucketNode = m_sceneNodes[m_gpuBuckets[bucket].nodeIndex];
+
+			item.shaderHandle = GetNodeShader(bucketNode);
+			item.sortKey = MakeNodeSortKey(bucketNode, item.shaderHandle, sequence++, 0.0f);
+			item.nodeIndex = m_gpuBuckets[bucket].nodeIndex;
+			item.firstInstance = 0;
+			item.instanceCount = m_gpuBuckets[bucket].objectCount;
+			item.gpuBucket = bucket;
+			m_renderQueue.Submit(item);
+		}
+		item.gpuBucket = -1;
+	}
+	else if (m_bUseInstancing == true)
+	{
+		for (INSTANCE_JOB& job : m_instanceJobs)
+		{
+			for (int level = 0; level < MESH_LOD_LEVELS; level++)
+			{
+				job.visibleNodes[level].Reset(m_frameArena, job.last - job.first);
+			}
+		}
+		m_jobPool->ParallelFor((int)m_instanceJobs.size(), 1, [this](int /*job*/, int first, int last)
+		{
+			for (int i = first; i < last; i++)
+			{
+				GatherInstanceJob(m_instanceJobs[i]);
+			}
+		});
+
+		// the instances that passed culling are packed into one
+		// contiguous run per batch and level of detail
+		m_visibleInstanceNodes.Reset(m_frameArena, (int)m_instanceNodes.size());
+		for (int jobIndex = 0; jobIndex < (int)m_instanceJobs.size();)
+		{
+			int batch = m_instanceJobs[jobIndex].batch;
+			int lastJob = jobIndex;
+
+			while ((lastJob < (int)m_instanceJobs.size()) && (m_instanceJobs[lastJob].batch == batch))
+			{
+				lastJob++;
+			}
+
+			const SCENE_NODE& batchNode = m_sceneNodes[m_instanceBatches[batch].nodeIndex];
+
+			for (int level = 0; level < MESH_LOD_LEVELS; level++)
+			{
+				int firstInstance = m_visibleInstanceNodes.Size();
+				// a run is ordered by its nearest instance
+				float depth = 1.0f;
+
+				for (int i = jobIndex; i < lastJob; i++)
+				{
+					const INSTANCE_JOB& job = m_instanceJobs[i];
+
+					m_visibleInstanceNodes.Append(job.visibleNodes[level].Data(), job.visibleNodes[level].Size());
+					depth = std::min(depth, job.depths[level]);
+				}
+				if (m_visibleInstanceNodes.Size() == firstInstance)
+				{
+					continue;
+				}
+
+				item.shaderHandle = GetNodeShader(batchNode);
+				item.sortKey = MakeNodeSortKey(batchNode, item.shaderHandle, sequence++, depth);
+				item.nodeIndex = m_instanceBatches[batch].nodeIndex;
+				item.firstInstance = firstInstance;
+				item.instanceCount = m_visibleInstanceNodes.Size() - firstInstance;
+				item.lodLevel = level;
+				m_renderQueue.Submit(item);
+			}
+
+			jobIndex = lastJob;
+		}
+
+		if ((m_bInstanceTransformsDirty == true) ||
+			(m_visibleInstanceNodes.Size() != (int)m_uploadedInstanceNodes.size()) ||
+			(std::equal(m_visibleInstanceNodes.begin(), m_visibleInstanceNodes.end(), m_uploadedInstanceNodes.begin()) == false))
+		{
+			UploadInstanceTransforms();
+		}
+	}
+
+	// the items of the single draws always use the full tessellation
+	m_jobDrawItems.resize(JobPool::GetJobCount(singleCount, g_NodesPerJob));
+	for (int job = 0; job < (int)m_jobDrawItems.size(); job++)
+	{
+		m_jobDrawItems[job].Reset(m_frameArena, std::min(g_NodesPerJob, singleCount - (job * g_NodesPerJob)));
+	}
+	m_jobPool->ParallelFor(singleCount, g_NodesPerJob, [this, sequence](int job, int first, int last)
+	{
+		BuildNodeDrawItems(first, last, sequence, m_jobDrawItems[job]);
+	});
+	for (const FrameArray<RenderQueue::DRAW_ITEM>& items : m_jobDrawItems)
+	{
+		m_renderQueue.Submit(items);
+	}
+
+	m_renderQueue.Sort();
+}
+
+/***********************************************************
+ *  GatherInstanceJob()
+ *
+ *  This method is used for collecting the visible instances
+ *  of a slice of an instance batch by level of detail, along
+ *  with the view depth of the nearest one of each level.
+ ***********************************************************/
+void SceneManager::GatherInstanceJob(INSTANCE_JOB& job)
+{
+	for (int level = 0; level < MESH_LOD_LEVELS; level++)
+	{
+		job.visibleNodes[level].Clear();
+		job.depths[level] = 1.0f;
+	}
+
+	for (int i = job.first; i < job.last; i++)
+	{
+		int nodeIndex = m_instanceNodes[i];
+
+		if (m_visibleBounds[nodeIndex] != 0)
+		{
+			int level = m_sceneNodes[nodeIndex].lodLevel;
+
+			job.visibleNodes[level].PushBack(nodeIndex);
+			job.depths[level] = std::min(job.depths[level], GetViewDepth(glm::vec3(m_nodeSpheres[nodeIndex])));
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildNodeDrawItems()
+ *
+ *  This method is used for building the draw items of a run
+ *  of the nodes that are drawn one at a time.  These are the
+ *  single nodes with instancing and every node without it.
+ *  The sequence numbers follow the node order, so they do
+ *  not depend on how the nodes were split into runs.
+ ***********************************************************/
+void SceneManager::BuildNodeDrawItems(int first, int last, int sequence, FrameArray<RenderQueue::DRAW_ITEM>& items)
+{
+	RenderQueue::DRAW_ITEM item;
+
+	item.staticBatch = -1;
+	item.firstInstance = 0;
+	item.instanceCount = 0;
+	item.lodLevel = 0;
+	item.gpuBucket = -1;
+
+	items.Clear();
+	for (int i = first; i < last; i++)
+	{
+		int nodeIndex = (m_bUseInstancing == true) ? m_singleNodes[i] : i;
+		const SCENE_NODE& node = m_sceneNodes[nodeIndex];
+
+		// group nodes only carry a transformation for their children
+		if ((node.mesh == MESH_NONE) || (node.staticBatch >= 0) || (m_visibleBounds[nodeIndex] == 0))
+		{
+			continue;
+		}
+
+		item.shaderHandle = GetNodeShader(node);
+		item.sortKey = MakeNodeSortKey(node, item.shaderHandle, sequence + i,
+			GetViewDepth(glm::vec3(m_nodeSpheres[nodeIndex])));
+		item.nodeIndex = nodeIndex;
+		items.PushBack(item);
+	}
+}
+
+/***********************************************************
+ *  ResetDrawState()
+ *
+ *  This method is used for forgetting the shader values of
+ *  the last draw, so the next draw sets all of them.
+ ***********************************************************/
+void SceneManager::ResetDrawState()
+{
+	m_drawState.shaderHandle = -1;
+	m_drawState.bValid = false;
+	m_drawState.bColorValid = false;
+	m_drawState.textureSlot = -1;
+	m_drawState.blendTextureSlot = -1;
+	m_drawState.blendFactor = 0.0f;
+	m_drawState.materialIndex = -1;
+}
+
+/***********************************************************
+ *  ApplyDrawState()
+ *
+ *  This method is used for setting the program variant,
+ *  texture/color, material and instancing flag of a draw
+ *  into the shader.  Only the values that differ from the
+ *  previous draw are uploaded.  Uniforms belong to their
+ *  program, so all of them are set again after a switch.
+ ***********************************************************/
+void SceneManager::ApplyDrawState(const SCENE_NODE& node, int shaderHandle, bool bInstanced)
+{
+	bool bUseTexture = (node.textureSlot >= 0);
+	float blendFactor = 0.0f;
+
+	if ((bUseTexture == true) && (node.blendTextureSlot >= 0))
+	{
+		blendFactor = node.blendFactor;
+	}
+
+	if (NULL == m_pShaderUniforms)
+	{
+		return;
+	}
+
+	if ((NULL != m_pShaderVariants) && (m_drawState.shaderHandle != shaderHandle))
+	{
+		m_pShaderVariants->UseVariant(shaderHandle);
+		ResetDrawState();
+		m_drawState.shaderHandle = shaderHandle;
+	}
+
+	if ((m_drawState.bValid == false) || (m_drawState.bInstanced != bInstanced))
+	{
+		m_pShaderUniforms->SetBoolValue(g_UseInstancingName, bInstanced);
+		m_drawState.bInstanced = bInstanced;
+	}
+
+	if ((m_drawState.bValid == false) || (m_drawState.bUseTexture != bUseTexture))
+	{
+		m_pShaderUniforms->SetBoolValue(g_UseTextureName, bUseTexture);
+		m_drawState.bUseTexture = bUseTexture;
+	}
+
+	if (bUseTexture == true)
+	{
+		if (m_drawState.textureSlot != node.textureSlot)
+		{
+			SetShaderTextureSlot(node.textureSlot);
+			m_drawState.textureSlot = node.textureSlot;
+		}
+		if ((blendFactor > 0.0f) && (m_drawState.blendTextureSlot != node.blendTextureSlot))
+		{
+			SetShaderBlendTextureSlot(node.blendTextureSlot);
+			m_drawState.blendTextureSlot = node.blendTextureSlot;
+		}
+	}
+	else
+	{
+		if ((m_drawState.bColorValid == false) || (m_drawState.color != node.color))
+		{
+			m_pShaderUniforms->SetVec4Value(g_ColorValueName, node.color);
+			m_drawState.color = node.color;
+			m_drawState.bColorValid = true;
+		}
+	}
+
+	// the blend factor also turns blending off in the base program
+	if ((m_drawState.bValid == false) || (m_drawState.blendFactor != blendFactor))
+	{
+		m_pShaderUniforms->SetFloatValue(g_BlendFactorName, blendFactor);
+		m_drawState.blendFactor = blendFactor;
+	}
+
+	// nodes without a material keep the last one, as before
+	if ((node.materialIndex >= 0) && (m_drawState.materialIndex != node.materialIndex))
+	{
+		SetShaderMaterial(node.materialIndex);
+		m_drawState.materialIndex = node.materialIndex;
+	}
+
+	m_drawState.bValid = true;
+}
+
+/***********************************************************
+ *  SubmitRenderQueue()
+ *
+ *  This method is used for drawing the sorted items of the
+ *  render queue.  The cached draw state is reset first since
+ *  other code may have changed the shader values in between.
+ *  Opaque items are drawn with blending off, and the sorted
+ *  transparent items after them blend without writing depth
+ *  so they do not hide each other.  Neighbouring instanced
+ *  items that only differ in their mesh or level of detail
+ *  are drawn together with one multi-draw, and the buckets
+ *  of the GPU culler with the commands it wrote.
+ ***********************************************************/
+void SceneManager::SubmitRenderQueue()
+{
+	const FrameArray<RenderQueue::DRAW_ITEM>& items = m_renderQueue.GetItems();
+	bool bBlending = false;
+	bool bMultiDraw = (m_bUseMultiDraw == true) && (m_instancedMeshes->IsMultiDrawSupported() == true);
+
+	ResetDrawState();
+	glDisable(GL_BLEND);
+
+	for (int itemIndex = 0; itemIndex < items.Size(); itemIndex++)
+	{
+		const RenderQueue::DRAW_ITEM& item = items[itemIndex];
+		const SCENE_NODE& node = m_sceneNodes[item.nodeIndex];
+
+		if ((bBlending == false) && (RenderQueue::IsTransparentKey(item.sortKey) == true))
+		{
+			glEnable(GL_BLEND);
+			glDepthMask(GL_FALSE);
+			bBlending = true;
+		}
+
+		ApplyDrawState(node, item.shaderHandle, (item.instanceCount > 0));
+
+		if (item.staticBatch >= 0)
+		{
+			DrawStaticBatch(item);
+		}
+		else if (item.gpuBucket >= 0)
+		{
+			DrawGpuBucket(item);
+		}
+		else if ((item.instanceCount > 0) && (bMultiDraw == true))
+		{
+			// the following runs with the same program and surface
+			// only need a command of their own
+			m_drawCommands.clear();
+			m_drawCommands.push_back(GetInstanceCommand(item));
+			while (((itemIndex + 1) < items.Size()) &&
+				(items[itemIndex + 1].staticBatch < 0) &&
+				(items[itemIndex + 1].gpuBucket < 0) &&
+				(items[itemIndex + 1].instanceCount > 0) &&
+				(items[itemIndex + 1].shaderHandle == item.shaderHandle) &&
+				(IsSameAppearance(m_sceneNodes[items[itemIndex + 1].nodeIndex], node) == true))
+			{
+				itemIndex++;
+				m_drawCommands.push_back(GetInstanceCommand(items[itemIndex]));
+			}
+			m_instancedMeshes->MultiDrawInstanced(m_drawCommands);
+		}
+		else if (item.instanceCount > 0)
+		{
+			DrawInstanceBatch(item);
+		}
+		else
+		{
+			DrawSceneNode(item.nodeIndex);
+		}
+	}
+
+	// later draws outside of the queue keep blending on, as the
+	// display window set it up
+	glEnable(GL_BLEND);
+	glDepthMask(GL_TRUE);
+
+	// and use the model uniform
+	if ((m_drawState.bValid == true) && (m_drawState.bInstanced == true))
+	{
+		m_pShaderUniforms->SetBoolValue(g_UseInstancingName, false);
+	}
+
+	// and the program that the shader manager sets uniforms on
+	if (NULL != m_pShaderVariants)
+	{
+		m_pShaderVariants->UseBaseProgram();
+	}
+}
+
+/***********************************************************
+ *  GetCulledObjectCount()
+ *
+ *  This method is used for getting the number of mesh nodes
+ *  that were skipped by frustum and occlusion culling in the
+ *  last frame.
+ ***********************************************************/
+int SceneManager::GetCulledObjectCount() const
+{
+	return(m_culledObjectCount + m_occludedObjectCount);
+}
+
+/***********************************************************
+ *  GetPendingTextureCount()
+ *
+ *  This method is used for getting the number of texture
+ *  images that are still showing their placeholder.
+ ***********************************************************/
+int SceneManager::GetPendingTextureCount() const
+{
+	return(m_textureLoader->GetPendingCount());
+}
+
+/***********************************************************
+ *  GetRenderOptions()
+ *
+ *  This method is used for getting the switches of the
+ *  rendering optimizations.
+ ***********************************************************/
+SceneManager::RENDER_OPTIONS SceneManager::GetRenderOptions() const
+{
+	RENDER_OPTIONS options;
+
+	options.bStaticBatching = m_bUseStaticBatching;
+	options.bInstancing = m_bUseInstancing;
+	options.bFrustumCulling = m_bUseFrustumCulling;
+	options.bOcclusionCulling = m_bUseOcclusionCulling;
+	options.bLevelOfDetail = m_bUseLevelOfDetail;
+	options.bLightClusters = m_bUseLightClusters;
+	options.bMultithreading = m_jobPool->IsEnabled();
+	options.bMultiDraw = m_bUseMultiDraw;
+	options.bGpuCulling = m_bUseGpuCulling;
+
+	return(options);
+}
+
+/***********************************************************
+ *  SetRenderOptions()
+ *
+ *  This method is used for turning the rendering
+ *  optimizations on and off.  The batches are rebuilt in
+ *  the next RenderScene() when batching or instancing has
+ *  changed.
+ ***********************************************************/
+void SceneManager::SetRenderOptions(const RENDER_OPTIONS& options)
+{
+	if ((options.bStaticBatching != m_bUseStaticBatching) || (options.bInstancing != m_bUseInstancing))
+	{
+		m_bStaticBatchesDirty = true;
+	}
+
+	m_bUseStaticBatching = options.bStaticBatching;
+	m_bUseInstancing = options.bInstancing;
+	m_bUseFrustumCulling = options.bFrustumCulling;
+	m_bUseOcclusionCulling = options.bOcclusionCulling;
+	m_bUseLevelOfDetail = options.bLevelOfDetail;
+	m_bUseLightClusters = options.bLightClusters;
+	m_jobPool->SetEnabled(options.bMultithreading);
+	m_bUseMultiDraw = options.bMultiDraw;
+	m_bUseGpuCulling = options.bGpuCulling;
+}
+
+/***********************************************************
+ *  SetShaderVariants()
+ *
+ *  This method is used for drawing the scene with program
+ *  variants that are built for the features of each draw
+ *  item, instead of switching features with uniforms.
+ ***********************************************************/
+void SceneManager::SetShaderVariants(ShaderVariants* pShaderVariants)
+{
+	m_pShaderVariants = pShaderVariants;
+}
+
+/***********************************************************
+ *  SetFrameProfiler()
+ *
+ *  This method is used for timing the update, culling and
+ *  draw passes of RenderScene() as scopes of a profiler.
+ ***********************************************************/
+void SceneManager::SetFrameProfiler(FrameProfiler* pFrameProfiler)
+{
+	m_pFrameProfiler = pFrameProfiler;
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+
+//Used to load textures into memory for the scene.
+void SceneManager::LoadSceneTextures()
+{
+	bool bReturn = false;
+
+	//fan texture
+	bReturn = CreateGLTexture("textures/black plastic.jpg", "blackPlastic");
+	//Stand texture
+	bReturn = CreateGLTexture("textures/wood.jpg", "stand");
+	//fan blade texture
+	bReturn = CreateGLTexture("textures/fanblade.jpg", "blade");
+	//wall texture
+	bReturn = CreateGLTexture("textures/wall.jpg", "wall");
+	//motherboard texture
+	bReturn = CreateGLTexture("textures/microchip.jpg", "chip");
+	//gpu texture
+	bReturn = CreateGLTexture("textures/gpu.jpg", "gpu");
+
+
+
+	BindGLTextures();
+
+}
+
+
+//*************DefineObjects********************//
+void SceneManager::DefineObjectMaterials()
+{
+
+	OBJECT_MATERIAL plasticMaterial;
+	plasticMaterial.diffuseColor = glm::vec3(5.0f, 5.0f, 5.0f);
+	plasticMaterial.specularColor = glm::vec3(5.0f, 5.0f, 5.0f);
+	plasticMaterial.shininess = 30.0;
+	plasticMaterial.tag = "plastic";
+
+	AddObjectMaterial(plasticMaterial);
+
+	OBJECT_MATERIAL woodMaterial;
+	woodMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.3f);
+	woodMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	woodMaterial.shininess = 0.1;
+	woodMaterial.tag = "wood";
+
+	AddObjectMaterial(woodMaterial);
+
+	OBJECT_MATERIAL middleMaterial;
+	middleMaterial.diffuseColor = glm::vec3(.0f, 0.0f, 0.0f);
+	middleMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	middleMaterial.shininess = 5.0;
+	middleMaterial.tag = "middle";
+
+	AddObjectMaterial(middleMaterial);
+	
+
+	//mootherboard material
+	OBJECT_MATERIAL motherMaterial;
+	motherMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.3f);
+	motherMaterial.specularColor = glm::vec3(0.0f, 0.0f, 0.0f);
+	motherMaterial.shininess = 20.03;
+	motherMaterial.tag = "mother";
+
+	AddObjectMaterial(motherMaterial);
+	
+	//glass panels
+	OBJECT_MATERIAL glassMaterial;
+	glassMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	glassMaterial.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	glassMaterial.shininess = 95.0;
+	glassMaterial.tag = "glass";
+
+	AddObjectMaterial(glassMaterial);
+
+}
+
+void SceneManager::SetupSceneLights()
+{
+
+		m_pShaderManager->setBoolValue(g_UseLightingName, true);
+		m_bUseLighting = true;
+
+	m_pointLights.clear();
+
+	//main light
+	AddPointLight(glm::vec3(-4.0f, 8.0f, 5.0f),
+		glm::vec3(0.5f, 0.5f, 0.5f), glm::vec3(0.3f, 0.3f, 0.3f), glm::vec3(0.1f, 0.1f, 0.1f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 1
+	AddPointLight(glm::vec3(4.0f, 11.5f, -3.0f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(.4f, .4f, .4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 2
+	AddPointLight(glm::vec3(4.0f, 7.25f, -3.0f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(0.4f, 0.4f, 0.4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 3
+	AddPointLight(glm::vec3(4.0f, 3.0f, -3.0f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(0.4f, 0.4f, 0.4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 4
+	AddPointLight(glm::vec3(-7.0f, 11.5f, 0.5f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(0.4f, 0.4f, 0.4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 5
+	AddPointLight(glm::vec3(-3.5f, 13.0f, 0.5f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(0.4f, 0.4f, 0.4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	//fan light 6
+	AddPointLight(glm::vec3(1.0f, 13.0f, 0.5f),
+		glm::vec3(.01f, .01f, .01f), glm::vec3(0.4f, 0.4f, 0.4f), glm::vec3(.0f, .0f, .0f),
+		1.0f, 0.09f, 0.032f);
+
+	// all of the lights are sent to the shader with one upload
+	UploadSceneLights();
+}
+
+/***********************************************************
+ *  LoadFileTextures()
+ *
+ *  This method is used for loading the textures listed in
+ *  the scene file.  A tag that is already loaded keeps its
+ *  slot, and its image is only loaded again into the same
+ *  slot when the file name has changed.
+ ***********************************************************/
+void SceneManager::LoadFileTextures()
+{
+	const SceneFile::FILE_TEXTURE* pTextures = m_sceneFile.GetTextures();
+
+	for (int i = 0; i < m_sceneFile.GetTextureCount(); i++)
+	{
+		int textureSlot = FindTextureSlot(pTextures[i].tag);
+
+		if (textureSlot < 0)
+		{
+			CreateGLTexture(pTextures[i].filename, pTextures[i].tag);
+		}
+		else if (m_textureIDs[textureSlot].filename != pTextures[i].filename)
+		{
+			m_textureIDs[textureSlot].filename = pTextures[i].filename;
+			m_textureLoader->QueueTexture(pTextures[i].filename, (int)m_textureIDs[textureSlot].ID);
+			if (NULL != m_fileWatcher)
+			{
+				m_fileWatcher->WatchFile(pTextures[i].filename);
+			}
+		}
+	}
+
+	BindGLTextures();
+}
+
+/***********************************************************
+ *  DefineFileMaterials()
+ *
+ *  This method is used for defining the materials listed in
+ *  the scene file.  A tag that is already defined keeps its
+ *  handle and takes the values of the file.
+ ***********************************************************/
+void SceneManager::DefineFileMaterials()
+{
+	const SceneFile::FILE_MATERIAL* pMaterials = m_sceneFile.GetMaterials();
+
+	for (int i = 0; i < m_sceneFile.GetMaterialCount(); i++)
+	{
+		OBJECT_MATERIAL material;
+
+		material.diffuseColor = glm::vec3(pMaterials[i].diffuseColor[0], pMaterials[i].diffuseColor[1], pMaterials[i].diffuseColor[2]);
+		material.specularColor = glm::vec3(pMaterials[i].specularColor[0], pMaterials[i].specularColor[1], pMaterials[i].specularColor[2]);
+		material.shininess = pMaterials[i].shininess;
+		material.tag = pMaterials[i].tag;
+
+		int materialIndex = FindMaterialIndex(material.tag);
+		if (materialIndex >= 0)
+		{
+			m_objectMaterials[materialIndex] = material;
+		}
+		else
+		{
+			AddObjectMaterial(material);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetupFileLights()
+ *
+ *  This method is used for turning on the lighting and
+ *  adding the point lights listed in the scene file.
+ ***********************************************************/
+void SceneManager::SetupFileLights()
+{
+	const SceneFile::FILE_LIGHT* pLights = m_sceneFile.GetLights();
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setBoolValue(g_UseLightingName, true);
+	}
+	m_bUseLighting = true;
+
+	m_pointLights.clear();
+	for (int i = 0; i < m_sceneFile.GetLightCount(); i++)
+	{
+		const SceneFile::FILE_LIGHT& light = pLights[i];
+
+		AddPointLight(
+			glm::vec3(light.position[0], light.position[1], light.position[2]),
+			glm::vec3(light.ambient[0], light.ambient[1], light.ambient[2]),
+			glm::vec3(light.diffuse[0], light.diffuse[1], light.diffuse[2]),
+			glm::vec3(light.specular[0], light.specular[1], light.specular[2]),
+			light.constant,
+			light.linear,
+			light.quadratic);
+	}
+
+	// all of the lights are sent to the shader with one upload
+	UploadSceneLights();
+}
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ ***********************************************************/
+void SceneManager::PrepareScene()
+{
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene
+	// the stress scene is built from the textures and materials
+	// of the normal scene
+	bool bSceneFile = (m_bUseSceneFile == true) && (m_stressObjectCount == 0);
+
+	if (bSceneFile == true)
+	{
+		LoadFileTextures();
+		DefineFileMaterials();
+	}
+	else
+	{
+		LoadSceneTextures();
+		DefineObjectMaterials();
+	}
+	UploadMaterials();
+
+	// the texture arrays, the point lights, the materials and the
+	// cluster light lists are read from fixed texture units
+	if (NULL != m_pShaderVariants)
+	{
+		for (int i = 0; i < TEXTURE_ARRAY_UNITS; i++)
+		{
+			m_pShaderVariants->SetProgramInt(std::string(g_TextureArraysName) + "[" + std::to_string(i) + "]", i);
+		}
+		m_pShaderVariants->SetProgramInt(g_ClusterGridName, CLUSTER_GRID_TEXTURE_UNIT);
+		m_pShaderVariants->SetProgramInt(g_ClusterIndicesName, CLUSTER_INDEX_TEXTURE_UNIT);
+		m_pShaderVariants->SetProgramInt(g_PointLightDataName, POINT_LIGHT_TEXTURE_UNIT);
+		m_pShaderVariants->SetProgramInt(g_MaterialDataName, MATERIAL_TEXTURE_UNIT);
+	}
+	else if (NULL != m_pShaderUniforms)
+	{
+		for (int i = 0; i < TEXTURE_ARRAY_UNITS; i++)
+		{
+			m_pShaderUniforms->SetIntValue(std::string(g_TextureArraysName) + "[" + std::to_string(i) + "]", i);
+		}
+		m_pShaderUniforms->SetIntValue(g_ClusterGridName, CLUSTER_GRID_TEXTURE_UNIT);
+		m_pShaderUniforms->SetIntValue(g_ClusterIndicesName, CLUSTER_INDEX_TEXTURE_UNIT);
+		m_pShaderUniforms->SetIntValue(g_PointLightDataName, POINT_LIGHT_TEXTURE_UNIT);
+		m_pShaderUniforms->SetIntValue(g_MaterialDataName, MATERIAL_TEXTURE_UNIT);
+	}
+
+	if (bSceneFile == true)
+	{
+		SetupFileLights();
+	}
+	else
+	{
+		SetupSceneLights();
+	}
+
+	m_basicMeshes->LoadPlaneMesh();
+	m_basicMeshes->LoadBoxMesh();
+	m_basicMeshes->LoadCylinderMesh();
+	m_basicMeshes->LoadSphereMesh();
+	m_basicMeshes->LoadTorusMesh();
+	m_basicMeshes->LoadExtraTorusMesh1();
+	m_basicMeshes->LoadExtraTorusMesh2();
+
+	// the repeated shapes are drawn through instanced copies
+	// of the box, cylinder and sphere meshes
+	m_instancedMeshes->LoadBoxMesh();
+	m_instancedMeshes->LoadCylinderMesh();
+	m_instancedMeshes->LoadSphereMesh();
+
+	// the scene layout never changes, so the node list and
+	// all of its world matrices are only built once, and the
+	// nodes that never move are baked into static batches
+	if (m_stressObjectCount > 0)
+	{
+		BuildStressScene();
+	}
+	else if (bSceneFile == true)
+	{
+		BuildFileSceneNodes();
+	}
+	else
+	{
+		BuildSceneNodes();
+	}
+	UpdateSceneTransforms();
+	BuildStaticBatches();
+	BuildInstanceBatches();
+	BuildOcclusionGroups();
+}
+
+/***********************************************************
+ *  BuildSceneNodes()
+ *
+ *  This method is used for building the retained list of
+ *  scene nodes.  Each node stores the mesh to draw and its
+ *  texture or color and material, and its world matrix is
+ *  kept by the transform system, so nothing needs to be
+ *  recalculated per frame.
+ ***********************************************************/
+void SceneManager::BuildSceneNodes()
+{
+	m_sceneNodes.clear();
+	m_transforms.Clear();
+
+	// stand for the computer to rest on
+	SetNodeTexture("stand");
+	SetNodeMaterial("wood");
+	AddSceneNode(MESH_BOX, glm::vec3(20.0f, 1.0f, 15.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, 0.0f));
+
+	// wall behind the computer
+	SetNodeTexture("wall");
+	AddSceneNode(MESH_PLANE, glm::vec3(20.0f, 1.0f, 25.0f), 90.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, -10.0f));
+
+	// the computer parts are top level nodes of the scene
+	m_fanNodes.clear();
+	AddComputerAssembly();
+}
+
+/***********************************************************
+ *  BuildFileSceneNodes()
+ *
+ *  This method is used for building the retained scene
+ *  nodes from the node records of the scene file.  The
+ *  records are used where they are, mapped or parsed, and
+ *  their texture and material indices are turned into the
+ *  slots and handles they were loaded into.
+ ***********************************************************/
+void SceneManager::BuildFileSceneNodes()
+{
+	const SceneFile::FILE_NODE* pNodes = m_sceneFile.GetNodes();
+	int nodeCount = m_sceneFile.GetNodeCount();
+	int parentIndex = m_nodeState.parentIndex;
+	bool bStatic = m_nodeState.bStatic;
+	std::vector<int> textureSlots;
+	std::vector<int> materialIndices;
+
+	ResolveFileRecords(textureSlots, materialIndices);
+
+	m_sceneNodes.clear();
+	m_transforms.Clear();
+	m_fanNodes.clear();
+	m_sceneNodes.reserve(nodeCount);
+	m_transforms.Reserve(nodeCount);
+
+	// the scene starts out empty, so the node indices of the
+	// file are the scene node indices
+	for (int i = 0; i < nodeCount; i++)
+	{
+		const SceneFile::FILE_NODE& node = pNodes[i];
+
+		SetFileNodeState(node, textureSlots, materialIndices);
+		AddSceneNode((MESH_TYPE)node.mesh,
+			glm::vec3(node.scale[0], node.scale[1], node.scale[2]),
+			node.rotation[0], node.rotation[1], node.rotation[2],
+			glm::vec3(node.position[0], node.position[1], node.position[2]));
+	}
+
+	m_nodeState.parentIndex = parentIndex;
+	m_nodeState.bStatic = bStatic;
+}
+
+/***********************************************************
+ *  ResolveFileRecords()
+ *
+ *  This method is used for getting the texture slot of each
+ *  texture record and the material handle of each material
+ *  record of the scene file, which the node records refer
+ *  to by index.
+ ***********************************************************/
+void SceneManager::ResolveFileRecords(std::vector<int>& textureSlots, std::vector<int>& materialIndices) const
+{
+	const SceneFile::FILE_TEXTURE* pTextures = m_sceneFile.GetTextures();
+	const SceneFile::FILE_MATERIAL* pMaterials = m_sceneFile.GetMaterials();
+
+	textureSlots.resize(m_sceneFile.GetTextureCount());
+	materialIndices.resize(m_sceneFile.GetMaterialCount());
+
+	for (int i = 0; i < (int)textureSlots.size(); i++)
+	{
+		textureSlots[i] = FindTextureSlot(pTextures[i].tag);
+	}
+	for (int i = 0; i < (int)materialIndices.size(); i++)
+	{
+		materialIndices[i] = FindMaterialIndex(pMaterials[i].tag);
+	}
+}
+
+/***********************************************************
+ *  SetFileNodeState()
+ *
+ *  This method is used for setting the parent, texture or
+ *  color, material and static flag of the node state from a
+ *  node record of the scene file.
+ ***********************************************************/
+void SceneManager::SetFileNodeState(
+	const SceneFile::FILE_NODE& node,
+	const std::vector<int>& textureSlots,
+	const std::vector<int>& materialIndices)
+{
+	m_nodeState.parentIndex = node.parentIndex;
+	m_nodeState.textureSlot = (node.textureIndex >= 0) ? textureSlots[node.textureIndex] : -1;
+	m_nodeState.blendTextureSlot = (node.blendTextureIndex >= 0) ? textureSlots[node.blendTextureIndex] : -1;
+	m_nodeState.blendFactor = node.blendFactor;
+	m_nodeState.color = glm::vec4(node.color[0], node.color[1], node.color[2], node.color[3]);
+	m_nodeState.materialIndex = (node.materialIndex >= 0) ? materialIndices[node.materialIndex] : -1;
+	m_nodeState.bStatic = (node.bStatic != 0);
+}
+
+/***********************************************************
+ *  UpdateFileSceneNodes()
+ *
+ *  This method is used for changing the scene nodes to match
+ *  the node records of an edited scene file without building
+ *  them again.  Only the nodes whose values differ are
+ *  touched, so a moved node only composes its own matrices
+ *  and a static one only marks the batches for rebuilding.
+ *  Returns false, with nothing changed, when the records no
+ *  longer have the same meshes and parents as the nodes.
+ ***********************************************************/
+bool SceneManager::UpdateFileSceneNodes()
+{
+	const SceneFile::FILE_NODE* pNodes = m_sceneFile.GetNodes();
+	int nodeCount = m_sceneFile.GetNodeCount();
+	int parentIndex = m_nodeState.parentIndex;
+	bool bStatic = m_nodeState.bStatic;
+	std::vector<int> textureSlots;
+	std::vector<int> materialIndices;
+
+	if (nodeCount != (int)m_sceneNodes.size())
+	{
+		return(false);
+	}
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if ((pNodes[i].mesh != (int32_t)m_sceneNodes[i].mesh) || (pNodes[i].parentIndex != m_sceneNodes[i].parentIndex))
+		{
+			return(false);
+		}
+	}
+
+	ResolveFileRecords(textureSlots, materialIndices);
+
+	for (int i = 0; i < nodeCount; i++)
+	{
+		const SceneFile::FILE_NODE& record = pNodes[i];
+		SCENE_NODE& node = m_sceneNodes[i];
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+
+		SetFileNodeState(record, textureSlots, materialIndices);
+		if ((m_nodeState.textureSlot != node.textureSlot) ||
+			(m_nodeState.blendTextureSlot != node.blendTextureSlot) ||
+			(m_nodeState.blendFactor != node.blendFactor) ||
+			(m_nodeState.color != node.color) ||
+			(m_nodeState.materialIndex != node.materialIndex) ||
+			(m_nodeState.bStatic != node.bStatic))
+		{
+			// a node can fall into another batch, or leave the
+			// static ones, so the batches are built again
+			node.textureSlot = m_nodeState.textureSlot;
+			node.blendTextureSlot = m_nodeState.blendTextureSlot;
+			node.blendFactor = m_nodeState.blendFactor;
+			node.color = m_nodeState.color;
+			node.materialIndex = m_nodeState.materialIndex;
+			node.bStatic = m_nodeState.bStatic;
+			if (node.mesh != MESH_NONE)
+			{
+				m_usedFeatureSets |= 1 << GetNodeFeatureSet(node);
+			}
+			m_bStaticBatchesDirty = true;
+		}
+
+		m_transforms.GetTransform(i, scaleXYZ, rotationDegrees, positionXYZ);
+		if ((scaleXYZ != glm::vec3(record.scale[0], record.scale[1], record.scale[2])) ||
+			(rotationDegrees != glm::vec3(record.rotation[0], record.rotation[1], record.rotation[2])) ||
+			(positionXYZ != glm::vec3(record.position[0], record.position[1], record.position[2])))
+		{
+			SetNodeTransformations(i,
+				glm::vec3(record.scale[0], record.scale[1], record.scale[2]),
+				record.rotation[0], record.rotation[1], record.rotation[2],
+				glm::vec3(record.position[0], record.position[1], record.position[2]));
+		}
+	}
+
+	m_nodeState.parentIndex = parentIndex;
+	m_nodeState.bStatic = bStatic;
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddComputerAssembly()
+ *
+ *  This method is used for adding the computer case with its
+ *  fans, motherboard, GPU, RAM and CPU cooler to the retained
+ *  scene.  The parts are added under the current parent
+ *  node, so a group node placed before the call moves the
+ *  whole computer.
+ ***********************************************************/
+void SceneManager::AddComputerAssembly()
+{
+	//****** Computer Fans ******//
+	// the fan is defined once in AddComputerFan() and placed
+	// with a single parent transformation per copy
+	// three fans on the back panel
+	m_fanNodes.push_back(AddComputerFan(0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 11.5f, -2.5f)));
+	m_fanNodes.push_back(AddComputerFan(0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 7.25f, -2.5f)));
+	m_fanNodes.push_back(AddComputerFan(0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 3.0f, -2.5f)));
+	// one fan on the side panel
+	m_fanNodes.push_back(AddComputerFan(0.0f, 90.0f, 0.0f, glm::vec3(-6.5f, 11.5f, 0.5f)));
+	// two fans on the top panel
+	m_fanNodes.push_back(AddComputerFan(90.0f, 90.0f, 0.0f, glm::vec3(-3.5f, 13.5f, 0.5f)));
+	m_fanNodes.push_back(AddComputerFan(90.0f, 90.0f, 0.0f, glm::vec3(1.0f, 13.5f, 0.5f)));
+
+	//**************Case************//
+	SetNodeTexture("blackPlastic");
+	AddSceneNode(MESH_BOX, glm::vec3(14.0f, 13.0f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 7.5f, -3.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(14.0f, 0.1f, 6.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 14.0f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.1f, 13.0f, 6.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-7.0f, 7.5f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(14.0f, 0.1f, 6.0f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.5f, 0.5f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(-6.0f, 0.75f, 2.9f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.5f, 0.5f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(6.0f, 0.75f, 2.9f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.5f, 0.5f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(6.0f, 0.75f, -2.9f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.5f, 0.5f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(-6.0f, 0.75f, -2.9f));
+	AddSceneNode(MESH_BOX, glm::vec3(8.5f, 3.0f, 5.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.7f, 2.5f, -0.5f));
+
+	//***********MotherBoard*********//
+	SetNodeTexture("chip");
+	SetNodeMaterial("mother");
+	AddSceneNode(MESH_BOX, glm::vec3(8.0f, 9.0f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.5f, 9.0f, -2.8f));
+
+	//*******GPU*************//
+	SetNodeTexture("gpu");
+	SetNodeMaterial("plastic");
+	AddSceneNode(MESH_BOX, glm::vec3(8.5f, 1.5f, 3.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.75f, 6.0f, -1.0f));
+
+	//**********RAM*******************//
+	SetNodeTexture("blackPlastic");
+	AddSceneNode(MESH_BOX, glm::vec3(0.3f, 4.0f, 1.5f), 0.0f, 0.0f, 0.0f, glm::vec3(-0.5f, 9.0f, -2.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.3f, 4.0f, 1.5f), 0.0f, 0.0f, 0.0f, glm::vec3(0.5f, 9.0f, -2.0f));
+	SetNodeColor(1.0f, 1.0f, 1.0f, 1.0f);
+	AddSceneNode(MESH_BOX, glm::vec3(0.3f, 4.0f, 0.3f), 0.0f, 0.0f, 0.0f, glm::vec3(-0.5f, 9.0f, -1.1f));
+	SetNodeColor(1.1f, 1.1f, 1.1f, 1.0f);
+	AddSceneNode(MESH_BOX, glm::vec3(0.3f, 4.0f, 0.3f), 0.0f, 0.0f, 0.0f, glm::vec3(0.5f, 9.0f, -1.1f));
+
+	//************CPU fan**********//
+	SetNodeColor(0.01f, 0.01f, 0.01f, 1.0f);
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.85f, 2.0f, 0.85f), 90.0f, 0.0f, 0.0f, glm::vec3(-3.0f, 9.5f, -2.75f));
+	SetNodeTexture("blackPlastic");
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.4f, 2.0f, 0.4f), 90.0f, 0.0f, 0.0f, glm::vec3(-3.0f, 9.5f, -2.55f));
+	AddSceneNode(MESH_TORUS, glm::vec3(1.0f, 1.0f, 4.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-3.0f, 9.5f, -1.75f));
+
+	///**********Middle bars of CPU**************///
+	SetNodeTexture("blade");
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 0.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 10.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 20.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 30.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 40.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 50.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 60.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 70.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 80.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 90.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 100.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 110.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 120.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 130.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 140.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 150.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 160.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+	AddSceneNode(MESH_BOX, glm::vec3(1.75f, 0.02f, 0.2f), 0.0f, 0.0f, 170.0f, glm::vec3(-3.0f, 9.5f, -0.75f));
+
+	//***************cooling tube************************//
+	SetNodeColor(0.01f, 0.01f, 0.01f, 1.0f);
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 1.0f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(-3.0f, 7.5f, -2.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 1.0f, 0.5f), 90.0f, 40.0f, 0.0f, glm::vec3(-3.0f, 7.5f, -2.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.5f, 0.5f, 0.5f), 90.0f, 40.0f, 0.0f, glm::vec3(-3.0f, 7.5f, -2.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 1.75f, 0.5f), 90.0f, 40.0f, 0.0f, glm::vec3(-2.4f, 7.5f, -1.3f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 2.9f, 0.5f), 90.0f, 90.0f, 0.0f, glm::vec3(-1.4f, 7.5f, 0.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.5f, 0.5f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(-1.33f, 7.5f, 0.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 1.0f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 13.0f, 0.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 3.0f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 10.0f, 0.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 1.0f, 0.5f), 45.0f, 90.0f, 0.0f, glm::vec3(3.2f, 9.25f, 0.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.5f, 0.5f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(4.0f, 10.0f, 0.0f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.5f, 2.75f, 0.5f), 45.0f, 90.0f, 0.0f, glm::vec3(1.45f, 7.5f, 0.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.5f, 0.5f, 0.5f), 0.0f, 0.0f, 0.0f, glm::vec3(1.45f, 7.5f, 0.0f));
+
+	//********************Glass panels********************//
+	// the render queue draws them after the opaque parts
+	SetNodeColor(0.1f, 0.1f, 0.1f, 0.2f);
+	SetNodeMaterial("glass");
+	AddSceneNode(MESH_BOX, glm::vec3(14.0f, 13.0f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 7.5f, 3.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.1f, 13.0f, 6.0f), 0.0f, 0.0f, 0.0f, glm::vec3(7.0f, 7.5f, 0.0f));
+}
+
+/***********************************************************
+ *  SetStressScene()
+ *
+ *  This method is used for replacing the scene with a grid
+ *  of computers of about the passed in number of mesh nodes,
+ *  lit by the passed in number of point lights.  It must be
+ *  called before PrepareScene(), and a light count of 0
+ *  keeps the lights of the normal scene.
+ ***********************************************************/
+void SceneManager::SetStressScene(int objectCount, int lightCount)
+{
+	m_stressObjectCount = std::min(std::max(objectCount, 0), g_MaxStressObjects);
+	m_stressLightCount = std::min(std::max(lightCount, 0), MAX_POINT_LIGHTS);
+}
+
+/***********************************************************
+ *  LoadSceneFile()
+ *
+ *  This method is used for loading a scene file that
+ *  replaces the textures, materials, lights and nodes of the
+ *  normal scene.  A binary scene file is only mapped here,
+ *  and its records are read in place by PrepareScene().
+ ***********************************************************/
+bool SceneManager::LoadSceneFile(const std::string& filename)
+{
+	m_bUseSceneFile = m_sceneFile.Load(filename);
+
+	if (m_bUseSceneFile == true)
+	{
+		m_sceneFilename = filename;
+		if (NULL != m_fileWatcher)
+		{
+			m_fileWatcher->WatchFile(filename);
+		}
+
+		std::cout << "INFO: scene file " << filename << " with " << m_sceneFile.GetNodeCount()
+			<< " nodes and " << m_sceneFile.GetLightCount() << " point lights" << std::endl;
+	}
+
+	return(m_bUseSceneFile);
+}
+
+/***********************************************************
+ *  SaveSceneFile()
+ *
+ *  This method is used for writing the textures, materials,
+ *  lights and nodes of the prepared scene to a scene file,
+ *  so a built in or generated scene can be edited or loaded
+ *  without building it again.
+ ***********************************************************/
+bool SceneManager::SaveSceneFile(const std::string& filename) const
+{
+	SceneFile sceneFile;
+
+	// the texture slots and material handles are the indices
+	// of the records, so the node indices carry over as they are
+	for (const TEXTURE_INFO& texture : m_textureIDs)
+	{
+		sceneFile.AddTexture(texture.tag, texture.filename);
+	}
+
+	for (const OBJECT_MATERIAL& material : m_objectMaterials)
+	{
+		SceneFile::FILE_MATERIAL fileMaterial;
+
+		SceneFile::CopyName(fileMaterial.tag, SceneFile::MAX_TAG_LENGTH, material.tag);
+		for (int i = 0; i < 3; i++)
+		{
+			fileMaterial.diffuseColor[i] = material.diffuseColor[i];
+			fileMaterial.specularColor[i] = material.specularColor[i];
+		}
+		fileMaterial.shininess = material.shininess;
+		sceneFile.AddMaterial(fileMaterial);
+	}
+
+	for (const ShaderUniforms::POINT_LIGHT& light : m_pointLights)
+	{
+		SceneFile::FILE_LIGHT fileLight;
+
+		for (int i = 0; i < 3; i++)
+		{
+			fileLight.position[i] = light.position[i];
+			fileLight.ambient[i] = light.ambient[i];
+			fileLight.diffuse[i] = light.diffuse[i];
+			fileLight.specular[i] = light.specular[i];
+		}
+		fileLight.constant = light.constant;
+		fileLight.linear = light.linear;
+		fileLight.quadratic = light.quadratic;
+		sceneFile.AddLight(fileLight);
+	}
+
+	for (int nodeIndex = 0; nodeIndex < (int)m_sceneNodes.size(); nodeIndex++)
+	{
+		const SCENE_NODE& node = m_sceneNodes[nodeIndex];
+		SceneFile::FILE_NODE fileNode;
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+
+		m_transforms.GetTransform(nodeIndex, scaleXYZ, rotationDegrees, positionXYZ);
+		fileNode.mesh = (int32_t)node.mesh;
+		fileNode.parentIndex = node.parentIndex;
+		for (int i = 0; i < 3; i++)
+		{
+			fileNode.scale[i] = scaleXYZ[i];
+			fileNode.rotation[i] = rotationDegrees[i];
+			fileNode.position[i] = positionXYZ[i];
+		}
+		fileNode.textureIndex = node.textureSlot;
+		fileNode.blendTextureIndex = node.blendTextureSlot;
+		fileNode.blendFactor = node.blendFactor;
+		for (int i = 0; i < 4; i++)
+		{
+			fileNode.color[i] = node.color[i];
+		}
+		fileNode.materialIndex = node.materialIndex;
+		fileNode.bStatic = (node.bStatic == true) ? 1 : 0;
+		sceneFile.AddNode(fileNode);
+	}
+
+	return(sceneFile.Save(filename));
+}
+
+/***********************************************************
+ *  EnableHotReload()
+ *
+ *  This method is used for watching the shader files, the
+ *  texture images and the scene file for edits.  Every
+ *  RenderScene() then applies the edited files to the
+ *  running scene, and textures loaded later are watched as
+ *  well.
+ ***********************************************************/
+void SceneManager::EnableHotReload()
+{
+	if (NULL != m_fileWatcher)
+	{
+		return;
+	}
+
+	m_fileWatcher = new FileWatcher(g_HotReloadCheckMilliseconds);
+
+	if (NULL != m_pShaderVariants)
+	{
+		m_fileWatcher->WatchFile(m_pShaderVariants->GetVertexShaderPath());
+		m_fileWatcher->WatchFile(m_pShaderVariants->GetFragmentShaderPath());
+	}
+	for (const TEXTURE_INFO& texture : m_textureIDs)
+	{
+		m_fileWatcher->WatchFile(texture.filename);
+	}
+	if (m_sceneFilename.empty() == false)
+	{
+		m_fileWatcher->WatchFile(m_sceneFilename);
+	}
+
+	std::cout << "INFO: watching " << m_fileWatcher->GetCount() << " files for hot reloading" << std::endl;
+}
+
+/***********************************************************
+ *  EnableGpuCulling()
+ *
+ *  This method is used for moving the culling, level of
+ *  detail selection and draw commands of the instanced
+ *  shapes to a compute shader.  Drivers without compute
+ *  shaders and storage buffers, or a shader that does not
+ *  build, leave them on the CPU.
+ ***********************************************************/
+bool SceneManager::EnableGpuCulling(const char* computeShaderPath)
+{
+	if (NULL != m_gpuCuller)
+	{
+		return(true);
+	}
+
+	if (GpuCuller::IsSupported() == false)
+	{
+		std::cout << "INFO: no compute shader support, the instanced shapes are culled on the CPU" << std::endl;
+		return(false);
+	}
+
+	m_gpuCuller = new GpuCuller();
+	if (m_gpuCuller->LoadShader(computeShaderPath) == false)
+	{
+		std::cout << "Could not build the culling compute shader, the instanced shapes are culled on the CPU" << std::endl;
+		delete m_gpuCuller;
+		m_gpuCuller = NULL;
+		return(false);
+	}
+
+	BuildGpuBuckets();
+
+	std::cout << "INFO: culling " << m_gpuObjectNodes.size() << " instanced shapes on the GPU in "
+		<< m_gpuBuckets.size() << " buckets" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  ReloadChangedFiles()
+ *
+ *  This method is used for applying the watched files that
+ *  were edited since the last check.  An image is decoded
+ *  again on the texture loader threads and replaces the old
+ *  one in the same slot, the shaders are rebuilt and
+ *  swapped in, and a scene file is applied to the nodes.
+ ***********************************************************/
+void SceneManager::ReloadChangedFiles()
+{
+	std::vector<int> changedFiles;
+	bool bShadersChanged = false;
+
+	if ((NULL == m_fileWatcher) || (m_fileWatcher->CheckFiles(changedFiles) == false))
+	{
+		return;
+	}
+
+	for (int handle : changedFiles)
+	{
+		// a copy, since the scene file can add watched textures
+		std::string filename = m_fileWatcher->GetFilename(handle);
+
+		if ((NULL != m_pShaderVariants) &&
+			((filename == m_pShaderVariants->GetVertexShaderPath()) || (filename == m_pShaderVariants->GetFragmentShaderPath())))
+		{
+			bShadersChanged = true;
+		}
+		if (filename == m_sceneFilename)
+		{
+			ReloadSceneFile();
+		}
+		for (const TEXTURE_INFO& texture : m_textureIDs)
+		{
+			if (texture.filename == filename)
+			{
+				std::cout << "INFO: reloading texture " << texture.tag << " from " << filename << std::endl;
+				m_textureLoader->QueueTexture(filename.c_str(), (int)texture.ID);
+			}
+		}
+	}
+
+	if ((bShadersChanged == true) && (m_pShaderVariants->ReloadShaderSources() == true))
+	{
+		// the new base program starts with the default values of
+		// the uniforms that are only set through the shader manager
+		if (NULL != m_pShaderManager)
+		{
+			m_pShaderVariants->UseBaseProgram();
+			m_pShaderManager->setBoolValue(g_UseLightingName, m_bUseLighting);
+		}
+		// and the per draw values are all sent again
+		ResetDrawState();
+	}
+}
+
+/***********************************************************
+ *  ReloadSceneFile()
+ *
+ *  This method is used for applying an edited scene file.
+ *  New textures are loaded and the materials and lights are
+ *  uploaded again.  The nodes are changed in place when the
+ *  file still has the same node hierarchy, and are built
+ *  again with their batches and groups when it does not.
+ *  A file that does not load leaves the scene as it was.
+ ***********************************************************/
+void SceneManager::ReloadSceneFile()
+{
+	// the stress scene is generated instead of read from the file
+	if ((m_bUseSceneFile == false) || (m_stressObjectCount > 0))
+	{
+		return;
+	}
+
+	if (m_sceneFile.Load(m_sceneFilename) == false)
+	{
+		std::cout << "Could not reload scene file:" << m_sceneFilename << std::endl;
+		return;
+	}
+
+	LoadFileTextures();
+	DefineFileMaterials();
+	UploadMaterials();
+	SetupFileLights();
+
+	if (UpdateFileSceneNodes() == false)
+	{
+		BuildFileSceneNodes();
+		UpdateSceneTransforms();
+		BuildStaticBatches();
+		BuildInstanceBatches();
+		BuildOcclusionGroups();
+	}
+
+	std::cout << "INFO: reloaded scene file " << m_sceneFilename << std::endl;
+}
+
+/***********************************************************
+ *  BuildStressScene()
+ *
+ *  This method is used for building a square grid of copies
+ *  of the computer on one large stand.  Every computer is
+ *  the subtree of its own group node, so the copies are
+ *  culled and occlusion tested like the fans of the normal
+ *  scene.  Copies are added until the scene has at least
+ *  the requested number of mesh nodes.
+ ***********************************************************/
+void SceneManager::BuildStressScene()
+{
+	int parentIndex = m_nodeState.parentIndex;
+	int nodesPerComputer = 0;
+	int computerCount = 1;
+	int gridSize = 1;
+
+	// one copy is built and thrown away to find out how many
+	// mesh nodes each copy adds
+	m_sceneNodes.clear();
+	m_transforms.Clear();
+	m_nodeState.parentIndex = -1;
+	AddComputerAssembly();
+	for (const SCENE_NODE& node : m_sceneNodes)
+	{
+		if (node.mesh != MESH_NONE)
+		{
+			nodesPerComputer++;
+		}
+	}
+	m_sceneNodes.clear();
+	m_transforms.Clear();
+	m_fanNodes.clear();
+
+	if (nodesPerComputer > 0)
+	{
+		computerCount = std::max((m_stressObjectCount + nodesPerComputer - 1) / nodesPerComputer, 1);
+	}
+	gridSize = (int)std::ceil(std::sqrt((float)computerCount));
+
+	// the grid is centered on the origin
+	glm::vec3 gridOrigin = glm::vec3(
+		-0.5f * (float)(gridSize - 1) * g_StressSpacingX,
+		0.0f,
+		-0.5f * (float)(gridSize - 1) * g_StressSpacingZ);
+	glm::vec3 halfExtent = glm::vec3(
+		0.5f * (float)gridSize * g_StressSpacingX,
+		0.0f,
+		0.5f * (float)gridSize * g_StressSpacingZ);
+
+	for (int computer = 0; computer < computerCount; computer++)
+	{
+		glm::vec3 position = gridOrigin + glm::vec3(
+			(float)(computer % gridSize) * g_StressSpacingX,
+			0.0f,
+			(float)(computer / gridSize) * g_StressSpacingZ);
+
+		// every copy hangs off its own top level group node
+		m_nodeState.parentIndex = -1;
+		m_nodeState.parentIndex = AddSceneNode(MESH_NONE, glm::vec3(1.0f, 1.0f, 1.0f), 0.0f, 0.0f, 0.0f, position);
+		AddComputerAssembly();
+	}
+	m_nodeState.parentIndex = parentIndex;
+
+	// one stand under the whole grid
+	SetNodeTexture("stand");
+	SetNodeMaterial("wood");
+	AddSceneNode(MESH_BOX,
+		glm::vec3((float)gridSize * g_StressSpacingX, 1.0f, (float)gridSize * g_StressSpacingZ),
+		0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, 0.0f));
+
+	if (m_stressLightCount > 0)
+	{
+		AddStressLights(halfExtent);
+	}
+
+	std::cout << "INFO: stress scene with " << computerCount << " computers, "
+		<< computerCount * nodesPerComputer << " mesh nodes and "
+		<< m_pointLights.size() << " point lights" << std::endl;
+}
+
+/***********************************************************
+ *  AddStressLights()
+ *
+ *  This method is used for replacing the scene lights with
+ *  the point lights of the stress scene, scattered over the
+ *  computer grid with random colors.
+ ***********************************************************/
+void SceneManager::AddStressLights(glm::vec3 halfExtent)
+{
+	uint32_t randomState = g_StressLightSeed;
+
+	m_pointLights.clear();
+	for (int i = 0; i < m_stressLightCount; i++)
+	{
+		glm::vec3 position = glm::vec3(
+			(NextRandom(randomState) * 2.0f - 1.0f) * halfExtent.x,
+			1.0f + NextRandom(randomState) * 14.0f,
+			(NextRandom(randomState) * 2.0f - 1.0f) * halfExtent.z);
+		glm::vec3 color = glm::vec3(
+			0.2f + NextRandom(randomState) * 0.8f,
+			0.2f + NextRandom(randomState) * 0.8f,
+			0.2f + NextRandom(randomState) * 0.8f);
+
+		AddPointLight(position, color * 0.01f, color * 0.6f, color * 0.2f, 1.0f, 0.22f, 0.20f);
+	}
+}
+
+/***********************************************************
+ *  AddComputerFan()
+ *
+ *  This method is used for adding one computer fan to the
+ *  retained scene.  All of the fan parts are children of a
+ *  single fan node, so the passed in rotation and position
+ *  place the whole fan and moving it later only needs the
+ *  fan node transformation to be changed.
+ ***********************************************************/
+int SceneManager::AddComputerFan(
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	int fanIndex = -1;
+	int parentIndex = m_nodeState.parentIndex;
+	bool bStatic = m_nodeState.bStatic;
+
+	// the fans can be spun through their fan node, so none of
+	// their parts are baked into the static batches
+	m_nodeState.bStatic = false;
+	fanIndex = AddSceneNode(MESH_NONE, glm::vec3(1.0f, 1.0f, 1.0f),
+		XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+
+	// the fan parts below are positioned relative to the
+	// center of the fan, facing along the local Z axis
+	m_nodeState.parentIndex = fanIndex;
+
+	//frame sides
+	SetNodeTexture("blackPlastic");
+	SetNodeMaterial("plastic");
+	AddSceneNode(MESH_BOX, glm::vec3(0.25f, 4.0f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(2.0f, 0.0f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.25f, 4.0f, 1.0f), 0.0f, 0.0f, 0.0f, glm::vec3(-2.0f, 0.0f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.25f, 4.0f, 1.0f), 0.0f, 0.0f, 90.0f, glm::vec3(0.0f, -2.0f, 0.0f));
+	AddSceneNode(MESH_BOX, glm::vec3(0.25f, 4.0f, 1.0f), 0.0f, 0.0f, 90.0f, glm::vec3(0.0f, 2.0f, 0.0f));
+	//middle cylinder of the fan
+	SetNodeMaterial("middle");
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.65f, 1.0f, 0.65f), 90.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, -0.5f));
+	//corner cylinders
+	SetNodeMaterial("plastic");
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.13f, 1.0f, 0.13f), 90.0f, 0.0f, 0.0f, glm::vec3(-2.0f, 2.0f, -0.5f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.13f, 1.0f, 0.13f), 90.0f, 0.0f, 0.0f, glm::vec3(-2.0f, -2.0f, -0.5f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.13f, 1.0f, 0.13f), 90.0f, 0.0f, 0.0f, glm::vec3(2.0f, 2.0f, -0.5f));
+	AddSceneNode(MESH_CYLINDER, glm::vec3(0.13f, 1.0f, 0.13f), 90.0f, 0.0f, 0.0f, glm::vec3(2.0f, -2.0f, -0.5f));
+	//supports
+	AddSceneNode(MESH_BOX, glm::vec3(4.0f, 0.1f, 0.25f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, 0.0f, 0.35f));
+	AddSceneNode(MESH_BOX, glm::vec3(5.0f, 0.1f, 0.25f), 0.0f, 0.0f, 36.0f, glm::vec3(0.0f, 0.0f, 0.35f));
+	AddSceneNode(MESH_BOX, glm::vec3(4.0f, 0.1f, 0.25f), 0.0f, 0.0f, 72.0f, glm::vec3(0.0f, 0.0f, 0.35f));
+	AddSceneNode(MESH_BOX, glm::vec3(4.0f, 0.1f, 0.25f), 0.0f, 0.0f, 108.0f, glm::vec3(0.0f, 0.0f, 0.35f));
+	AddSceneNode(MESH_BOX, glm::vec3(5.0f, 0.1f, 0.25f), 0.0f, 0.0f, 144.0f, glm::vec3(0.0f, 0.0f, 0.35f));
+	//fan blades
+	SetNodeTexture("blade");
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.45f, 0.75f, 0.1f), 0.0f, 0.0f, 0.0f, glm::vec3(0.0f, -1.0f, 0.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.45f, 0.75f, 0.1f), 0.0f, 0.0f, -45.0f, glm::vec3(0.75f, 0.75f, 0.0f));
+	AddSceneNode(MESH_SPHERE, glm::vec3(0.45f, 0.75f, 0.1f), 0.0f, 0.0f, 45.0f, glm::vec3(-0.75f, 0.75f, 0.0f));
+
+	m_nodeState.parentIndex = parentIndex;
+	m_nodeState.bStatic = bStatic;
+
+	return(fanIndex);
+}
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by 
+ *  walking the retained scene nodes and drawing the basic
+ *  3D shapes with their cached transformations
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	{
+		ProfileScope scope(m_pFrameProfiler, "UpdateScene");
+
+		// edited shader, texture and scene files are applied first
+		ReloadChangedFiles();
+
+		// textures decoded since the last frame replace their placeholders,
+		// and one that gained or lost alpha moves its nodes in or out of
+		// the opaque batches
+		m_textureLoader->UploadFinishedTextures();
+		if (m_textureManager->GetAlphaChangeCount() != m_textureAlphaChanges)
+		{
+			m_textureAlphaChanges = m_textureManager->GetAlphaChangeCount();
+			m_bStaticBatchesDirty = true;
+		}
+
+		// only recalculates the world matrices of moved nodes
+		UpdateSceneTransforms();
+
+		// static nodes that were moved anyway are baked again
+		if (m_bStaticBatchesDirty == true)
+		{
+			BuildStaticBatches();
+			BuildInstanceBatches();
+		}
+
+		// lights added or changed since the last frame
+		if (m_bLightsDirty == true)
+		{
+			UploadSceneLights();
+		}
+		// the light clusters follow the camera, so they are rebuilt every frame
+		UpdateLightClusters();
+	}
+
+	{
+		ProfileScope scope(m_pFrameProfiler, "CullScene");
+
+		// nodes outside of the camera view are left out of the queue,
+		// and the small visible shapes get coarser tessellations
+		CullScene();
+		UpdateLodLevels();
+
+		// the instanced nodes are culled again on the GPU, which
+		// writes their draw commands
+		if (IsGpuCullingActive() == true)
+		{
+			CullGpuInstances();
+		}
+	}
+
+	{
+		ProfileScope scope(m_pFrameProfiler, "QueueSceneDraws");
+
+		// draws are sorted by texture and material so the shader
+		// values only change between differing neighbours, the
+		// instance buffer is filled with the visible instances
+		QueueSceneDraws();
+	}
+
+	if (m_bUseOcclusionCulling == true)
+	{
+		// the static batches are drawn again over their own depth
+		{
+			ProfileScope scope(m_pFrameProfiler, "OcclusionPass");
+			DrawOcclusionPass();
+		}
+		ProfileScope scope(m_pFrameProfiler, "SubmitRenderQueue");
+		glDepthFunc(GL_LEQUAL);
+		SubmitRenderQueue();
+		glDepthFunc(GL_LESS);
+	}
+	else
+	{
+		ProfileScope scope(m_pFrameProfiler, "SubmitRenderQueue");
+		SubmitRenderQueue();
+	}
+
+	// the scratch memory of this frame stays readable during the
+	// next one, the memory of the frame before is reused
+	m_frameArena->NextFrame();
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the stream buffers that
+ *  the draws of the frame read.  It is called once all of
+ *  the frame's draws, the overlays and the post passes
+ *  included, are submitted, and before the buffers swap.
+ ***********************************************************/
+void SceneManager::EndFrame()
+{
+	if (NULL != m_instancedMeshes)
+	{
+		m_instancedMeshes->EndFrame();
+	}
+	if (NULL != m_lightClusters)
+	{
+		m_lightClusters->EndFrame();
+	}
+	if (NULL != m_pShaderUniforms)
+	{
+		m_pShaderUniforms->EndFrame();
+	}
+	if (NULL != m_gpuCuller)
+	{
+		m_gpuCuller->EndFrame();
+	}
+}
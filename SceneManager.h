@@ -1,118 +1,608 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.h
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
-
-#include <string>
-#include <vector>
-
-/***********************************************************
- *  SceneManager
- *
- *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
- ***********************************************************/
-class SceneManager
-{
-public:
-	// constructor
-	SceneManager(ShaderManager *pShaderManager);
-	// destructor
-	~SceneManager();
-
-	struct TEXTURE_INFO
-	{
-		std::string tag;
-		uint32_t ID;
-	};
-
-	struct OBJECT_MATERIAL
-	{
-		glm::vec3 diffuseColor;
-		glm::vec3 specularColor;
-		float shininess;
-		std::string tag;
-	};
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
-	std::vector<OBJECT_MATERIAL> m_objectMaterials;
-
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
-	void BindGLTextures();
-	// free the loaded OpenGL textures
-	void DestroyGLTextures();
-	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
-	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
-
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
-		glm::vec3 scaleXYZ,
-		float XrotationDegrees,
-		float YrotationDegrees,
-		float ZrotationDegrees,
-		glm::vec3 positionXYZ);
-
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
-
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	//set the textures used for blending
-	void SetShaderTextures(
-	    std::string textureTag, std::string textureTag2);
-
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-public:
-
-	// The following methods are for the students to 
-	// customize for their own 3D scene
-	void PrepareScene();
-	void RenderScene();
-
-	//loads textures from images
-	void LoadSceneTextures();
-
-	//defines the materials of all objects
-	void DefineObjectMaterials();
-
-	//Adds lights to the scene 
-	void SetupSceneLights();
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.h
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "ShapeMeshes.h"
+#include "InstancedMeshes.h"
+#include "StaticBatches.h"
+#include "RenderQueue.h"
+#include "LightClusters.h"
+#include "FrustumCuller.h"
+#include "GpuCuller.h"
+#include "OcclusionQueries.h"
+#include "ShaderVariants.h"
+#include "TextureManager.h"
+#include "TextureLoader.h"
+#include "TagRegistry.h"
+#include "FrameProfiler.h"
+#include "JobPool.h"
+#include "TransformSystem.h"
+#include "SceneFile.h"
+#include "FileWatcher.h"
+#include "FrameArena.h"
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneManager
+ *
+ *  This class contains the code for preparing and rendering
+ *  3D scenes, including the shader settings.
+ ***********************************************************/
+class SceneManager
+{
+public:
+	// constructor
+	SceneManager(ShaderManager *pShaderManager, ShaderUniforms* pShaderUniforms);
+	// destructor
+	~SceneManager();
+
+	struct TEXTURE_INFO
+	{
+		std::string tag;
+		// image file the texture was loaded from
+		std::string filename;
+		// texture manager handle
+		uint32_t ID;
+	};
+
+	struct OBJECT_MATERIAL
+	{
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		std::string tag;
+	};
+
+	// switches of the rendering optimizations, all on by default
+	struct RENDER_OPTIONS
+	{
+		bool bStaticBatching;
+		bool bInstancing;
+		bool bFrustumCulling;
+		bool bOcclusionCulling;
+		bool bLevelOfDetail;
+		bool bLightClusters;
+		bool bMultithreading;
+		bool bMultiDraw;
+		bool bGpuCulling;
+	};
+
+	// basic mesh shapes that a scene node can draw
+	enum MESH_TYPE
+	{
+		MESH_NONE,
+		MESH_BOX,
+		MESH_PLANE,
+		MESH_CYLINDER,
+		MESH_SPHERE,
+		MESH_TORUS
+	};
+
+	struct SCENE_NODE
+	{
+		MESH_TYPE mesh;
+		// index of the parent node, -1 for the scene root
+		int parentIndex;
+		// texture handle resolved when the node is added, -1 for a solid color
+		int textureSlot;
+		// texture mixed over the first one, -1 for a single texture
+		int blendTextureSlot;
+		float blendFactor;
+		glm::vec4 color;
+		// index into the defined materials, -1 for no material
+		int materialIndex;
+		// false for nodes that are moved after the scene is built
+		bool bStatic;
+		// static batch that the node is baked into, -1 when the
+		// node is drawn on its own
+		int staticBatch;
+		// level of detail the node was last drawn at, 0 for the
+		// full tessellation
+		int lodLevel;
+	};
+
+	// a run of scene nodes drawn with one instanced draw call
+	struct INSTANCE_BATCH
+	{
+		// node that supplies the mesh, texture/color and material
+		int nodeIndex;
+		int firstInstance;
+		int instanceCount;
+	};
+
+	// instance batches with the same texture or color, whose
+	// instances are culled on the GPU and drawn together with one
+	// multi-draw, each instance with its own material
+	struct GPU_BUCKET
+	{
+		// node that supplies the texture/color of the bucket
+		int nodeIndex;
+		// first of the bucket's commands in the GPU culler
+		int firstCommand;
+		int objectCount;
+	};
+
+	// slice of an instance batch whose visible instances are
+	// gathered by one job, sorted by level of detail
+	struct INSTANCE_JOB
+	{
+		int batch;
+		// run of m_instanceNodes, first to last - 1
+		int first;
+		int last;
+		FrameArray<int> visibleNodes[MESH_LOD_LEVELS];
+		// view depth of the nearest visible instance of each level
+		float depths[MESH_LOD_LEVELS];
+	};
+
+	// a top level group node and its subtree, hidden as a whole
+	// when its bounding box is occluded
+	struct OCCLUSION_GROUP
+	{
+		int nodeIndex;
+		// last node of the subtree, which follows the group node
+		int lastNode;
+		// world bounding box of all of the subtree meshes
+		glm::vec3 minPoint;
+		glm::vec3 maxPoint;
+	};
+
+	// shader values set by the last queued draw, used for skipping
+	// uniform uploads that would not change anything
+	struct DRAW_STATE
+	{
+		// program variant of the last draw, -1 before the first one
+		int shaderHandle;
+		// true once the texture and instancing flags have been set
+		bool bValid;
+		bool bUseTexture;
+		bool bInstanced;
+		// -1 when no texture slot has been set yet
+		int textureSlot;
+		// -1 when no blend texture slot has been set yet
+		int blendTextureSlot;
+		float blendFactor;
+		// true once a solid color has been set
+		bool bColorValid;
+		glm::vec4 color;
+		// -1 when no material has been set yet
+		int materialIndex;
+	};
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to the uniform blocks and cached uniform locations
+	ShaderUniforms* m_pShaderUniforms;
+	// pointer to the specialized program variants, NULL for the base program only
+	ShaderVariants* m_pShaderVariants;
+	// pointer to the profiler that times the render passes, NULL for none
+	FrameProfiler* m_pFrameProfiler;
+	// pointer to basic shapes object
+	ShapeMeshes* m_basicMeshes;
+	// pointer to the instanced copies of the basic shapes
+	InstancedMeshes* m_instancedMeshes;
+	// pointer to the pre-transformed geometry of the static nodes
+	StaticBatches* m_staticBatches;
+	// array textures that hold all of the loaded textures
+	TextureManager* m_textureManager;
+	// decodes the texture images in the background
+	TextureLoader* m_textureLoader;
+	// loaded textures info, the index is the texture slot
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// texture slot of each texture tag
+	TagRegistry m_textureTags;
+	// defined object materials, the index is the material handle
+	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// material handle of each material tag
+	TagRegistry m_materialTags;
+	// point lights of the scene, any number up to MAX_POINT_LIGHTS,
+	// uploaded into the point light buffer
+	std::vector<ShaderUniforms::POINT_LIGHT> m_pointLights;
+	// true when the light list has changed since the last upload
+	bool m_bLightsDirty;
+	// staging copy of the shader light block
+	ShaderUniforms::LIGHT_BLOCK m_lightBlock;
+	// point lights binned into the clusters of the camera view
+	LightClusters* m_lightClusters;
+	// true when fragments only use the lights of their cluster
+	bool m_bUseLightClusters;
+	// true when the scene is drawn with lighting
+	bool m_bUseLighting;
+	// retained scene nodes built once in PrepareScene()
+	std::vector<SCENE_NODE> m_sceneNodes;
+	// texture/color and material captured by the next added node
+	SCENE_NODE m_nodeState;
+	// local and world matrix of each scene node, by node index
+	TransformSystem m_transforms;
+	// true when any node transformation has changed
+	bool m_bTransformsDirty;
+	// root nodes of the computer fan assemblies
+	std::vector<int> m_fanNodes;
+	// mesh nodes and point lights of the generated stress
+	// scene, no stress scene when the node count is 0
+	int m_stressObjectCount;
+	int m_stressLightCount;
+	// scene loaded from a scene file instead of the built in one
+	SceneFile m_sceneFile;
+	bool m_bUseSceneFile;
+	std::string m_sceneFilename;
+	// polls the shader, texture and scene files for edits, NULL
+	// when hot reloading is off
+	FileWatcher* m_fileWatcher;
+	// true when the static nodes are merged into static batches
+	bool m_bUseStaticBatching;
+	// true when a static node has moved since the batches were built
+	bool m_bStaticBatchesDirty;
+	// texture alpha changes seen when the batches were last built
+	int m_textureAlphaChanges;
+	// node that supplies the surface state of each static batch
+	std::vector<int> m_staticBatchNodes;
+	// true when repeated shapes are drawn with instancing
+	bool m_bUseInstancing;
+	// batches of nodes drawn with one instanced draw call each
+	std::vector<INSTANCE_BATCH> m_instanceBatches;
+	// node indices in instance batch order
+	std::vector<int> m_instanceNodes;
+	// instanced nodes that passed culling, in instance buffer order
+	FrameArray<int> m_visibleInstanceNodes;
+	// instanced nodes in the order they were last uploaded
+	std::vector<int> m_uploadedInstanceNodes;
+	// true when neighbouring instance runs of the same surface are
+	// drawn with one multi-draw where the driver supports it
+	bool m_bUseMultiDraw;
+	// commands of the multi-draw being submitted
+	std::vector<InstancedMeshes::DRAW_COMMAND> m_drawCommands;
+	// culls the instanced nodes and writes their draw commands on
+	// the GPU, NULL without compute shader support
+	GpuCuller* m_gpuCuller;
+	// true when the GPU culler is used where there is one
+	bool m_bUseGpuCulling;
+	// buckets of the instance batches for the GPU culler
+	std::vector<GPU_BUCKET> m_gpuBuckets;
+	// node and first command of each object of the GPU culler
+	std::vector<int> m_gpuObjectNodes;
+	std::vector<int> m_gpuObjectCommands;
+	// true when the object records need to be uploaded again
+	bool m_bGpuObjectsDirty;
+	// visibility of each occlusion group for the GPU culler
+	std::vector<GLuint> m_groupVisibility;
+	// nodes that are drawn one at a time, in scene order
+	std::vector<int> m_singleNodes;
+	// runs the culling and draw item loops on worker threads
+	JobPool* m_jobPool;
+	// scratch memory of the draw items and uploads of the frames
+	FrameArena* m_frameArena;
+	// slices of the instance batches, in instance buffer order
+	std::vector<INSTANCE_JOB> m_instanceJobs;
+	// draw items of each job of the single node loop
+	std::vector<FrameArray<RenderQueue::DRAW_ITEM>> m_jobDrawItems;
+	// culled node count of each job of the culling loop
+	std::vector<int> m_jobCulledCounts;
+	// program variant of untextured, textured and texture blended
+	// nodes, resolved on the GL thread before the jobs run
+	int m_nodeShaders[3];
+	// bit of each of these feature sets that some node is drawn with
+	int m_usedFeatureSets;
+	// true when the instance buffer needs to be uploaded again
+	bool m_bInstanceTransformsDirty;
+	// world bounding boxes of the nodes, then of the static
+	// batches and then of the occlusion groups
+	FrustumCuller m_frustumCuller;
+	// true when the nodes outside of the camera view are skipped
+	bool m_bUseFrustumCulling;
+	// true when the bounding boxes need to be calculated again
+	bool m_bBoundsDirty;
+	// 1 for each bounding box inside the view of the current frame
+	std::vector<unsigned char> m_visibleBounds;
+	// world bounding sphere of each node and then of each static
+	// batch, center and radius
+	std::vector<glm::vec4> m_nodeSpheres;
+	// true when small instanced shapes use coarser tessellations
+	bool m_bUseLevelOfDetail;
+	// true when groups hidden behind the static batches are skipped
+	bool m_bUseOcclusionCulling;
+	// group subtrees tested with occlusion queries
+	std::vector<OCCLUSION_GROUP> m_occlusionGroups;
+	OcclusionQueries m_occlusionQueries;
+	// mesh nodes skipped this frame, and the last printed counts
+	int m_culledObjectCount;
+	int m_occludedObjectCount;
+	int m_reportedCulledCount;
+	int m_reportedOccludedCount;
+	// draw items of the current frame sorted by render state
+	RenderQueue m_renderQueue;
+	// shader values set by the last submitted draw item
+	DRAW_STATE m_drawState;
+
+	// load texture images and convert to OpenGL texture data
+	bool CreateGLTexture(const char* filename, const std::string& tag);
+	// bind loaded OpenGL textures to slots in memory
+	void BindGLTextures();
+	// free the loaded OpenGL textures
+	void DestroyGLTextures();
+	// find a loaded texture by tag, -1 when the tag is not loaded
+	int FindTextureID(const std::string& tag) const;
+	int FindTextureSlot(const std::string& tag) const;
+	// add a material to the defined materials list
+	int AddObjectMaterial(const OBJECT_MATERIAL& material);
+	// find a defined material by tag, false or -1 when the tag
+	// is not defined
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material) const;
+	int FindMaterialIndex(const std::string& tag) const;
+
+	// set the transformation values 
+	// into the transform buffer
+	void SetTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// build the model matrix from the transformation values
+	glm::mat4 ComposeTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the color values into the shader
+	void SetShaderColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+
+	// set the texture data into the shader
+	void SetShaderTexture(
+		const std::string& textureTag);
+
+	// set two textures into the shader, the second mixed over
+	// the first by the blend factor
+	void SetShaderTextures(
+		const std::string& textureTag,
+		const std::string& textureTag2,
+		float blendFactor);
+
+
+	// set the UV scale for the texture mapping
+	void SetTextureUVScale(
+		float u, float v);
+
+	// set the object material into the shader
+	void SetShaderMaterial(
+		const std::string& materialTag);
+	void SetShaderMaterial(
+		int materialIndex);
+	// copy the defined materials into the shader material buffer
+	void UploadMaterials();
+
+	// add a point light to the scene light list
+	int AddPointLight(
+		glm::vec3 position,
+		glm::vec3 ambient,
+		glm::vec3 diffuse,
+		glm::vec3 specular,
+		float constant,
+		float linear,
+		float quadratic);
+	// copy the light list into the shader light block
+	void UploadSceneLights();
+	// bin the point lights into the clusters of the current view
+	void UpdateLightClusters();
+
+	// set the texture/color and material for the next added nodes
+	void SetNodeTexture(
+		const std::string& textureTag);
+	void SetNodeTextures(
+		const std::string& textureTag,
+		const std::string& textureTag2,
+		float blendFactor);
+	void SetNodeColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+	void SetNodeMaterial(
+		const std::string& materialTag);
+
+	// add a mesh or group node under the current parent node
+	int AddSceneNode(
+		MESH_TYPE mesh,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// change the local transformation of a scene node
+	void SetNodeTransformations(
+		int nodeIndex,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// recalculate the world matrices of moved scene nodes
+	void UpdateSceneTransforms();
+
+	// add a computer fan sub-assembly and return its root node
+	int AddComputerFan(
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// add the whole computer under the current parent node
+	void AddComputerAssembly();
+	// replace the scene lights with random lights over the stress
+	// scene grid, which reaches halfExtent from the origin
+	void AddStressLights(glm::vec3 halfExtent);
+
+	// set the array and layer of a loaded texture into the shader
+	void SetShaderTextureSlot(int textureSlot);
+	void SetShaderBlendTextureSlot(int textureSlot);
+	// set the node world matrix into the shader and draw its mesh
+	void DrawSceneNode(int nodeIndex);
+
+	// check if two nodes share a texture or color, whatever their materials
+	bool IsSameTexturing(const SCENE_NODE& first, const SCENE_NODE& second);
+	// check if two nodes share a texture or color and material
+	bool IsSameAppearance(const SCENE_NODE& first, const SCENE_NODE& second);
+	// check if two nodes can be drawn by the same instanced draw
+	bool IsSameSurface(const SCENE_NODE& first, const SCENE_NODE& second);
+	// bake the static nodes into static batches
+	void BuildStaticBatches();
+	// draw a static batch with one draw call
+	void DrawStaticBatch(const RenderQueue::DRAW_ITEM& item);
+	// group the repeated shapes into instance batches
+	void BuildInstanceBatches();
+	// copy the instanced world matrices into the instance buffer
+	void UploadInstanceTransforms();
+	// draw a run of instances with one instanced draw call
+	void DrawInstanceBatch(const RenderQueue::DRAW_ITEM& item);
+	// get the multi-draw command of the instance run of an item
+	InstancedMeshes::DRAW_COMMAND GetInstanceCommand(const RenderQueue::DRAW_ITEM& item) const;
+	// check if the instanced nodes are culled on the GPU this frame
+	bool IsGpuCullingActive() const;
+	// group the instance batches into buckets for the GPU culler
+	void BuildGpuBuckets();
+	// copy the instanced nodes into the object records of the GPU culler
+	void UploadGpuObjects();
+	// cull the instanced nodes on the GPU for the current view
+	void CullGpuInstances();
+	// draw the culled instances of a bucket with one multi-draw
+	void DrawGpuBucket(const RenderQueue::DRAW_ITEM& item);
+
+	// check if a node is drawn in the transparent pass
+	bool IsTransparent(const SCENE_NODE& node) const;
+	// resolve the program variants of the node features in use
+	void UpdateNodeShaders();
+	// get the index of the texture features a node is drawn with
+	int GetNodeFeatureSet(const SCENE_NODE& node) const;
+	// get the program variant that a node is drawn with
+	int GetNodeShader(const SCENE_NODE& node) const;
+	// build the sort key of a node for the render queue
+	uint64_t MakeNodeSortKey(const SCENE_NODE& node, int shaderHandle, int sequence, float depth) const;
+	// get the view depth of a point, 0 at the camera and 1 at the far plane
+	float GetViewDepth(const glm::vec3& point) const;
+	// get the local bounding box of a mesh
+	void GetMeshBounds(MESH_TYPE mesh, glm::vec3& minPoint, glm::vec3& maxPoint);
+	// calculate the world bounding boxes of the nodes and batches
+	void UpdateSceneBounds();
+	// test the bounding boxes against the camera view
+	void CullScene();
+	// pick the level of detail of the visible instanced shapes
+	void UpdateLodLevels();
+	int SelectLodLevel(int currentLevel, float screenSize);
+	// find the group subtrees that occlusion culling skips as a whole
+	void BuildOcclusionGroups();
+	// hide the subtrees of the groups that were found occluded
+	void ApplyOcclusionResults();
+	// lay down the depth of the static batches and query the
+	// group bounding boxes against it
+	void DrawOcclusionPass();
+	// fill the render queue with the draw items of the frame
+	void QueueSceneDraws();
+	// gather the visible instances of a slice of an instance batch
+	void GatherInstanceJob(INSTANCE_JOB& job);
+	// build the draw items of the visible nodes first to last - 1
+	// of the single nodes, or of all nodes without instancing
+	void BuildNodeDrawItems(int first, int last, int sequence, FrameArray<RenderQueue::DRAW_ITEM>& items);
+	// forget the shader values of the last draw
+	void ResetDrawState();
+	// set only the node shader values that differ from the last draw
+	void ApplyDrawState(const SCENE_NODE& node, int shaderHandle, bool bInstanced);
+	// draw the sorted items of the render queue
+	void SubmitRenderQueue();
+	// reload the watched files that were edited
+	void ReloadChangedFiles();
+	// apply an edited scene file to the prepared scene
+	void ReloadSceneFile();
+	// get the texture slots and material handles of the records
+	// of the scene file
+	void ResolveFileRecords(std::vector<int>& textureSlots, std::vector<int>& materialIndices) const;
+	// set the node state from a node record of the scene file
+	void SetFileNodeState(
+		const SceneFile::FILE_NODE& node,
+		const std::vector<int>& textureSlots,
+		const std::vector<int>& materialIndices);
+	// change the scene nodes in place to match the scene file,
+	// false when nodes were added, removed or moved to another parent
+	bool UpdateFileSceneNodes();
+
+public:
+
+	// draw the scene with program variants specialized per draw item
+	void SetShaderVariants(ShaderVariants* pShaderVariants);
+	// time the parts of RenderScene() with a frame profiler
+	void SetFrameProfiler(FrameProfiler* pFrameProfiler);
+	// number of mesh nodes skipped by frustum and occlusion
+	// culling in the last frame
+	int GetCulledObjectCount() const;
+	// number of queued texture images that are not uploaded yet
+	int GetPendingTextureCount() const;
+
+	// get and change the rendering optimizations that are used
+	RENDER_OPTIONS GetRenderOptions() const;
+	void SetRenderOptions(const RENDER_OPTIONS& options);
+
+	// build a grid of computers with about objectCount mesh nodes
+	// and lightCount point lights instead of the normal scene,
+	// must be called before PrepareScene()
+	void SetStressScene(int objectCount, int lightCount);
+	// build the scene from a text or binary scene file instead of
+	// the normal scene, must be called before PrepareScene()
+	bool LoadSceneFile(const std::string& filename);
+	// write the prepared scene to a scene file, in binary form
+	// for a ".bin" file and in text form otherwise
+	bool SaveSceneFile(const std::string& filename) const;
+	// watch the shader, texture and scene files and apply their
+	// edits to the running scene
+	void EnableHotReload();
+	// cull and draw the instanced shapes on the GPU with a compute
+	// shader where the driver supports it, false when they stay
+	// on the CPU
+	bool EnableGpuCulling(const char* computeShaderPath);
+
+	// The following methods are for the students to 
+	// customize for their own 3D scene
+	void PrepareScene();
+	void RenderScene();
+	// fence the stream buffers read by the draws of the frame,
+	// called once they are all submitted
+	void EndFrame();
+
+	// builds the retained scene nodes for the 3D scene
+	void BuildSceneNodes();
+	// builds the scene nodes of the stress scene instead
+	void BuildStressScene();
+
+	//loads textures from images
+	void LoadSceneTextures();
+
+	//defines the materials of all objects
+	void DefineObjectMaterials();
+
+	//Adds lights to the scene 
+	void SetupSceneLights();
+
+	// the same steps for a scene loaded from a scene file
+	void LoadFileTextures();
+	void DefineFileMaterials();
+	void SetupFileLights();
+	void BuildFileSceneNodes();
 };
\ No newline at end of file
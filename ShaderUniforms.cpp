@@ -0,0 +1,498 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.cpp
+// ============
+// cached uniform locations and uniform buffer objects for the shader program
+//
+//	The block binding points are assigned with glUniformBlockBinding()
+//	since layout(binding) needs GLSL 4.20 and the shaders target 3.30.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderUniforms.h"
+#include "FrameProfiler.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+// declaration of the global variables and defines
+namespace
+{
+	const char* g_CameraBlockName = "CameraBlock";
+	const char* g_LightBlockName = "LightBlock";
+
+	// bytes of each region of the camera stream, a few hundred
+	// frames of camera blocks at the largest offset alignments
+	const size_t g_CameraStreamBytes = 64 * 1024;
+}
+
+// the structs have to keep the std140 sizes of the shader blocks
+static_assert(sizeof(ShaderUniforms::CAMERA_BLOCK) == 160, "CameraBlock layout");
+static_assert(sizeof(ShaderUniforms::POINT_LIGHT) == 64, "PointLight layout");
+static_assert(sizeof(ShaderUniforms::LIGHT_BLOCK) == 176, "LightBlock layout");
+static_assert(sizeof(ShaderUniforms::MATERIAL) == 32, "Material layout");
+
+/***********************************************************
+ *  ShaderUniforms()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderUniforms::ShaderUniforms(ShaderManager* pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_programID = 0;
+	m_pLocations = &m_programLocations[0];
+	m_cameraStream = NULL;
+	m_lightUBO = 0;
+	m_pointLightBuffer = 0;
+	m_pointLightTexture = 0;
+	m_pointLightCapacity = 0;
+	m_materialBuffer = 0;
+	m_materialTexture = 0;
+	m_materialCapacity = 0;
+	m_camera = {};
+}
+
+/***********************************************************
+ *  ~ShaderUniforms()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderUniforms::~ShaderUniforms()
+{
+	if (NULL != m_cameraStream)
+	{
+		delete m_cameraStream;
+		m_cameraStream = NULL;
+	}
+	glDeleteBuffers(1, &m_lightUBO);
+	glDeleteTextures(1, &m_pointLightTexture);
+	glDeleteBuffers(1, &m_pointLightBuffer);
+	glDeleteTextures(1, &m_materialTexture);
+	glDeleteBuffers(1, &m_materialBuffer);
+	m_lightUBO = 0;
+	m_pointLightTexture = 0;
+	m_pointLightBuffer = 0;
+	m_materialTexture = 0;
+	m_materialBuffer = 0;
+	m_pShaderManager = NULL;
+}
+
+/***********************************************************
+ *  CreateUniformBlocks()
+ *
+ *  This method is used for creating the uniform buffers of
+ *  the camera and light blocks and attaching them to the
+ *  blocks of the loaded shader program.  The camera block
+ *  changes every frame, so it is written into a stream
+ *  buffer instead of a buffer of its own.  The point light
+ *  and material texture buffers start with room for one
+ *  entry each.
+ ***********************************************************/
+void ShaderUniforms::CreateUniformBlocks()
+{
+	GLint offsetAlignment = 0;
+
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+	m_cameraStream = new StreamBuffer(g_CameraStreamBytes, (size_t)std::max(offsetAlignment, 1));
+	m_camera = {};
+	UpdateCameraBlock();
+	m_lightUBO = CreateUniformBlock(LIGHT_BLOCK_BINDING, sizeof(LIGHT_BLOCK));
+
+	POINT_LIGHT emptyLight = {};
+
+	m_pointLightCapacity = 1;
+	glGenBuffers(1, &m_pointLightBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_pointLightBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(POINT_LIGHT), &emptyLight, GL_DYNAMIC_DRAW);
+	glGenTextures(1, &m_pointLightTexture);
+	glBindTexture(GL_TEXTURE_BUFFER, m_pointLightTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_pointLightBuffer);
+
+	MATERIAL emptyMaterial = {};
+
+	m_materialCapacity = 1;
+	glGenBuffers(1, &m_materialBuffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, m_materialBuffer);
+	glBufferData(GL_TEXTURE_BUFFER, sizeof(MATERIAL), &emptyMaterial, GL_DYNAMIC_DRAW);
+	glGenTextures(1, &m_materialTexture);
+	glBindTexture(GL_TEXTURE_BUFFER, m_materialTexture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_materialBuffer);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+	if (NULL != m_pShaderManager)
+	{
+		BindUniformBlocks(m_pShaderManager->m_programID);
+		UseProgram(m_pShaderManager->m_programID);
+	}
+}
+
+/***********************************************************
+ *  BindUniformBlocks()
+ *
+ *  This method is used for attaching the uniform buffers to
+ *  the blocks of a program.  Every program that shares the
+ *  blocks reads the same buffers.
+ ***********************************************************/
+void ShaderUniforms::BindUniformBlocks(GLuint programID)
+{
+	BindUniformBlock(programID, g_CameraBlockName, CAMERA_BLOCK_BINDING);
+	BindUniformBlock(programID, g_LightBlockName, LIGHT_BLOCK_BINDING);
+}
+
+/***********************************************************
+ *  CreateUniformBlock()
+ *
+ *  This method is used for creating a zero filled uniform
+ *  buffer and binding it to the passed in binding point.
+ ***********************************************************/
+GLuint ShaderUniforms::CreateUniformBlock(GLuint binding, GLsizeiptr size)
+{
+	GLuint ubo = 0;
+	std::vector<unsigned char> zeros(size, 0);
+
+	glGenBuffers(1, &ubo);
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferData(GL_UNIFORM_BUFFER, size, zeros.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
+
+	return(ubo);
+}
+
+/***********************************************************
+ *  BindUniformBlock()
+ *
+ *  This method is used for attaching a named block of a
+ *  program to a binding point.
+ ***********************************************************/
+void ShaderUniforms::BindUniformBlock(GLuint programID, const char* blockName, GLuint binding)
+{
+	GLuint blockIndex = glGetUniformBlockIndex(programID, blockName);
+
+	if (blockIndex != GL_INVALID_INDEX)
+	{
+		glUniformBlockBinding(programID, blockIndex, binding);
+	}
+	else
+	{
+		std::cout << "Uniform block not found in shader:" << blockName << std::endl;
+	}
+}
+
+/***********************************************************
+ *  UseProgram()
+ *
+ *  This method is used for making a program current.  The
+ *  cached uniform locations are switched along with it.
+ ***********************************************************/
+void ShaderUniforms::UseProgram(GLuint programID)
+{
+	glUseProgram(programID);
+	FrameProfiler::CountStateChange();
+
+	m_programID = programID;
+	m_pLocations = &m_programLocations[programID];
+}
+
+/***********************************************************
+ *  GetCurrentProgram()
+ *
+ *  This method is used for getting the program that the
+ *  uniforms are currently set on.
+ ***********************************************************/
+GLuint ShaderUniforms::GetCurrentProgram() const
+{
+	return(m_programID);
+}
+
+/***********************************************************
+ *  ForgetProgram()
+ *
+ *  This method is used for dropping the uniform locations
+ *  cached for a program that has been deleted.  The map is
+ *  emptied instead of erased, so the locations of the
+ *  current program stay valid.
+ ***********************************************************/
+void ShaderUniforms::ForgetProgram(GLuint programID)
+{
+	std::unordered_map<GLuint, std::unordered_map<std::string, GLint>>::iterator found = m_programLocations.find(programID);
+
+	if (found != m_programLocations.end())
+	{
+		found->second.clear();
+	}
+}
+
+/***********************************************************
+ *  UpdateUniformBlock()
+ *
+ *  This method is used for copying new contents into a
+ *  uniform buffer with a single upload.
+ ***********************************************************/
+void ShaderUniforms::UpdateUniformBlock(GLuint ubo, const void* data, GLsizeiptr size)
+{
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  GetUniformLocation()
+ *
+ *  This method is used for getting the location of a named
+ *  uniform in the current program.  Locations are looked up
+ *  once per program and then kept.
+ ***********************************************************/
+GLint ShaderUniforms::GetUniformLocation(const std::string& name)
+{
+	std::unordered_map<std::string, GLint>::const_iterator found = m_pLocations->find(name);
+	if (found != m_pLocations->end())
+	{
+		return(found->second);
+	}
+
+	// unknown names are cached as -1, which glUniform*() ignores
+	GLint location = -1;
+	if (m_programID != 0)
+	{
+		location = glGetUniformLocation(m_programID, name.c_str());
+	}
+	(*m_pLocations)[name] = location;
+
+	return(location);
+}
+
+/***********************************************************
+ *  SetBoolValue()
+ *
+ *  This method is used for setting a bool uniform.
+ ***********************************************************/
+void ShaderUniforms::SetBoolValue(const std::string& name, bool value)
+{
+	glUniform1i(GetUniformLocation(name), (int)value);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetIntValue()
+ *
+ *  This method is used for setting an int uniform.
+ ***********************************************************/
+void ShaderUniforms::SetIntValue(const std::string& name, int value)
+{
+	glUniform1i(GetUniformLocation(name), value);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetFloatValue()
+ *
+ *  This method is used for setting a float uniform.
+ ***********************************************************/
+void ShaderUniforms::SetFloatValue(const std::string& name, float value)
+{
+	glUniform1f(GetUniformLocation(name), value);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetSampler2DValue()
+ *
+ *  This method is used for setting the texture unit of a
+ *  sampler uniform.
+ ***********************************************************/
+void ShaderUniforms::SetSampler2DValue(const std::string& name, int value)
+{
+	glUniform1i(GetUniformLocation(name), value);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetVec4Value()
+ *
+ *  This method is used for setting a vec4 uniform.
+ ***********************************************************/
+void ShaderUniforms::SetVec4Value(const std::string& name, const glm::vec4& value)
+{
+	glUniform4fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetMat4Value()
+ *
+ *  This method is used for setting a mat4 uniform.
+ ***********************************************************/
+void ShaderUniforms::SetMat4Value(const std::string& name, const glm::mat4& value)
+{
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  SetCameraBlock()
+ *
+ *  This method is used for uploading the view and projection
+ *  matrices, the camera position and the screen size of the
+ *  frame.
+ ***********************************************************/
+void ShaderUniforms::SetCameraBlock(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	const glm::vec3& viewPosition,
+	const glm::vec2& screenSize,
+	float nearPlane,
+	float farPlane)
+{
+	m_camera.view = view;
+	m_camera.projection = projection;
+	m_camera.viewPosition = viewPosition;
+	m_camera.padding = 0.0f;
+	m_camera.screenSize = screenSize;
+	m_camera.nearPlane = nearPlane;
+	m_camera.farPlane = farPlane;
+
+	UpdateCameraBlock();
+}
+
+/***********************************************************
+ *  UpdateCameraBlock()
+ *
+ *  This method is used for writing the camera values into
+ *  the camera stream and binding the written range to the
+ *  camera block.  The range of the previous frame is left
+ *  for the draws that still read it.
+ ***********************************************************/
+void ShaderUniforms::UpdateCameraBlock()
+{
+	GLintptr offset = m_cameraStream->Write(&m_camera, sizeof(CAMERA_BLOCK));
+
+	glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, m_cameraStream->GetBuffer(),
+		offset, sizeof(CAMERA_BLOCK));
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  GetCameraBlock()
+ *
+ *  This method is used for getting the camera values that
+ *  were last uploaded into the camera block.
+ ***********************************************************/
+const ShaderUniforms::CAMERA_BLOCK& ShaderUniforms::GetCameraBlock() const
+{
+	return(m_camera);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the region of the camera
+ *  stream that the draws of this frame read.
+ ***********************************************************/
+void ShaderUniforms::EndFrame()
+{
+	if (NULL != m_cameraStream)
+	{
+		m_cameraStream->EndFrame();
+	}
+}
+
+/***********************************************************
+ *  SetLightBlock()
+ *
+ *  This method is used for uploading the directional light,
+ *  the spot light and the number of point lights.
+ ***********************************************************/
+void ShaderUniforms::SetLightBlock(const LIGHT_BLOCK& lights)
+{
+	UpdateUniformBlock(m_lightUBO, &lights, sizeof(LIGHT_BLOCK));
+}
+
+/***********************************************************
+ *  SetPointLights()
+ *
+ *  This method is used for uploading the point lights into
+ *  the texture buffer.  The buffer only grows, so the light
+ *  count in the light block tells the shader how many of
+ *  the entries are used.
+ ***********************************************************/
+void ShaderUniforms::SetPointLights(const std::vector<POINT_LIGHT>& lights)
+{
+	if (lights.empty() == true)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_pointLightBuffer);
+	if ((int)lights.size() > m_pointLightCapacity)
+	{
+		m_pointLightCapacity = (int)lights.size();
+		glBufferData(GL_TEXTURE_BUFFER, m_pointLightCapacity * sizeof(POINT_LIGHT), lights.data(), GL_DYNAMIC_DRAW);
+	}
+	else
+	{
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, lights.size() * sizeof(POINT_LIGHT), lights.data());
+	}
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  BindPointLightTexture()
+ *
+ *  This method is used for binding the point light texture
+ *  buffer to its texture unit.
+ ***********************************************************/
+void ShaderUniforms::BindPointLightTexture() const
+{
+	glActiveTexture(GL_TEXTURE0 + POINT_LIGHT_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, m_pointLightTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  SetMaterials()
+ *
+ *  This method is used for uploading all of the defined
+ *  object materials into the texture buffer.  Draws select
+ *  one by its handle, and the buffer grows with the number
+ *  of materials.
+ ***********************************************************/
+void ShaderUniforms::SetMaterials(const std::vector<MATERIAL>& materials)
+{
+	if (materials.empty() == true)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_TEXTURE_BUFFER, m_materialBuffer);
+	if ((int)materials.size() > m_materialCapacity)
+	{
+		m_materialCapacity = (int)materials.size();
+		glBufferData(GL_TEXTURE_BUFFER, m_materialCapacity * sizeof(MATERIAL), materials.data(), GL_DYNAMIC_DRAW);
+	}
+	else
+	{
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, materials.size() * sizeof(MATERIAL), materials.data());
+	}
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	FrameProfiler::CountUniformUpload();
+}
+
+/***********************************************************
+ *  BindMaterialTexture()
+ *
+ *  This method is used for binding the material texture
+ *  buffer to its texture unit.
+ ***********************************************************/
+void ShaderUniforms::BindMaterialTexture() const
+{
+	glActiveTexture(GL_TEXTURE0 + MATERIAL_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, m_materialTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.h
+// ============
+// cached uniform locations and uniform buffer objects for the shader program
+//
+//	The per-draw uniforms are set through locations that are resolved once
+//	per program.  The camera and light values are kept in std140
+//	uniform blocks (see fragmentShader.glsl), so each of them is uploaded
+//	with a single write when it changes.  The camera block changes every
+//	frame and is written into a StreamBuffer, whose written range is bound
+//	with glBindBufferRange(), while the light block only changes on edits
+//	and keeps a buffer of its own.  The point lights and the materials
+//	are kept in texture buffers instead, since a uniform block only has
+//	room for a few hundred of them.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "StreamBuffer.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// binding points of the uniform blocks
+#define CAMERA_BLOCK_BINDING 0
+#define LIGHT_BLOCK_BINDING 1
+
+// most object materials in the material texture buffer, at two
+// texels each they fill the smallest texture buffer GL allows,
+// and their handles fit the material bits of the draw sort key
+#define MAX_MATERIALS 32768
+// texture unit of the material buffer, below the point lights
+#define MATERIAL_TEXTURE_UNIT 12
+
+// most point lights in the point light texture buffer
+#define MAX_POINT_LIGHTS 1024
+// texture unit of the point light buffer, between the scene
+// textures and the light cluster buffers
+#define POINT_LIGHT_TEXTURE_UNIT 13
+
+/***********************************************************
+ *  ShaderUniforms
+ *
+ *  This class contains the code for setting uniforms by
+ *  cached location and for updating the uniform blocks.
+ *  The structs below mirror the std140 block layouts, so
+ *  every vec3 is followed by a 4 byte member.
+ ***********************************************************/
+class ShaderUniforms
+{
+public:
+	struct CAMERA_BLOCK
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec3 viewPosition;
+		float padding;
+		// framebuffer size in pixels
+		glm::vec2 screenSize;
+		// near and far clipping distances of the projection
+		float nearPlane;
+		float farPlane;
+	};
+
+	struct DIRECTIONAL_LIGHT
+	{
+		glm::vec3 direction;
+		float padding0;
+		glm::vec3 ambient;
+		float padding1;
+		glm::vec3 diffuse;
+		float padding2;
+		glm::vec3 specular;
+		int bActive;
+	};
+
+	// four RGBA32F texels of the point light texture buffer
+	struct POINT_LIGHT
+	{
+		glm::vec3 position;
+		float constant;
+		glm::vec3 ambient;
+		float linear;
+		glm::vec3 diffuse;
+		float quadratic;
+		glm::vec3 specular;
+		// distance past which the light no longer makes a visible difference
+		float radius;
+	};
+
+	struct SPOT_LIGHT
+	{
+		glm::vec3 position;
+		float cutOff;
+		glm::vec3 direction;
+		float outerCutOff;
+		glm::vec3 ambient;
+		float constant;
+		glm::vec3 diffuse;
+		float linear;
+		glm::vec3 specular;
+		float quadratic;
+		int bActive;
+		int padding[3];
+	};
+
+	struct LIGHT_BLOCK
+	{
+		// number of lights in the point light texture buffer
+		int pointLightCount;
+		int padding[3];
+		DIRECTIONAL_LIGHT directionalLight;
+		SPOT_LIGHT spotLight;
+	};
+
+	// two RGBA32F texels of the material texture buffer
+	struct MATERIAL
+	{
+		glm::vec3 diffuseColor;
+		float shininess;
+		glm::vec3 specularColor;
+		float padding;
+	};
+
+	// constructor
+	ShaderUniforms(ShaderManager* pShaderManager);
+	// destructor
+	~ShaderUniforms();
+
+	// create the uniform buffers and attach them to the program blocks
+	void CreateUniformBlocks();
+	// attach the uniform buffers to the blocks of another program
+	void BindUniformBlocks(GLuint programID);
+
+	// make a program current, the uniforms below are set on it
+	void UseProgram(GLuint programID);
+	// get the program that the uniforms are currently set on
+	GLuint GetCurrentProgram() const;
+	// drop the cached locations of a deleted program, whose name
+	// can be given to a new program
+	void ForgetProgram(GLuint programID);
+
+	// get the location of a uniform, resolved once per program
+	GLint GetUniformLocation(const std::string& name);
+
+	// set a uniform of the current program by cached location
+	void SetBoolValue(const std::string& name, bool value);
+	void SetIntValue(const std::string& name, int value);
+	void SetFloatValue(const std::string& name, float value);
+	void SetSampler2DValue(const std::string& name, int value);
+	void SetVec4Value(const std::string& name, const glm::vec4& value);
+	void SetMat4Value(const std::string& name, const glm::mat4& value);
+
+	// upload the contents of a uniform block
+	void SetCameraBlock(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		const glm::vec3& viewPosition,
+		const glm::vec2& screenSize,
+		float nearPlane,
+		float farPlane);
+	void SetLightBlock(const LIGHT_BLOCK& lights);
+
+	// upload the point lights into the point light texture buffer
+	void SetPointLights(const std::vector<POINT_LIGHT>& lights);
+	// bind the point light texture buffer to its texture unit
+	void BindPointLightTexture() const;
+
+	// upload the object materials into the material texture buffer,
+	// indexed by material handle
+	void SetMaterials(const std::vector<MATERIAL>& materials);
+	// bind the material texture buffer to its texture unit
+	void BindMaterialTexture() const;
+
+	// get the camera values of the last camera block upload
+	const CAMERA_BLOCK& GetCameraBlock() const;
+
+	// fence the stream region read by this frame's draws, called
+	// once the draws of the frame are submitted
+	void EndFrame();
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// program that the uniforms are currently set on
+	GLuint m_programID;
+	// uniform locations by program and name
+	std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> m_programLocations;
+	// locations of the current program
+	std::unordered_map<std::string, GLint>* m_pLocations;
+
+	// stream buffer of the camera block, written every frame
+	StreamBuffer* m_cameraStream;
+	// contents of the camera block for code that needs the camera
+	CAMERA_BLOCK m_camera;
+	// uniform buffer object of the light block, which changes on edits
+	GLuint m_lightUBO;
+	// texture buffer of the point lights
+	GLuint m_pointLightBuffer;
+	GLuint m_pointLightTexture;
+	// number of lights the point light buffer can currently hold
+	int m_pointLightCapacity;
+	// texture buffer of the object materials
+	GLuint m_materialBuffer;
+	GLuint m_materialTexture;
+	// number of materials the material buffer can currently hold
+	int m_materialCapacity;
+
+	// create a uniform buffer for a block binding point
+	GLuint CreateUniformBlock(GLuint binding, GLsizeiptr size);
+	// attach a named block of a program to a binding point
+	void BindUniformBlock(GLuint programID, const char* blockName, GLuint binding);
+	// copy new contents into a uniform buffer
+	void UpdateUniformBlock(GLuint ubo, const void* data, GLsizeiptr size);
+	// write the camera values into the stream and bind them
+	void UpdateCameraBlock();
+};
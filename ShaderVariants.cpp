@@ -0,0 +1,442 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadervariants.cpp
+// ============
+// specialized builds of the scene shader program for feature combinations
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderVariants.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// declaration of global variables
+namespace
+{
+	// feature flags and the shader macros they define
+	struct FEATURE_DEFINE
+	{
+		int feature;
+		const char* macroName;
+	};
+
+	const FEATURE_DEFINE g_FeatureDefines[] =
+	{
+		{ SHADER_TEXTURED, "USE_TEXTURE" },
+		{ SHADER_LIT, "USE_LIGHTING" },
+		{ SHADER_CLUSTERED_LIGHTS, "USE_LIGHT_CLUSTERS" },
+		{ SHADER_DIRECTIONAL_LIGHT, "USE_DIRECTIONAL_LIGHT" },
+		{ SHADER_SPOT_LIGHT, "USE_SPOT_LIGHT" },
+		{ SHADER_TEXTURE_BLEND, "USE_TEXTURE_BLEND" }
+	};
+
+	// feature set of the shader manager program, which is built
+	// without any defines and switches its features by uniforms
+	const int g_BaseProgramFeatures = -1;
+
+	/***********************************************************
+	 *  ReadShaderFile()
+	 *
+	 *  Reads the whole text of a shader file.  Returns false if
+	 *  the file could not be opened.
+	 ***********************************************************/
+	bool ReadShaderFile(const char* filePath, std::string& source)
+	{
+		std::ifstream file(filePath);
+		if (!file.is_open())
+		{
+			std::cout << "Could not open shader file:" << filePath << std::endl;
+			return(false);
+		}
+
+		std::stringstream contents;
+		contents << file.rdbuf();
+		source = contents.str();
+
+		return(true);
+	}
+}
+
+/***********************************************************
+ *  ShaderVariants()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderVariants::ShaderVariants(ShaderManager* pShaderManager, ShaderUniforms* pShaderUniforms)
+{
+	m_pShaderManager = pShaderManager;
+	m_pShaderUniforms = pShaderUniforms;
+}
+
+/***********************************************************
+ *  ~ShaderVariants()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderVariants::~ShaderVariants()
+{
+	for (const PROGRAM_VARIANT& variant : m_variants)
+	{
+		// failed builds share the shader manager program
+		if (variant.programID != m_pShaderManager->m_programID)
+		{
+			glDeleteProgram(variant.programID);
+		}
+	}
+	m_variants.clear();
+	m_variantHandles.clear();
+
+	m_pShaderManager = NULL;
+	m_pShaderUniforms = NULL;
+}
+
+/***********************************************************
+ *  LoadShaderSources()
+ *
+ *  This method is used for reading the vertex and fragment
+ *  shader sources that the variants are compiled from.  The
+ *  same files as the shader manager program should be used.
+ ***********************************************************/
+bool ShaderVariants::LoadShaderSources(const char* vertexShaderPath, const char* fragmentShaderPath)
+{
+	m_vertexShaderPath = vertexShaderPath;
+	m_fragmentShaderPath = fragmentShaderPath;
+
+	if ((ReadShaderFile(vertexShaderPath, m_vertexSource) == false) ||
+		(ReadShaderFile(fragmentShaderPath, m_fragmentSource) == false))
+	{
+		m_vertexSource.clear();
+		m_fragmentSource.clear();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ReloadShaderSources()
+ *
+ *  This method is used for reading the shader files again
+ *  after they were edited and replacing the base program
+ *  and every variant with builds of the new sources.  The
+ *  variant handles stay the same, so the scene does not
+ *  need to look them up again.  If the base program does
+ *  not build, the new programs are thrown away and the old
+ *  sources and programs are kept, and a variant that does
+ *  not build falls back to the new base program.
+ ***********************************************************/
+bool ShaderVariants::ReloadShaderSources()
+{
+	std::string vertexSource;
+	std::string fragmentSource;
+
+	if ((m_vertexShaderPath.empty() == true) ||
+		(ReadShaderFile(m_vertexShaderPath.c_str(), vertexSource) == false) ||
+		(ReadShaderFile(m_fragmentShaderPath.c_str(), fragmentSource) == false))
+	{
+		return(false);
+	}
+	// saving a file without changing it rebuilds nothing
+	if ((vertexSource == m_vertexSource) && (fragmentSource == m_fragmentSource))
+	{
+		return(false);
+	}
+
+	m_vertexSource.swap(vertexSource);
+	m_fragmentSource.swap(fragmentSource);
+
+	GLuint baseProgram = BuildProgram(g_BaseProgramFeatures);
+	if (baseProgram == 0)
+	{
+		std::cout << "Shaders were not reloaded, the previous programs are kept" << std::endl;
+		m_vertexSource.swap(vertexSource);
+		m_fragmentSource.swap(fragmentSource);
+		return(false);
+	}
+
+	GLuint oldBaseProgram = m_pShaderManager->m_programID;
+	GLuint currentProgram = m_pShaderUniforms->GetCurrentProgram();
+	GLuint newCurrentProgram = baseProgram;
+
+	for (PROGRAM_VARIANT& variant : m_variants)
+	{
+		GLuint programID = BuildProgram(variant.features);
+
+		if (programID == 0)
+		{
+			programID = baseProgram;
+		}
+		if (variant.programID == currentProgram)
+		{
+			newCurrentProgram = programID;
+		}
+		if (variant.programID != oldBaseProgram)
+		{
+			glDeleteProgram(variant.programID);
+			m_pShaderUniforms->ForgetProgram(variant.programID);
+		}
+		variant.programID = programID;
+	}
+
+	glDeleteProgram(oldBaseProgram);
+	m_pShaderUniforms->ForgetProgram(oldBaseProgram);
+	m_pShaderManager->m_programID = baseProgram;
+
+	SetupProgram(baseProgram);
+	for (const PROGRAM_VARIANT& variant : m_variants)
+	{
+		if (variant.programID != baseProgram)
+		{
+			SetupProgram(variant.programID);
+		}
+	}
+	m_pShaderUniforms->UseProgram(newCurrentProgram);
+
+	std::cout << "INFO: reloaded the shaders and " << m_variants.size() << " program variants" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetVertexShaderPath()
+ *
+ *  This method is used for getting the vertex shader file
+ *  that the sources were read from.
+ ***********************************************************/
+const std::string& ShaderVariants::GetVertexShaderPath() const
+{
+	return(m_vertexShaderPath);
+}
+
+/***********************************************************
+ *  GetFragmentShaderPath()
+ *
+ *  This method is used for getting the fragment shader file
+ *  that the sources were read from.
+ ***********************************************************/
+const std::string& ShaderVariants::GetFragmentShaderPath() const
+{
+	return(m_fragmentShaderPath);
+}
+
+/***********************************************************
+ *  GetVariant()
+ *
+ *  This method is used for getting the handle of the program
+ *  variant for a set of SHADER_* features.  The variant is
+ *  built the first time the feature set is asked for.
+ ***********************************************************/
+int ShaderVariants::GetVariant(int features)
+{
+	std::unordered_map<int, int>::const_iterator found = m_variantHandles.find(features);
+	if (found != m_variantHandles.end())
+	{
+		return(found->second);
+	}
+
+	PROGRAM_VARIANT variant;
+	variant.features = features;
+	variant.programID = BuildProgram(features);
+
+	// without a variant the uniform switched program still draws correctly
+	if (variant.programID == 0)
+	{
+		variant.programID = m_pShaderManager->m_programID;
+	}
+	else
+	{
+		GLuint currentProgram = m_pShaderUniforms->GetCurrentProgram();
+
+		SetupProgram(variant.programID);
+		m_pShaderUniforms->UseProgram(currentProgram);
+	}
+
+	int variantHandle = (int)m_variants.size();
+	m_variants.push_back(variant);
+	m_variantHandles[features] = variantHandle;
+
+	return(variantHandle);
+}
+
+/***********************************************************
+ *  UseVariant()
+ *
+ *  This method is used for making a program variant the
+ *  current program of the uniform setters.
+ ***********************************************************/
+void ShaderVariants::UseVariant(int variantHandle)
+{
+	if ((variantHandle < 0) || (variantHandle >= (int)m_variants.size()))
+	{
+		return;
+	}
+
+	m_pShaderUniforms->UseProgram(m_variants[variantHandle].programID);
+}
+
+/***********************************************************
+ *  UseBaseProgram()
+ *
+ *  This method is used for making the program loaded by the
+ *  shader manager current again, for the code that sets its
+ *  uniforms through the shader manager.
+ ***********************************************************/
+void ShaderVariants::UseBaseProgram()
+{
+	m_pShaderUniforms->UseProgram(m_pShaderManager->m_programID);
+}
+
+/***********************************************************
+ *  SetProgramInt()
+ *
+ *  This method is used for setting an int uniform, such as a
+ *  sampler unit, on the base program and every variant.  The
+ *  value is kept and set on variants that are built later.
+ ***********************************************************/
+void ShaderVariants::SetProgramInt(const std::string& name, int value)
+{
+	GLuint currentProgram = m_pShaderUniforms->GetCurrentProgram();
+
+	m_programInts[name] = value;
+
+	m_pShaderUniforms->UseProgram(m_pShaderManager->m_programID);
+	m_pShaderUniforms->SetIntValue(name, value);
+	for (const PROGRAM_VARIANT& variant : m_variants)
+	{
+		m_pShaderUniforms->UseProgram(variant.programID);
+		m_pShaderUniforms->SetIntValue(name, value);
+	}
+
+	m_pShaderUniforms->UseProgram(currentProgram);
+}
+
+/***********************************************************
+ *  BuildProgram()
+ *
+ *  This method is used for compiling and linking the shader
+ *  sources with the defines of a feature set.  Returns 0 if
+ *  the sources are missing or the build fails.
+ ***********************************************************/
+GLuint ShaderVariants::BuildProgram(int features)
+{
+	if ((m_vertexSource.empty() == true) || (m_fragmentSource.empty() == true))
+	{
+		return(0);
+	}
+
+	GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, AddFeatureDefines(m_vertexSource, features), "vertex");
+	GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, AddFeatureDefines(m_fragmentSource, features), "fragment");
+
+	if ((vertexShader == 0) || (fragmentShader == 0))
+	{
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return(0);
+	}
+
+	GLuint programID = glCreateProgram();
+	glAttachShader(programID, vertexShader);
+	glAttachShader(programID, fragmentShader);
+	glLinkProgram(programID);
+
+	// the linked program keeps the compiled code
+	glDetachShader(programID, vertexShader);
+	glDetachShader(programID, fragmentShader);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	GLint success = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		GLchar infoLog[1024];
+		glGetProgramInfoLog(programID, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::SHADER_VARIANT_LINKING_ERROR of features " << features << "\n" << infoLog << std::endl;
+		glDeleteProgram(programID);
+		return(0);
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  SetupProgram()
+ *
+ *  This method is used for attaching the uniform blocks to a
+ *  new program and setting the int uniforms that all of the
+ *  programs share.  The program is left current.
+ ***********************************************************/
+void ShaderVariants::SetupProgram(GLuint programID)
+{
+	m_pShaderUniforms->BindUniformBlocks(programID);
+	m_pShaderUniforms->UseProgram(programID);
+	for (const std::pair<const std::string, int>& programInt : m_programInts)
+	{
+		m_pShaderUniforms->SetIntValue(programInt.first, programInt.second);
+	}
+}
+
+/***********************************************************
+ *  CompileShader()
+ *
+ *  This method is used for compiling one shader stage of a
+ *  variant.  Returns 0 and prints the log if it fails.
+ ***********************************************************/
+GLuint ShaderVariants::CompileShader(GLenum shaderType, const std::string& source, const char* stageName)
+{
+	const GLchar* sourceText = source.c_str();
+	GLuint shader = glCreateShader(shaderType);
+
+	glShaderSource(shader, 1, &sourceText, NULL);
+	glCompileShader(shader);
+
+	GLint success = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		GLchar infoLog[1024];
+		glGetShaderInfoLog(shader, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::SHADER_VARIANT_COMPILATION_ERROR of " << stageName << " shader\n" << infoLog << std::endl;
+		glDeleteShader(shader);
+		return(0);
+	}
+
+	return(shader);
+}
+
+/***********************************************************
+ *  AddFeatureDefines()
+ *
+ *  This method is used for inserting the feature defines of
+ *  a variant into the shader source.  GLSL requires #version
+ *  to come first, so they are placed right after that line.
+ *  The base program is built from the source as it is.
+ ***********************************************************/
+std::string ShaderVariants::AddFeatureDefines(const std::string& source, int features)
+{
+	if (features == g_BaseProgramFeatures)
+	{
+		return(source);
+	}
+
+	std::string defines = "#define SHADER_PERMUTATION\n";
+
+	for (const FEATURE_DEFINE& featureDefine : g_FeatureDefines)
+	{
+		defines += "#define ";
+		defines += featureDefine.macroName;
+		defines += ((features & featureDefine.feature) != 0) ? " true\n" : " false\n";
+	}
+
+	size_t insertPosition = 0;
+	if (source.compare(0, 8, "#version") == 0)
+	{
+		insertPosition = source.find('\n');
+		insertPosition = (insertPosition == std::string::npos) ? source.size() : insertPosition + 1;
+	}
+
+	std::string result = source;
+	result.insert(insertPosition, defines);
+
+	return(result);
+}
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadervariants.h
+// ============
+// specialized builds of the scene shader program for feature combinations
+//
+//	The shader sources are compiled again with #define constants for the
+//	features a draw uses (see the USE_* macros in fragmentShader.glsl), so
+//	each variant only contains the branches and uniform reads it needs.
+//	Variants are built the first time a feature combination is asked for.
+//	When the shader files are edited, the base program and every variant
+//	are built again from the new sources and only swapped in once the
+//	base program has built, so a broken edit keeps the old programs.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShaderUniforms.h"
+
+#include <GL/glew.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// features that a program variant is specialized for
+#define SHADER_TEXTURED 0x01
+#define SHADER_LIT 0x02
+#define SHADER_CLUSTERED_LIGHTS 0x04
+#define SHADER_DIRECTIONAL_LIGHT 0x08
+#define SHADER_SPOT_LIGHT 0x10
+#define SHADER_TEXTURE_BLEND 0x20
+
+/***********************************************************
+ *  ShaderVariants
+ *
+ *  This class contains the code for building and selecting
+ *  the program variants of the scene shaders.  A variant is
+ *  identified by a small handle that fits the shader field
+ *  of the render queue sort key.
+ ***********************************************************/
+class ShaderVariants
+{
+public:
+	// constructor
+	ShaderVariants(ShaderManager* pShaderManager, ShaderUniforms* pShaderUniforms);
+	// destructor
+	~ShaderVariants();
+
+	// read the shader sources that the variants are built from
+	bool LoadShaderSources(const char* vertexShaderPath, const char* fragmentShaderPath);
+	// read the shader files again and rebuild the base program and
+	// all of the variants, false when nothing was replaced
+	bool ReloadShaderSources();
+	// get the shader files that the sources were read from
+	const std::string& GetVertexShaderPath() const;
+	const std::string& GetFragmentShaderPath() const;
+
+	// get the handle of the variant for a set of SHADER_* features
+	int GetVariant(int features);
+	// make a variant the current program
+	void UseVariant(int variantHandle);
+	// make the program loaded by the shader manager current again
+	void UseBaseProgram();
+
+	// set an int uniform on every variant, including later ones
+	void SetProgramInt(const std::string& name, int value);
+
+private:
+	struct PROGRAM_VARIANT
+	{
+		int features;
+		// linked program, or the shader manager program when the build failed
+		GLuint programID;
+	};
+
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to the uniform blocks and cached uniform locations
+	ShaderUniforms* m_pShaderUniforms;
+
+	// shader files and their source text
+	std::string m_vertexShaderPath;
+	std::string m_fragmentShaderPath;
+	std::string m_vertexSource;
+	std::string m_fragmentSource;
+
+	// built variants, the index is the variant handle
+	std::vector<PROGRAM_VARIANT> m_variants;
+	// variant handles by feature set
+	std::unordered_map<int, int> m_variantHandles;
+	// int uniforms shared by all of the variants
+	std::unordered_map<std::string, int> m_programInts;
+
+	// compile and link the shader sources for a feature set
+	GLuint BuildProgram(int features);
+	// attach the uniform blocks and set the shared int uniforms
+	void SetupProgram(GLuint programID);
+	// compile one shader stage, 0 on failure
+	GLuint CompileShader(GLenum shaderType, const std::string& source, const char* stageName);
+	// insert the feature defines after the #version line
+	std::string AddFeatureDefines(const std::string& source, int features);
+};
@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapegeometry.cpp
+// ============
+// generate the vertex and index data of the basic shapes on the CPU
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeGeometry.h"
+
+#include <cmath>
+
+// declaration of the global variables and defines
+namespace
+{
+	const float g_Pi = 3.14159265358979f;
+}
+
+/***********************************************************
+ *  AddVertex()
+ *
+ *  This method is used for appending one interleaved vertex
+ *  to the vertex list.
+ ***********************************************************/
+void ShapeGeometry::AddVertex(
+	std::vector<GLfloat>& vertices,
+	glm::vec3 position,
+	glm::vec3 normal,
+	glm::vec2 uv)
+{
+	vertices.push_back(position.x);
+	vertices.push_back(position.y);
+	vertices.push_back(position.z);
+	vertices.push_back(normal.x);
+	vertices.push_back(normal.y);
+	vertices.push_back(normal.z);
+	vertices.push_back(uv.x);
+	vertices.push_back(uv.y);
+}
+
+/***********************************************************
+ *  BuildShape()
+ *
+ *  This method is used for building the vertex and index
+ *  lists of the passed in shape.
+ ***********************************************************/
+void ShapeGeometry::BuildShape(
+	SHAPE_TYPE shape,
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices)
+{
+	switch (shape)
+	{
+	case SHAPE_BOX:
+		BuildBox(vertices, indices);
+		break;
+	case SHAPE_PLANE:
+		BuildPlane(vertices, indices);
+		break;
+	case SHAPE_CYLINDER:
+		BuildCylinder(vertices, indices);
+		break;
+	case SHAPE_SPHERE:
+		BuildSphere(vertices, indices);
+		break;
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  BuildBox()
+ *
+ *  This method is used for building a unit cube centered on
+ *  the origin, with four vertices per face so each face has
+ *  its own normal and full texture coordinates.
+ ***********************************************************/
+void ShapeGeometry::BuildBox(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+{
+	// face normal, face U direction and face V direction
+	const glm::vec3 faces[6][3] = {
+		{ glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f) },
+		{ glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) }
+	};
+
+	for (int face = 0; face < 6; face++)
+	{
+		GLuint first = (GLuint)(vertices.size() / FLOATS_PER_VERTEX);
+		glm::vec3 normal = faces[face][0];
+		glm::vec3 u = faces[face][1];
+		glm::vec3 v = faces[face][2];
+
+		AddVertex(vertices, (normal - u - v) * 0.5f, normal, glm::vec2(0.0f, 0.0f));
+		AddVertex(vertices, (normal + u - v) * 0.5f, normal, glm::vec2(1.0f, 0.0f));
+		AddVertex(vertices, (normal + u + v) * 0.5f, normal, glm::vec2(1.0f, 1.0f));
+		AddVertex(vertices, (normal - u + v) * 0.5f, normal, glm::vec2(0.0f, 1.0f));
+
+		indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+	}
+}
+
+/***********************************************************
+ *  BuildPlane()
+ *
+ *  This method is used for building a plane that spans -1
+ *  to 1 on the X and Z axes and faces up the Y axis.
+ ***********************************************************/
+void ShapeGeometry::BuildPlane(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+{
+	GLuint first = (GLuint)(vertices.size() / FLOATS_PER_VERTEX);
+	glm::vec3 normal(0.0f, 1.0f, 0.0f);
+
+	AddVertex(vertices, glm::vec3(-1.0f, 0.0f, 1.0f), normal, glm::vec2(0.0f, 0.0f));
+	AddVertex(vertices, glm::vec3(1.0f, 0.0f, 1.0f), normal, glm::vec2(1.0f, 0.0f));
+	AddVertex(vertices, glm::vec3(1.0f, 0.0f, -1.0f), normal, glm::vec2(1.0f, 1.0f));
+	AddVertex(vertices, glm::vec3(-1.0f, 0.0f, -1.0f), normal, glm::vec2(0.0f, 1.0f));
+
+	indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+}
+
+/***********************************************************
+ *  BuildCylinder()
+ *
+ *  This method is used for building a closed cylinder with
+ *  a radius of 1 that stands from y = 0 to y = 1, with the
+ *  passed in number of segments around it.
+ ***********************************************************/
+void ShapeGeometry::BuildCylinder(
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices,
+	int segments)
+{
+	GLuint first = (GLuint)(vertices.size() / FLOATS_PER_VERTEX);
+
+	// sides - the seam vertex is duplicated to close the texture
+	for (int i = 0; i <= segments; i++)
+	{
+		float u = (float)i / (float)segments;
+		float angle = u * 2.0f * g_Pi;
+		glm::vec3 normal(std::cos(angle), 0.0f, std::sin(angle));
+
+		AddVertex(vertices, glm::vec3(normal.x, 0.0f, normal.z), normal, glm::vec2(u, 0.0f));
+		AddVertex(vertices, glm::vec3(normal.x, 1.0f, normal.z), normal, glm::vec2(u, 1.0f));
+	}
+	for (GLuint i = 0; i < (GLuint)segments; i++)
+	{
+		GLuint bottom = first + (i * 2);
+		indices.insert(indices.end(), { bottom, bottom + 1, bottom + 3, bottom, bottom + 3, bottom + 2 });
+	}
+
+	// bottom and top caps
+	for (int cap = 0; cap < 2; cap++)
+	{
+		float y = (float)cap;
+		glm::vec3 normal(0.0f, (cap == 0) ? -1.0f : 1.0f, 0.0f);
+		GLuint center = (GLuint)(vertices.size() / FLOATS_PER_VERTEX);
+
+		AddVertex(vertices, glm::vec3(0.0f, y, 0.0f), normal, glm::vec2(0.5f, 0.5f));
+		for (int i = 0; i <= segments; i++)
+		{
+			float angle = (float)i / (float)segments * 2.0f * g_Pi;
+			float x = std::cos(angle);
+			float z = std::sin(angle);
+
+			AddVertex(vertices, glm::vec3(x, y, z), normal, glm::vec2(0.5f + (x * 0.5f), 0.5f + (z * 0.5f)));
+		}
+		for (GLuint i = 0; i < (GLuint)segments; i++)
+		{
+			if (cap == 0)
+				indices.insert(indices.end(), { center, center + i + 1, center + i + 2 });
+			else
+				indices.insert(indices.end(), { center, center + i + 2, center + i + 1 });
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildSphere()
+ *
+ *  This method is used for building a sphere with a radius
+ *  of 1 centered on the origin, with the passed in number
+ *  of segments around it and rings from pole to pole.
+ ***********************************************************/
+void ShapeGeometry::BuildSphere(
+	std::vector<GLfloat>& vertices,
+	std::vector<GLuint>& indices,
+	int segments,
+	int rings)
+{
+	GLuint first = (GLuint)(vertices.size() / FLOATS_PER_VERTEX);
+
+	for (int ring = 0; ring <= rings; ring++)
+	{
+		float v = (float)ring / (float)rings;
+		float phi = v * g_Pi;
+
+		for (int i = 0; i <= segments; i++)
+		{
+			float u = (float)i / (float)segments;
+			float theta = u * 2.0f * g_Pi;
+			glm::vec3 normal(
+				std::sin(phi) * std::cos(theta),
+				-std::cos(phi),
+				std::sin(phi) * std::sin(theta));
+
+			AddVertex(vertices, normal, normal, glm::vec2(u, v));
+		}
+	}
+
+	const GLuint rowLength = (GLuint)segments + 1;
+	for (GLuint ring = 0; ring < (GLuint)rings; ring++)
+	{
+		for (GLuint i = 0; i < (GLuint)segments; i++)
+		{
+			GLuint current = first + (ring * rowLength) + i;
+			GLuint above = current + rowLength;
+			indices.insert(indices.end(), { current, above, above + 1, current, above + 1, current + 1 });
+		}
+	}
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapegeometry.h
+// ============
+// generate the vertex and index data of the basic shapes on the CPU
+//
+//	The shapes match the ShapeMeshes conventions - the box is a unit cube
+//	centered on the origin, the plane spans -1 to 1 on X and Z facing +Y,
+//	the cylinder has a radius of 1 and stands from y = 0 to y = 1, and the
+//	sphere has a radius of 1.  Vertices are interleaved as position,
+//	normal and texture coordinate.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ShapeGeometry
+ *
+ *  This class contains the code for building the vertex
+ *  and index lists of the basic shapes.
+ ***********************************************************/
+class ShapeGeometry
+{
+public:
+	// basic shapes that can be generated
+	enum SHAPE_TYPE
+	{
+		SHAPE_BOX,
+		SHAPE_PLANE,
+		SHAPE_CYLINDER,
+		SHAPE_SPHERE,
+		SHAPE_COUNT
+	};
+
+	// interleaved vertex layout - position, normal, texture coordinate
+	static const GLuint FLOATS_PER_VERTEX = 8;
+	// full tessellation, the number of segments around the
+	// cylinder and sphere and of rings from pole to pole
+	static const int ROUND_SEGMENTS = 36;
+	static const int SPHERE_RINGS = 18;
+
+	// build the vertex and index lists of a shape
+	static void BuildShape(
+		SHAPE_TYPE shape,
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices);
+
+	static void BuildBox(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+	static void BuildPlane(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+	static void BuildCylinder(
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices,
+		int segments = ROUND_SEGMENTS);
+	static void BuildSphere(
+		std::vector<GLfloat>& vertices,
+		std::vector<GLuint>& indices,
+		int segments = ROUND_SEGMENTS,
+		int rings = SPHERE_RINGS);
+
+private:
+	// append one interleaved vertex to the vertex list
+	static void AddVertex(
+		std::vector<GLfloat>& vertices,
+		glm::vec3 position,
+		glm::vec3 normal,
+		glm::vec2 uv);
+};
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.cpp
+// ============
+// merge the shapes of the static scene into pre-transformed vertex buffers
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticBatches.h"
+#include "FrameProfiler.h"
+
+// declaration of the global variables and defines
+namespace
+{
+	// interleaved vertex layout - position, normal, texture coordinate
+	const GLuint g_FloatsPerVertex = ShapeGeometry::FLOATS_PER_VERTEX;
+}
+
+/***********************************************************
+ *  StaticBatches()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StaticBatches::StaticBatches()
+{
+}
+
+/***********************************************************
+ *  ~StaticBatches()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StaticBatches::~StaticBatches()
+{
+	Clear();
+}
+
+/***********************************************************
+ *  AddBatch()
+ *
+ *  This method is used for starting a new empty batch.  The
+ *  shapes added to it are uploaded by UploadBatches().
+ ***********************************************************/
+int StaticBatches::AddBatch()
+{
+	BATCH batch = {};
+
+	m_batches.push_back(batch);
+
+	return((int)m_batches.size() - 1);
+}
+
+/***********************************************************
+ *  AddShape()
+ *
+ *  This method is used for appending a copy of a shape to a
+ *  batch with its vertex positions moved into world space.
+ ***********************************************************/
+void StaticBatches::AddShape(
+	int batchIndex,
+	ShapeGeometry::SHAPE_TYPE shape,
+	const glm::mat4& worldMatrix)
+{
+	if ((batchIndex < 0) || (batchIndex >= (int)m_batches.size()) ||
+		(shape < 0) || (shape >= ShapeGeometry::SHAPE_COUNT))
+	{
+		return;
+	}
+
+	if (m_shapeVertices[shape].empty() == true)
+	{
+		ShapeGeometry::BuildShape(shape, m_shapeVertices[shape], m_shapeIndices[shape]);
+	}
+
+	BATCH& batch = m_batches[batchIndex];
+	const std::vector<GLfloat>& shapeVertices = m_shapeVertices[shape];
+	const std::vector<GLuint>& shapeIndices = m_shapeIndices[shape];
+	GLuint first = (GLuint)(batch.vertices.size() / g_FloatsPerVertex);
+
+	batch.vertices.reserve(batch.vertices.size() + shapeVertices.size());
+	for (size_t i = 0; i < shapeVertices.size(); i += g_FloatsPerVertex)
+	{
+		glm::vec4 position = worldMatrix *
+			glm::vec4(shapeVertices[i], shapeVertices[i + 1], shapeVertices[i + 2], 1.0f);
+
+		batch.vertices.push_back(position.x);
+		batch.vertices.push_back(position.y);
+		batch.vertices.push_back(position.z);
+		// normal and texture coordinate
+		batch.vertices.insert(batch.vertices.end(),
+			shapeVertices.begin() + i + 3, shapeVertices.begin() + i + g_FloatsPerVertex);
+	}
+
+	batch.indices.reserve(batch.indices.size() + shapeIndices.size());
+	for (GLuint index : shapeIndices)
+	{
+		batch.indices.push_back(first + index);
+	}
+}
+
+/***********************************************************
+ *  UploadBatches()
+ *
+ *  This method is used for creating the vertex array and
+ *  buffers of every batch from its collected geometry.  The
+ *  CPU copies are freed afterwards.
+ ***********************************************************/
+void StaticBatches::UploadBatches()
+{
+	const GLsizei stride = sizeof(GLfloat) * g_FloatsPerVertex;
+
+	for (BATCH& batch : m_batches)
+	{
+		if ((batch.vao != 0) || (batch.indices.empty() == true))
+		{
+			continue;
+		}
+
+		batch.nIndices = (GLuint)batch.indices.size();
+
+		glGenVertexArrays(1, &batch.vao);
+		glBindVertexArray(batch.vao);
+
+		glGenBuffers(2, batch.vbos);
+		glBindBuffer(GL_ARRAY_BUFFER, batch.vbos[0]);
+		glBufferData(GL_ARRAY_BUFFER, batch.vertices.size() * sizeof(GLfloat), batch.vertices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.vbos[1]);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, batch.indices.size() * sizeof(GLuint), batch.indices.data(), GL_STATIC_DRAW);
+
+		// position, normal and texture coordinate
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 3));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(GLfloat) * 6));
+		glEnableVertexAttribArray(2);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		std::vector<GLfloat>().swap(batch.vertices);
+		std::vector<GLuint>().swap(batch.indices);
+	}
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for freeing the GL buffers of every
+ *  batch.
+ ***********************************************************/
+void StaticBatches::Clear()
+{
+	for (BATCH& batch : m_batches)
+	{
+		if (batch.vao != 0)
+		{
+			glDeleteVertexArrays(1, &batch.vao);
+			glDeleteBuffers(2, batch.vbos);
+		}
+	}
+	m_batches.clear();
+}
+
+/***********************************************************
+ *  DrawBatch()
+ *
+ *  This method is used for drawing all of the shapes of a
+ *  batch with one draw call.  The model matrix is expected
+ *  to be the identity.
+ ***********************************************************/
+void StaticBatches::DrawBatch(int batchIndex) const
+{
+	if ((batchIndex < 0) || (batchIndex >= (int)m_batches.size()) ||
+		(m_batches[batchIndex].vao == 0))
+	{
+		return;
+	}
+
+	glBindVertexArray(m_batches[batchIndex].vao);
+	glDrawElements(GL_TRIANGLES, m_batches[batchIndex].nIndices, GL_UNSIGNED_INT, (void*)0);
+	FrameProfiler::CountStateChange();
+	FrameProfiler::CountDrawCall();
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  GetBatchCount()
+ *
+ *  This method is used for getting the number of batches.
+ ***********************************************************/
+int StaticBatches::GetBatchCount() const
+{
+	return((int)m_batches.size());
+}
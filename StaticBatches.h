@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticbatches.h
+// ============
+// merge the shapes of the static scene into pre-transformed vertex buffers
+//
+//	Every batch holds shapes that share one surface - texture or color and
+//	material.  Their world transformations are baked into the vertex
+//	positions once, so a whole batch is drawn with an identity model
+//	matrix and a single draw call.  Normals are copied unchanged, since
+//	the vertex shader passes the mesh normals through untransformed.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShapeGeometry.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  StaticBatches
+ *
+ *  This class contains the code for collecting transformed
+ *  copies of the basic shapes into batches, uploading them
+ *  and drawing each batch with one draw call.
+ ***********************************************************/
+class StaticBatches
+{
+public:
+	// constructor
+	StaticBatches();
+	// destructor
+	~StaticBatches();
+
+	// start a new empty batch and return its index
+	int AddBatch();
+	// append a copy of a shape transformed by a world matrix
+	void AddShape(
+		int batchIndex,
+		ShapeGeometry::SHAPE_TYPE shape,
+		const glm::mat4& worldMatrix);
+	// upload the collected geometry of every batch
+	void UploadBatches();
+	// free every batch
+	void Clear();
+
+	// draw all of the shapes of a batch
+	void DrawBatch(int batchIndex) const;
+	// number of batches
+	int GetBatchCount() const;
+
+private:
+	// GL buffers and collected geometry of a batch
+	struct BATCH
+	{
+		GLuint vao;
+		GLuint vbos[2];
+		GLuint nIndices;
+		std::vector<GLfloat> vertices;
+		std::vector<GLuint> indices;
+	};
+
+	std::vector<BATCH> m_batches;
+
+	// untransformed geometry of each shape, built on first use
+	std::vector<GLfloat> m_shapeVertices[ShapeGeometry::SHAPE_COUNT];
+	std::vector<GLuint> m_shapeIndices[ShapeGeometry::SHAPE_COUNT];
+};
@@ -0,0 +1,393 @@
+///////////////////////////////////////////////////////////////////////////////
+// streambuffer.cpp
+// ============
+// ring buffer for the data that is uploaded to the GPU every frame
+//
+//	The buffer is only ever bound to GL_COPY_WRITE_BUFFER for mapping, so
+//	the vertex array, uniform and texture buffer bindings of the callers
+//	are left alone.  Regions that the same frame read share its fence,
+//	so a fence is only deleted once no region holds it.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// declaration of the global variables and defines
+namespace
+{
+	// longest single wait on a fence, in nanoseconds, before the
+	// wait is started again
+	const GLuint64 g_FenceTimeout = 1000000;
+
+	// round a size up to a multiple of an alignment
+	size_t AlignSize(size_t size, size_t alignment)
+	{
+		return(((size + alignment - 1) / alignment) * alignment);
+	}
+}
+
+/***********************************************************
+ *  StreamBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StreamBuffer::StreamBuffer(size_t regionBytes, size_t alignment)
+{
+	m_buffer = 0;
+	m_pMapped = NULL;
+	m_alignment = std::max(alignment, (size_t)16);
+	m_regionBytes = AlignSize(std::max(regionBytes, m_alignment), m_alignment);
+	m_fences.assign(STREAM_BUFFER_REGIONS, (GLsync)0);
+	m_region = 0;
+	m_offset = 0;
+	m_bRegionReady = true;
+	m_latestRegion = -1;
+	m_previousRegion = -1;
+	m_writeOffset = 0;
+	m_writeSize = 0;
+
+	CreateBuffer();
+}
+
+/***********************************************************
+ *  ~StreamBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StreamBuffer::~StreamBuffer()
+{
+	for (int i = 0; i < STREAM_BUFFER_REGIONS; ++i)
+	{
+		SetRegionFence(i, 0);
+	}
+
+	for (const RETIRED_BUFFER& retired : m_retiredBuffers)
+	{
+		DeleteBuffer(retired.buffer, retired.bMapped);
+	}
+	m_retiredBuffers.clear();
+
+	DeleteBuffer(m_buffer, (NULL != m_pMapped));
+	m_buffer = 0;
+	m_pMapped = NULL;
+}
+
+/***********************************************************
+ *  CreateBuffer()
+ *
+ *  This method is used for creating the buffer with room for
+ *  all of the regions.  Immutable storage is mapped once for
+ *  good where the driver has it, otherwise the buffer gets
+ *  regular storage and each write maps its range.
+ ***********************************************************/
+void StreamBuffer::CreateBuffer()
+{
+	GLsizeiptr totalBytes = (GLsizeiptr)(m_regionBytes * STREAM_BUFFER_REGIONS);
+
+	glGenBuffers(1, &m_buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+	if (GLEW_ARB_buffer_storage != 0)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, NULL, flags);
+		m_pMapped = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, flags);
+
+		// immutable storage cannot be given other flags, so a
+		// buffer that did not map is made again without it
+		if (NULL == m_pMapped)
+		{
+			std::cout << "Could not map the stream buffer persistently, mapping each write instead" << std::endl;
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			glDeleteBuffers(1, &m_buffer);
+			glGenBuffers(1, &m_buffer);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+		}
+	}
+
+	if (NULL == m_pMapped)
+	{
+		glBufferData(GL_COPY_WRITE_BUFFER, totalBytes, NULL, GL_STREAM_DRAW);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	m_region = 0;
+	m_offset = 0;
+}
+
+/***********************************************************
+ *  DeleteBuffer()
+ *
+ *  This method is used for unmapping and deleting a buffer
+ *  object.  Draws that were queued with the buffer keep
+ *  reading it, GL frees it once they are done.
+ ***********************************************************/
+void StreamBuffer::DeleteBuffer(GLuint buffer, bool bMapped)
+{
+	if (buffer == 0)
+	{
+		return;
+	}
+
+	if (bMapped == true)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	glDeleteBuffers(1, &buffer);
+}
+
+/***********************************************************
+ *  GrowBuffer()
+ *
+ *  This method is used for moving the rest of the frame to
+ *  a new buffer with larger regions.  The old buffer holds
+ *  the data of the draws already queued in this frame, so
+ *  it is only deleted at the end of the frame, and nothing
+ *  is waited on since the new buffer is not read yet.
+ ***********************************************************/
+void StreamBuffer::GrowBuffer(size_t regionBytes)
+{
+	RETIRED_BUFFER retired;
+	retired.buffer = m_buffer;
+	retired.bMapped = (NULL != m_pMapped);
+	m_retiredBuffers.push_back(retired);
+
+	// the fences only guarded the regions of the old buffer
+	for (int i = 0; i < STREAM_BUFFER_REGIONS; ++i)
+	{
+		SetRegionFence(i, 0);
+	}
+
+	m_buffer = 0;
+	m_pMapped = NULL;
+	m_regionBytes = AlignSize(regionBytes, m_alignment);
+	CreateBuffer();
+
+	m_bRegionReady = true;
+	m_latestRegion = -1;
+	m_previousRegion = -1;
+
+	std::cout << "INFO: stream buffer grown to " << ((m_regionBytes * STREAM_BUFFER_REGIONS) / 1024) << " KB" << std::endl;
+}
+
+/***********************************************************
+ *  BeginWrite()
+ *
+ *  This method is used for reserving room for a write in
+ *  the region of the current frame.  The first write of a
+ *  frame waits for the draws that last read the region.  A
+ *  frame that does not fit in its region continues in a new
+ *  buffer with room for all of it, which the callers pick
+ *  up from GetBuffer() after the write.
+ ***********************************************************/
+void* StreamBuffer::BeginWrite(size_t size)
+{
+	size = std::max(size, (size_t)1);
+
+	if (m_bRegionReady == false)
+	{
+		WaitForRegion(m_region);
+		m_bRegionReady = true;
+	}
+
+	size_t start = AlignSize(m_offset, m_alignment);
+	if ((start + size) > ((m_region + 1) * m_regionBytes))
+	{
+		size_t frameBytes = (start - (m_region * m_regionBytes)) + size;
+
+		GrowBuffer(std::max(m_regionBytes * 2, frameBytes));
+		start = m_offset;
+	}
+
+	m_writeOffset = start;
+	m_writeSize = size;
+	m_offset = start + size;
+
+	if (NULL != m_pMapped)
+	{
+		return(m_pMapped + start);
+	}
+
+	// the fences already keep the range out of the way of the GPU
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+	void* pMapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, (GLintptr)start, (GLsizeiptr)size,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	return(pMapped);
+}
+
+/***********************************************************
+ *  EndWrite()
+ *
+ *  This method is used for finishing a write.  Coherent
+ *  persistent memory is seen by the GPU as it is written,
+ *  a range that was mapped for the write is unmapped.
+ ***********************************************************/
+GLintptr StreamBuffer::EndWrite()
+{
+	if (NULL == m_pMapped)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	m_latestRegion = m_region;
+
+	return((GLintptr)m_writeOffset);
+}
+
+/***********************************************************
+ *  Write()
+ *
+ *  This method is used for copying data into the buffer
+ *  with one write.
+ ***********************************************************/
+GLintptr StreamBuffer::Write(const void* data, size_t size)
+{
+	void* pTarget = BeginWrite(size);
+
+	if ((NULL != pTarget) && (size > 0))
+	{
+		memcpy(pTarget, data, size);
+	}
+
+	return(EndWrite());
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for queuing a fence behind the draws
+ *  of the frame.  It guards the region of the latest write
+ *  and the region that was latest when the frame started,
+ *  since the draws of the frame may have read either one.
+ *  The buffers replaced during the frame are deleted, and
+ *  the next region that does not hold the latest write is
+ *  made current.  Its fence is waited on by the first write
+ *  of the next frame, not here, so a frame that writes
+ *  nothing never waits.
+ ***********************************************************/
+void StreamBuffer::EndFrame()
+{
+	if ((m_latestRegion >= 0) || (m_previousRegion >= 0))
+	{
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		if (m_latestRegion >= 0)
+		{
+			SetRegionFence(m_latestRegion, fence);
+		}
+		if ((m_previousRegion >= 0) && (m_previousRegion != m_latestRegion))
+		{
+			SetRegionFence(m_previousRegion, fence);
+		}
+	}
+
+	for (const RETIRED_BUFFER& retired : m_retiredBuffers)
+	{
+		DeleteBuffer(retired.buffer, retired.bMapped);
+	}
+	m_retiredBuffers.clear();
+
+	int nextRegion = (m_region + 1) % STREAM_BUFFER_REGIONS;
+	if (nextRegion == m_latestRegion)
+	{
+		nextRegion = (nextRegion + 1) % STREAM_BUFFER_REGIONS;
+	}
+
+	m_region = nextRegion;
+	m_offset = m_region * m_regionBytes;
+	m_bRegionReady = false;
+	m_previousRegion = m_latestRegion;
+}
+
+/***********************************************************
+ *  SetRegionFence()
+ *
+ *  This method is used for replacing the fence of a region.
+ *  The old fence is deleted unless another region of the
+ *  same frame still holds it.
+ ***********************************************************/
+void StreamBuffer::SetRegionFence(int region, GLsync fence)
+{
+	GLsync oldFence = m_fences[region];
+
+	m_fences[region] = fence;
+
+	if ((oldFence == 0) || (oldFence == fence))
+	{
+		return;
+	}
+
+	for (GLsync other : m_fences)
+	{
+		if (other == oldFence)
+		{
+			return;
+		}
+	}
+
+	glDeleteSync(oldFence);
+}
+
+/***********************************************************
+ *  WaitForRegion()
+ *
+ *  This method is used for waiting on the fence of a region.
+ *  The first wait flushes the queued commands, so the fence
+ *  is sure to be reached.
+ ***********************************************************/
+void StreamBuffer::WaitForRegion(int region)
+{
+	GLsync fence = m_fences[region];
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+	if (fence == 0)
+	{
+		return;
+	}
+
+	while (true)
+	{
+		GLenum result = glClientWaitSync(fence, flags, g_FenceTimeout);
+
+		if ((result == GL_ALREADY_SIGNALED) || (result == GL_CONDITION_SATISFIED) || (result == GL_WAIT_FAILED))
+		{
+			break;
+		}
+		flags = 0;
+	}
+
+	SetRegionFence(region, 0);
+}
+
+/***********************************************************
+ *  GetBuffer()
+ *
+ *  This method is used for getting the buffer object that
+ *  the latest write went into.
+ ***********************************************************/
+GLuint StreamBuffer::GetBuffer() const
+{
+	return(m_buffer);
+}
+
+/***********************************************************
+ *  IsPersistent()
+ *
+ *  This method is used for checking whether the buffer is
+ *  mapped once for good or mapped by each write.
+ ***********************************************************/
+bool StreamBuffer::IsPersistent() const
+{
+	return(NULL != m_pMapped);
+}
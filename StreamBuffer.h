@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// streambuffer.h
+// ============
+// ring buffer for the data that is uploaded to the GPU every frame
+//
+//	Uploading with glBufferData() or glBufferSubData() into a buffer that
+//	queued draws still read makes the driver wait for them or copy the
+//	data aside.  A stream buffer is split into STREAM_BUFFER_REGIONS
+//	regions, one per frame in flight, and the writes of a frame go one
+//	after another into the region of that frame.  EndFrame() is called
+//	once the draws of the frame are submitted and queues a fence behind
+//	them, and a region is only written again after its fence has passed.
+//	With GL_ARB_buffer_storage (core in GL 4.4) the buffer is mapped once,
+//	persistently and coherently, so a write is a plain memory copy.  On a
+//	plain GL 3.3 driver each write maps its range without synchronizing,
+//	which the fences make safe in the same way.  Every write replaces the
+//	data of the one before, so users point GL at the buffer and offset of
+//	each write as it is made.  The latest write may be drawn for many
+//	frames without being written again, so its region is fenced by each of
+//	those frames and skipped by the ring until newer data replaces it.  A
+//	frame that outgrows its region moves to a new buffer with larger
+//	regions, and the old buffer is kept until the end of the frame for
+//	the draws that were queued with it.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+// regions of a stream buffer, one more than the frames in flight
+#define STREAM_BUFFER_REGIONS 3
+
+/***********************************************************
+ *  StreamBuffer
+ *
+ *  This class contains a buffer of fenced per-frame regions
+ *  and the code for writing data into it without stalling.
+ ***********************************************************/
+class StreamBuffer
+{
+public:
+	// constructor, with the starting size of a region and the
+	// alignment of the write offsets, needs a current GL context
+	StreamBuffer(size_t regionBytes, size_t alignment);
+	// destructor
+	~StreamBuffer();
+
+	// start a write and get the memory to write into, a frame that
+	// outgrows its region moves to a larger buffer
+	void* BeginWrite(size_t size);
+	// finish the write and get its offset in the buffer
+	GLintptr EndWrite();
+	// copy data in with one write and get its offset
+	GLintptr Write(const void* data, size_t size);
+
+	// fence the regions read by the draws of this frame and move on
+	// to the region of the next frame, called once the frame's draws
+	// are submitted
+	void EndFrame();
+
+	// buffer object to bind, it changes when the buffer grows
+	GLuint GetBuffer() const;
+	// true when the buffer is mapped persistently
+	bool IsPersistent() const;
+
+private:
+	// buffer that was replaced during a frame, its data is read by
+	// the draws of that frame
+	struct RETIRED_BUFFER
+	{
+		GLuint buffer;
+		bool bMapped;
+	};
+
+	GLuint m_buffer;
+	// persistently mapped memory of the whole buffer, NULL when
+	// every write maps its own range
+	unsigned char* m_pMapped;
+	size_t m_regionBytes;
+	size_t m_alignment;
+	// fence behind the last frame that read each region, regions
+	// read by the same frame share its fence
+	std::vector<GLsync> m_fences;
+	// region of the current frame and the next free offset in it
+	int m_region;
+	size_t m_offset;
+	// false until the fence of the current region has been waited on
+	bool m_bRegionReady;
+	// region of the latest write, -1 before the first one
+	int m_latestRegion;
+	// region of the latest write when the frame started, which the
+	// draws of the frame read until they are given a newer write
+	int m_previousRegion;
+	// range of the write in progress
+	size_t m_writeOffset;
+	size_t m_writeSize;
+	// buffers that are deleted at the end of the frame
+	std::vector<RETIRED_BUFFER> m_retiredBuffers;
+
+	// create and map the buffer for the current region size
+	void CreateBuffer();
+	// unmap and delete a buffer object
+	static void DeleteBuffer(GLuint buffer, bool bMapped);
+	// move the frame to a new buffer with larger regions, the old
+	// buffer is kept until the end of the frame
+	void GrowBuffer(size_t regionBytes);
+	// set or clear the fence of a region, deleting the old fence
+	// once no region shares it
+	void SetRegionFence(int region, GLsync fence);
+	// wait until the draws that read a region have finished
+	void WaitForRegion(int region);
+};
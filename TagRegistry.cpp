@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.cpp
+// ============
+// intern the string tags of scene resources into stable integer handles
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TagRegistry.h"
+
+// declaration of global variables
+namespace
+{
+	// returned for handles that were never registered
+	const std::string g_EmptyTag;
+}
+
+/***********************************************************
+ *  Register()
+ *
+ *  This method is used for registering a new tag.  The
+ *  returned handle is the next index of the resource array
+ *  of the owner.  A tag can only be registered once.
+ ***********************************************************/
+int TagRegistry::Register(const std::string& tag)
+{
+	int handle = (int)m_tags.size();
+
+	if (m_handles.emplace(tag, handle).second == false)
+	{
+		return(INVALID_HANDLE);
+	}
+	m_tags.push_back(tag);
+
+	return(handle);
+}
+
+/***********************************************************
+ *  Find()
+ *
+ *  This method is used for getting the handle of a
+ *  registered tag, or INVALID_HANDLE when no resource has
+ *  been registered with that tag.
+ ***********************************************************/
+int TagRegistry::Find(const std::string& tag) const
+{
+	std::unordered_map<std::string, int>::const_iterator found = m_handles.find(tag);
+
+	if (found == m_handles.end())
+	{
+		return(INVALID_HANDLE);
+	}
+
+	return(found->second);
+}
+
+/***********************************************************
+ *  GetTag()
+ *
+ *  This method is used for getting the tag that a handle
+ *  was registered with, empty for an unknown handle.
+ ***********************************************************/
+const std::string& TagRegistry::GetTag(int handle) const
+{
+	if ((handle < 0) || (handle >= (int)m_tags.size()))
+	{
+		return(g_EmptyTag);
+	}
+
+	return(m_tags[handle]);
+}
+
+/***********************************************************
+ *  GetCount()
+ *
+ *  This method is used for getting the number of
+ *  registered tags.
+ ***********************************************************/
+int TagRegistry::GetCount() const
+{
+	return((int)m_tags.size());
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for forgetting all of the registered
+ *  tags, after the resources they name have been freed.
+ ***********************************************************/
+void TagRegistry::Clear()
+{
+	m_handles.clear();
+	m_tags.clear();
+}
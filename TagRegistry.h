@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+// tagregistry.h
+// ============
+// intern the string tags of scene resources into stable integer handles
+//
+//	A tag is hashed once when its resource is registered or resolved at
+//	load time.  The handle is the index of the resource in its owner's flat
+//	array, so the draw code reads resources by handle without looking at a
+//	string.  Handles are never reused while the registry lives.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************
+ *  TagRegistry
+ *
+ *  This class contains the mapping between resource tags
+ *  and the handles they were registered with.
+ ***********************************************************/
+class TagRegistry
+{
+public:
+	// handle returned when a tag is not registered
+	static const int INVALID_HANDLE = -1;
+
+	// register a new tag and return its handle, or
+	// INVALID_HANDLE if the tag is already registered
+	int Register(const std::string& tag);
+	// find the handle of a registered tag, or INVALID_HANDLE
+	int Find(const std::string& tag) const;
+
+	// get the tag that a handle was registered with
+	const std::string& GetTag(int handle) const;
+	// number of registered tags
+	int GetCount() const;
+
+	// forget all of the registered tags
+	void Clear();
+
+private:
+	// handle of each registered tag
+	std::unordered_map<std::string, int> m_handles;
+	// tag of each handle
+	std::vector<std::string> m_tags;
+};
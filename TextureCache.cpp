@@ -0,0 +1,698 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.cpp
+// ============
+// block-compressed texture images with a baked mip chain, cached on disk
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureCache.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// DDS file layout, see the DirectX "DDS_HEADER" reference
+	struct DDS_PIXELFORMAT
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t rgbBitCount;
+		uint32_t redMask;
+		uint32_t greenMask;
+		uint32_t blueMask;
+		uint32_t alphaMask;
+	};
+
+	struct DDS_HEADER
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		DDS_PIXELFORMAT pixelFormat;
+		uint32_t caps;
+		uint32_t caps2;
+		uint32_t caps3;
+		uint32_t caps4;
+		uint32_t reserved2;
+	};
+
+	static_assert(sizeof(DDS_HEADER) == 124, "DDS_HEADER must be 124 bytes");
+
+	const uint32_t g_DDSMagic = 0x20534444;	// "DDS "
+	const uint32_t g_FourCCDXT1 = 0x31545844;	// "DXT1"
+	const uint32_t g_FourCCDXT5 = 0x35545844;	// "DXT5"
+
+	// DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE
+	const uint32_t g_DDSHeaderFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+	// DDPF_FOURCC
+	const uint32_t g_DDSFourCCFlag = 0x4;
+	// DDSCAPS_COMPLEX | DDSCAPS_TEXTURE | DDSCAPS_MIPMAP
+	const uint32_t g_DDSCaps = 0x8 | 0x1000 | 0x400000;
+
+	const char* g_CacheExtension = ".dds";
+
+	// largest texture the driver takes, cache files with larger images
+	// are ignored, set from the GL thread before any loader starts
+	int g_MaxTextureSize = 16384;
+
+	/***********************************************************
+	 *  GetBlockSize()
+	 *
+	 *  Returns the number of bytes of a 4x4 block.
+	 ***********************************************************/
+	size_t GetBlockSize(bool bAlpha)
+	{
+		return(bAlpha ? 16 : 8);
+	}
+
+	/***********************************************************
+	 *  GetLevelSize()
+	 *
+	 *  Returns the number of bytes of a compressed level.
+	 ***********************************************************/
+	size_t GetLevelSize(int width, int height, bool bAlpha)
+	{
+		size_t blocksX = (size_t)std::max(1, (width + 3) / 4);
+		size_t blocksY = (size_t)std::max(1, (height + 3) / 4);
+
+		return(blocksX * blocksY * GetBlockSize(bAlpha));
+	}
+
+	/***********************************************************
+	 *  GetModifiedTime()
+	 *
+	 *  Gets the last modification time of a file at the finest
+	 *  resolution the file system stores, so an image saved in
+	 *  the same second as its cache file still compares newer.
+	 *  Returns false if the file does not exist.
+	 ***********************************************************/
+	bool GetModifiedTime(const std::string& filename, long long& modifiedTime)
+	{
+#ifdef _WIN32
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+		// the write time is counted in 100 nanosecond steps
+		if (GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &attributes) == FALSE)
+		{
+			return(false);
+		}
+		modifiedTime = ((long long)attributes.ftLastWriteTime.dwHighDateTime << 32) |
+			(long long)attributes.ftLastWriteTime.dwLowDateTime;
+#else
+		struct stat fileStatus;
+
+		if (stat(filename.c_str(), &fileStatus) != 0)
+		{
+			return(false);
+		}
+#ifdef __APPLE__
+		const struct timespec& writeTime = fileStatus.st_mtimespec;
+#else
+		const struct timespec& writeTime = fileStatus.st_mtim;
+#endif
+		modifiedTime = ((long long)writeTime.tv_sec * 1000000000LL) + (long long)writeTime.tv_nsec;
+#endif
+
+		return(true);
+	}
+
+	/***********************************************************
+	 *  PackColor565()
+	 *
+	 *  Packs an 8 bit per channel color into 5:6:5 bits.
+	 ***********************************************************/
+	uint16_t PackColor565(const int color[3])
+	{
+		return((uint16_t)(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3)));
+	}
+
+	/***********************************************************
+	 *  UnpackColor565()
+	 *
+	 *  Expands a 5:6:5 color back to 8 bits per channel, the
+	 *  same way the GPU does.
+	 ***********************************************************/
+	void UnpackColor565(uint16_t packed, int color[3])
+	{
+		int red = (packed >> 11) & 0x1F;
+		int green = (packed >> 5) & 0x3F;
+		int blue = packed & 0x1F;
+
+		color[0] = (red << 3) | (red >> 2);
+		color[1] = (green << 2) | (green >> 4);
+		color[2] = (blue << 3) | (blue >> 2);
+	}
+
+	/***********************************************************
+	 *  CompressColorBlock()
+	 *
+	 *  Compresses the colors of 16 RGBA pixels into a BC1 block.
+	 *  The end points are the slightly inset corners of the
+	 *  color bounding box, which is fast and close enough for
+	 *  the scene textures.
+	 ***********************************************************/
+	void CompressColorBlock(const unsigned char pixels[64], unsigned char* block)
+	{
+		int minColor[3] = { 255, 255, 255 };
+		int maxColor[3] = { 0, 0, 0 };
+
+		for (int i = 0; i < 16; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				minColor[c] = std::min(minColor[c], (int)pixels[i * 4 + c]);
+				maxColor[c] = std::max(maxColor[c], (int)pixels[i * 4 + c]);
+			}
+		}
+		for (int c = 0; c < 3; c++)
+		{
+			int inset = (maxColor[c] - minColor[c]) >> 4;
+			minColor[c] += inset;
+			maxColor[c] -= inset;
+		}
+
+		uint16_t color0 = PackColor565(maxColor);
+		uint16_t color1 = PackColor565(minColor);
+		uint32_t indices = 0;
+
+		// color0 > color1 selects the four color mode
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+		}
+
+		if (color0 != color1)
+		{
+			int palette[4][3];
+
+			UnpackColor565(color0, palette[0]);
+			UnpackColor565(color1, palette[1]);
+			for (int c = 0; c < 3; c++)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				int bestIndex = 0;
+				int bestDistance = 0x7FFFFFFF;
+
+				for (int p = 0; p < 4; p++)
+				{
+					int distance = 0;
+					for (int c = 0; c < 3; c++)
+					{
+						int difference = (int)pixels[i * 4 + c] - palette[p][c];
+						distance += difference * difference;
+					}
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+				indices |= (uint32_t)bestIndex << (i * 2);
+			}
+		}
+
+		block[0] = (unsigned char)(color0 & 0xFF);
+		block[1] = (unsigned char)(color0 >> 8);
+		block[2] = (unsigned char)(color1 & 0xFF);
+		block[3] = (unsigned char)(color1 >> 8);
+		for (int i = 0; i < 4; i++)
+		{
+			block[4 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+		}
+	}
+
+	/***********************************************************
+	 *  CompressAlphaBlock()
+	 *
+	 *  Compresses the alpha of 16 RGBA pixels into the alpha
+	 *  half of a BC3 block, using the eight value mode.
+	 ***********************************************************/
+	void CompressAlphaBlock(const unsigned char pixels[64], unsigned char* block)
+	{
+		int minAlpha = 255;
+		int maxAlpha = 0;
+
+		for (int i = 0; i < 16; i++)
+		{
+			minAlpha = std::min(minAlpha, (int)pixels[i * 4 + 3]);
+			maxAlpha = std::max(maxAlpha, (int)pixels[i * 4 + 3]);
+		}
+
+		uint64_t indices = 0;
+
+		if (maxAlpha != minAlpha)
+		{
+			int palette[8];
+
+			palette[0] = maxAlpha;
+			palette[1] = minAlpha;
+			for (int p = 1; p < 7; p++)
+			{
+				palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+			}
+
+			for (int i = 0; i < 16; i++)
+			{
+				int bestIndex = 0;
+				int bestDistance = 256;
+
+				for (int p = 0; p < 8; p++)
+				{
+					int distance = std::abs((int)pixels[i * 4 + 3] - palette[p]);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = p;
+					}
+				}
+				indices |= (uint64_t)bestIndex << (i * 3);
+			}
+		}
+
+		block[0] = (unsigned char)maxAlpha;
+		block[1] = (unsigned char)minAlpha;
+		for (int i = 0; i < 6; i++)
+		{
+			block[2 + i] = (unsigned char)((indices >> (i * 8)) & 0xFF);
+		}
+	}
+
+	/***********************************************************
+	 *  ReadWholeFile()
+	 *
+	 *  Reads the bytes of a binary file.  Returns false if the
+	 *  file could not be read.
+	 ***********************************************************/
+	bool ReadWholeFile(const std::string& filename, std::vector<unsigned char>& contents)
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			return(false);
+		}
+
+		std::streamoff fileSize = file.tellg();
+		if (fileSize <= 0)
+		{
+			return(false);
+		}
+
+		contents.resize((size_t)fileSize);
+		file.seekg(0, std::ios::beg);
+		file.read((char*)contents.data(), fileSize);
+
+		return(file.good());
+	}
+}
+
+/***********************************************************
+ *  GetCacheFilename()
+ *
+ *  This method is used for getting the name of the cache
+ *  file that belongs to an image file.
+ ***********************************************************/
+std::string TextureCache::GetCacheFilename(const std::string& imageFilename)
+{
+	return(imageFilename + g_CacheExtension);
+}
+
+/***********************************************************
+ *  LoadCachedTexture()
+ *
+ *  This method is used for reading the cache file of an
+ *  image.  It returns false when there is no cache file, it
+ *  is older than the image or it can not be used.
+ ***********************************************************/
+bool TextureCache::LoadCachedTexture(
+	const std::string& imageFilename,
+	TEXTURE_DATA& texture)
+{
+	std::string cacheFilename = GetCacheFilename(imageFilename);
+	long long imageTime = 0;
+	long long cacheTime = 0;
+
+	if (GetModifiedTime(cacheFilename, cacheTime) == false)
+	{
+		return(false);
+	}
+	// an image that was edited after the cache was written wins
+	if ((GetModifiedTime(imageFilename, imageTime) == true) && (imageTime > cacheTime))
+	{
+		return(false);
+	}
+
+	std::vector<unsigned char> contents;
+	if (ReadWholeFile(cacheFilename, contents) == false)
+	{
+		return(false);
+	}
+
+	uint32_t magic = 0;
+	DDS_HEADER header;
+	size_t dataOffset = sizeof(magic) + sizeof(DDS_HEADER);
+
+	if (contents.size() < dataOffset)
+	{
+		return(false);
+	}
+	memcpy(&magic, contents.data(), sizeof(magic));
+	memcpy(&header, contents.data() + sizeof(magic), sizeof(DDS_HEADER));
+
+	bool bAlpha = (header.pixelFormat.fourCC == g_FourCCDXT5);
+	if ((magic != g_DDSMagic) || (header.size != sizeof(DDS_HEADER)) ||
+		((header.pixelFormat.fourCC != g_FourCCDXT1) && (bAlpha == false)) ||
+		(header.width == 0) || (header.height == 0) || (header.mipMapCount == 0))
+	{
+		std::cout << "Ignoring unsupported texture cache file:" << cacheFilename << std::endl;
+		return(false);
+	}
+
+	// the header is checked before anything is sized from it, so a
+	// corrupt file cannot ask for huge or negative levels
+	uint32_t fullMipCount = 1;
+	for (uint32_t size = std::max(header.width, header.height); size > 1; size /= 2)
+	{
+		fullMipCount++;
+	}
+	if ((header.width > (uint32_t)g_MaxTextureSize) || (header.height > (uint32_t)g_MaxTextureSize) ||
+		(header.mipMapCount > fullMipCount))
+	{
+		std::cout << "Ignoring corrupt texture cache file:" << cacheFilename << std::endl;
+		return(false);
+	}
+
+	texture.width = (int)header.width;
+	texture.height = (int)header.height;
+	texture.colorChannels = bAlpha ? 4 : 3;
+	texture.compressedFormat = bAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	texture.levels.clear();
+
+	int levelWidth = texture.width;
+	int levelHeight = texture.height;
+	size_t levelOffset = 0;
+	for (uint32_t i = 0; i < header.mipMapCount; i++)
+	{
+		MIP_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.offset = levelOffset;
+		level.size = GetLevelSize(levelWidth, levelHeight, bAlpha);
+		texture.levels.push_back(level);
+
+		levelOffset += level.size;
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	if (contents.size() - dataOffset < levelOffset)
+	{
+		std::cout << "Ignoring truncated texture cache file:" << cacheFilename << std::endl;
+		return(false);
+	}
+	texture.pixels.assign(contents.begin() + dataOffset, contents.begin() + dataOffset + levelOffset);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetMaxTextureSize()
+ *
+ *  This method is used for setting the largest width and
+ *  height that a cache file may have.  It is read by the
+ *  loader threads, so it has to be set before they start.
+ ***********************************************************/
+void TextureCache::SetMaxTextureSize(int size)
+{
+	if (size > 0)
+	{
+		g_MaxTextureSize = size;
+	}
+}
+
+/***********************************************************
+ *  SaveCachedTexture()
+ *
+ *  This method is used for writing a compressed texture into
+ *  the cache file of its image.
+ ***********************************************************/
+bool TextureCache::SaveCachedTexture(
+	const std::string& imageFilename,
+	const TEXTURE_DATA& texture)
+{
+	if ((texture.compressedFormat == 0) || (texture.levels.empty() == true))
+	{
+		return(false);
+	}
+
+	std::string cacheFilename = GetCacheFilename(imageFilename);
+	std::ofstream file(cacheFilename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		std::cout << "Could not write texture cache file:" << cacheFilename << std::endl;
+		return(false);
+	}
+
+	DDS_HEADER header;
+	memset(&header, 0, sizeof(header));
+	header.size = sizeof(DDS_HEADER);
+	header.flags = g_DDSHeaderFlags;
+	header.height = (uint32_t)texture.height;
+	header.width = (uint32_t)texture.width;
+	header.pitchOrLinearSize = (uint32_t)texture.levels[0].size;
+	header.mipMapCount = (uint32_t)texture.levels.size();
+	header.pixelFormat.size = sizeof(DDS_PIXELFORMAT);
+	header.pixelFormat.flags = g_DDSFourCCFlag;
+	header.pixelFormat.fourCC = (texture.compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) ? g_FourCCDXT5 : g_FourCCDXT1;
+	header.caps = g_DDSCaps;
+
+	file.write((const char*)&g_DDSMagic, sizeof(g_DDSMagic));
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)texture.pixels.data(), (std::streamsize)texture.pixels.size());
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  ResampleImage()
+ *
+ *  This method is used for resampling a decoded image to a
+ *  square size class.  The texture coordinates of the scene
+ *  span the whole image, so the change of aspect ratio does
+ *  not show when it is drawn.
+ ***********************************************************/
+void TextureCache::ResampleImage(
+	const unsigned char* image,
+	int width,
+	int height,
+	int colorChannels,
+	int size,
+	std::vector<unsigned char>& resampled)
+{
+	resampled.resize((size_t)size * size * colorChannels);
+
+	for (int y = 0; y < size; y++)
+	{
+		// sample at the pixel centers of the new size
+		float sourceY = std::max(0.0f, (y + 0.5f) * height / size - 0.5f);
+		int row0 = std::min((int)sourceY, height - 1);
+		int row1 = std::min(row0 + 1, height - 1);
+		float weightY = sourceY - row0;
+
+		for (int x = 0; x < size; x++)
+		{
+			float sourceX = std::max(0.0f, (x + 0.5f) * width / size - 0.5f);
+			int column0 = std::min((int)sourceX, width - 1);
+			int column1 = std::min(column0 + 1, width - 1);
+			float weightX = sourceX - column0;
+
+			for (int c = 0; c < colorChannels; c++)
+			{
+				float top =
+					image[((size_t)row0 * width + column0) * colorChannels + c] * (1.0f - weightX) +
+					image[((size_t)row0 * width + column1) * colorChannels + c] * weightX;
+				float bottom =
+					image[((size_t)row1 * width + column0) * colorChannels + c] * (1.0f - weightX) +
+					image[((size_t)row1 * width + column1) * colorChannels + c] * weightX;
+				resampled[((size_t)y * size + x) * colorChannels + c] =
+					(unsigned char)(top * (1.0f - weightY) + bottom * weightY + 0.5f);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  CompressTexture()
+ *
+ *  This method is used for building the full mip chain of a
+ *  decoded RGB or RGBA image and compressing each level.
+ *  RGB images become BC1 and RGBA images become BC3.
+ ***********************************************************/
+void TextureCache::CompressTexture(
+	const unsigned char* image,
+	int width,
+	int height,
+	int colorChannels,
+	TEXTURE_DATA& texture)
+{
+	bool bAlpha = (colorChannels == 4);
+	std::vector<unsigned char> rgba((size_t)width * height * 4);
+	std::vector<unsigned char> halved;
+	std::vector<unsigned char> blocks;
+
+	// the levels are built and compressed from RGBA8 pixels
+	for (size_t i = 0; i < (size_t)width * height; i++)
+	{
+		rgba[i * 4 + 0] = image[i * colorChannels + 0];
+		rgba[i * 4 + 1] = image[i * colorChannels + 1];
+		rgba[i * 4 + 2] = image[i * colorChannels + 2];
+		rgba[i * 4 + 3] = bAlpha ? image[i * colorChannels + 3] : 255;
+	}
+
+	texture.width = width;
+	texture.height = height;
+	texture.colorChannels = colorChannels;
+	texture.compressedFormat = bAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	texture.pixels.clear();
+	texture.levels.clear();
+
+	int levelWidth = width;
+	int levelHeight = height;
+	while (true)
+	{
+		CompressLevel(rgba, levelWidth, levelHeight, bAlpha, blocks);
+
+		MIP_LEVEL level;
+		level.width = levelWidth;
+		level.height = levelHeight;
+		level.offset = texture.pixels.size();
+		level.size = blocks.size();
+		texture.levels.push_back(level);
+		texture.pixels.insert(texture.pixels.end(), blocks.begin(), blocks.end());
+
+		if ((levelWidth == 1) && (levelHeight == 1))
+		{
+			break;
+		}
+
+		DownsampleLevel(rgba, levelWidth, levelHeight, halved);
+		rgba.swap(halved);
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+}
+
+/***********************************************************
+ *  CompressLevel()
+ *
+ *  This method is used for compressing one RGBA8 level into
+ *  4x4 blocks.  Blocks that hang over the edge of a level
+ *  repeat the last row and column.
+ ***********************************************************/
+void TextureCache::CompressLevel(
+	const std::vector<unsigned char>& rgba,
+	int width,
+	int height,
+	bool bAlpha,
+	std::vector<unsigned char>& blocks)
+{
+	int blocksX = std::max(1, (width + 3) / 4);
+	int blocksY = std::max(1, (height + 3) / 4);
+	size_t blockSize = GetBlockSize(bAlpha);
+	unsigned char pixels[64];
+
+	blocks.resize((size_t)blocksX * blocksY * blockSize);
+
+	for (int by = 0; by < blocksY; by++)
+	{
+		for (int bx = 0; bx < blocksX; bx++)
+		{
+			for (int y = 0; y < 4; y++)
+			{
+				int row = std::min(by * 4 + y, height - 1);
+				for (int x = 0; x < 4; x++)
+				{
+					int column = std::min(bx * 4 + x, width - 1);
+					memcpy(&pixels[(y * 4 + x) * 4], &rgba[((size_t)row * width + column) * 4], 4);
+				}
+			}
+
+			unsigned char* block = &blocks[((size_t)by * blocksX + bx) * blockSize];
+			if (bAlpha == true)
+			{
+				CompressAlphaBlock(pixels, block);
+				CompressColorBlock(pixels, block + 8);
+			}
+			else
+			{
+				CompressColorBlock(pixels, block);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  DownsampleLevel()
+ *
+ *  This method is used for building the next smaller mip
+ *  level by averaging 2x2 pixels.  Odd sizes repeat the last
+ *  row or column.
+ ***********************************************************/
+void TextureCache::DownsampleLevel(
+	const std::vector<unsigned char>& rgba,
+	int width,
+	int height,
+	std::vector<unsigned char>& halved)
+{
+	int halvedWidth = std::max(1, width / 2);
+	int halvedHeight = std::max(1, height / 2);
+
+	halved.resize((size_t)halvedWidth * halvedHeight * 4);
+
+	for (int y = 0; y < halvedHeight; y++)
+	{
+		int row0 = std::min(y * 2, height - 1);
+		int row1 = std::min(y * 2 + 1, height - 1);
+		for (int x = 0; x < halvedWidth; x++)
+		{
+			int column0 = std::min(x * 2, width - 1);
+			int column1 = std::min(x * 2 + 1, width - 1);
+			for (int c = 0; c < 4; c++)
+			{
+				int sum =
+					rgba[((size_t)row0 * width + column0) * 4 + c] +
+					rgba[((size_t)row0 * width + column1) * 4 + c] +
+					rgba[((size_t)row1 * width + column0) * 4 + c] +
+					rgba[((size_t)row1 * width + column1) * 4 + c];
+				halved[((size_t)y * halvedWidth + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturecache.h
+// ============
+// block-compressed texture images with a baked mip chain, cached on disk
+//
+//	The first launch decodes an image, builds its mip chain, compresses
+//	every level to BC1 (RGB) or BC3 (RGBA) and writes the result to a DDS
+//	file next to the image.  Later launches read the DDS file instead, so
+//	no decoding, compressing or mipmap generation is left at startup.  The
+//	rows are kept in the bottom-up order that the images are loaded with.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureCache
+ *
+ *  This class contains the code for compressing decoded
+ *  images and for reading and writing the cache files.
+ ***********************************************************/
+class TextureCache
+{
+public:
+	// one level of the mip chain inside the texture data
+	struct MIP_LEVEL
+	{
+		int width;
+		int height;
+		size_t offset;
+		size_t size;
+	};
+
+	// texture image ready to be uploaded
+	struct TEXTURE_DATA
+	{
+		int width;
+		int height;
+		int colorChannels;
+		// compressed GL format, 0 for uncompressed RGB8/RGBA8 pixels
+		GLenum compressedFormat;
+		// pixels of all of the levels, one after another
+		std::vector<unsigned char> pixels;
+		std::vector<MIP_LEVEL> levels;
+	};
+
+	// get the cache file name used for an image file
+	static std::string GetCacheFilename(const std::string& imageFilename);
+
+	// read a cache file that is not older than its image file
+	static bool LoadCachedTexture(
+		const std::string& imageFilename,
+		TEXTURE_DATA& texture);
+	// set the largest image size a cache file may have, from the
+	// GL maximum texture size, before any loader thread starts
+	static void SetMaxTextureSize(int size);
+	// write the compressed texture into the cache file of an image
+	static bool SaveCachedTexture(
+		const std::string& imageFilename,
+		const TEXTURE_DATA& texture);
+
+	// resample a decoded image to a square size with bilinear filtering
+	static void ResampleImage(
+		const unsigned char* image,
+		int width,
+		int height,
+		int colorChannels,
+		int size,
+		std::vector<unsigned char>& resampled);
+
+	// build the mip chain of a decoded image and compress every level
+	static void CompressTexture(
+		const unsigned char* image,
+		int width,
+		int height,
+		int colorChannels,
+		TEXTURE_DATA& texture);
+
+private:
+	// compress one RGBA8 level into 4x4 blocks
+	static void CompressLevel(
+		const std::vector<unsigned char>& rgba,
+		int width,
+		int height,
+		bool bAlpha,
+		std::vector<unsigned char>& blocks);
+	// halve an RGBA8 level with a box filter
+	static void DownsampleLevel(
+		const std::vector<unsigned char>& rgba,
+		int width,
+		int height,
+		std::vector<unsigned char>& halved);
+};
@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.cpp
+// ============
+// decode texture images on worker threads and upload them on the GL thread
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureLoader.h"
+
+#include "stb_image.h"
+
+#include <iostream>
+
+/***********************************************************
+ *  TextureLoader()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureLoader::TextureLoader(TextureManager* pTextureManager, int workerCount)
+{
+	m_pTextureManager = pTextureManager;
+	m_bStopping = false;
+	m_pendingCount = 0;
+	// the GL context is current here, so the extension can be checked
+	m_bUseCompression = (GLEW_EXT_texture_compression_s3tc != 0);
+
+	if (workerCount <= 0)
+	{
+		workerCount = (int)std::thread::hardware_concurrency();
+		if (workerCount <= 0)
+		{
+			workerCount = 2;
+		}
+	}
+
+	// the flip setting is shared by all threads, so it is set
+	// once before any of the workers start decoding
+	stbi_set_flip_vertically_on_load(true);
+
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_workers.push_back(std::thread(&TextureLoader::WorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  ~TextureLoader()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_jobAdded.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+	m_finishedJobs.clear();
+
+	m_pTextureManager = NULL;
+}
+
+/***********************************************************
+ *  QueueTexture()
+ *
+ *  This method is used for queueing an image file for the
+ *  worker threads.  The texture handle shows the placeholder
+ *  until the decoded image is uploaded.
+ ***********************************************************/
+void TextureLoader::QueueTexture(const char* filename, int textureHandle)
+{
+	TEXTURE_JOB job;
+	job.filename = filename;
+	job.textureHandle = textureHandle;
+	job.bLoaded = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queuedJobs.push_back(job);
+		m_pendingCount++;
+	}
+	m_jobAdded.notify_one();
+}
+
+/***********************************************************
+ *  UploadFinishedTextures()
+ *
+ *  This method is used for handing the images that the
+ *  worker threads have finished decoding to the texture
+ *  manager.  It returns the number of finished images.
+ ***********************************************************/
+int TextureLoader::UploadFinishedTextures()
+{
+	std::vector<TEXTURE_JOB> finishedJobs;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_finishedJobs.empty() == true)
+		{
+			return(0);
+		}
+		finishedJobs.swap(m_finishedJobs);
+	}
+
+	for (const TEXTURE_JOB& job : finishedJobs)
+	{
+		const TextureCache::TEXTURE_DATA& texture = job.texture;
+
+		if ((job.bLoaded == true) && (m_pTextureManager->SetTextureData(job.textureHandle, texture) == true))
+		{
+			std::cout << "Successfully loaded image:" << job.filename << ", width:" << texture.width << ", height:" << texture.height << ", channels:" << texture.colorChannels
+				<< ((texture.compressedFormat != 0) ? ", compressed" : "") << std::endl;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pendingCount -= (int)finishedJobs.size();
+	}
+
+	return((int)finishedJobs.size());
+}
+
+/***********************************************************
+ *  GetPendingCount()
+ *
+ *  This method is used for getting the number of queued
+ *  images that have not been uploaded yet.
+ ***********************************************************/
+int TextureLoader::GetPendingCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return(m_pendingCount);
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for decoding the queued image files
+ *  on a worker thread.  No GL calls are made here, the
+ *  decoded pixels are handed back to the GL thread.
+ ***********************************************************/
+void TextureLoader::WorkerLoop()
+{
+	while (true)
+	{
+		TEXTURE_JOB job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobAdded.wait(lock, [this] { return((m_bStopping == true) || (m_queuedJobs.empty() == false)); });
+			if (m_bStopping == true)
+			{
+				return;
+			}
+			job = m_queuedJobs.front();
+			m_queuedJobs.pop_front();
+		}
+
+		job.bLoaded = LoadTextureData(job.filename, job.texture);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_finishedJobs.push_back(std::move(job));
+	}
+}
+
+/***********************************************************
+ *  LoadTextureData()
+ *
+ *  This method is used for getting the pixels of an image on
+ *  a worker thread.  A current cache file is read directly.
+ *  Otherwise the image is decoded and resampled to its size
+ *  class, and when compression is used it is compressed and
+ *  written to the cache for the next launch.
+ ***********************************************************/
+bool TextureLoader::LoadTextureData(const std::string& filename, TextureCache::TEXTURE_DATA& texture)
+{
+	// cache files written before the size classes are rebuilt
+	if ((m_bUseCompression == true) && (TextureCache::LoadCachedTexture(filename, texture) == true) &&
+		(texture.width == texture.height) && (texture.width == TextureManager::GetSizeClass(texture.width, texture.height)))
+	{
+		return(true);
+	}
+
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+
+	// try to parse the image data from the specified image file
+	unsigned char* image = stbi_load(
+		filename.c_str(),
+		&width,
+		&height,
+		&colorChannels,
+		0);
+
+	if (NULL == image)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return(false);
+	}
+	if ((colorChannels != 3) && (colorChannels != 4))
+	{
+		std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+		stbi_image_free(image);
+		return(false);
+	}
+
+	// all of the textures of an array share one square size
+	int size = TextureManager::GetSizeClass(width, height);
+	std::vector<unsigned char> resampled;
+	if ((width != size) || (height != size))
+	{
+		TextureCache::ResampleImage(image, width, height, colorChannels, size, resampled);
+		stbi_image_free(image);
+		image = NULL;
+		width = size;
+		height = size;
+	}
+	const unsigned char* pixels = (NULL != image) ? image : resampled.data();
+
+	if (m_bUseCompression == true)
+	{
+		TextureCache::CompressTexture(pixels, width, height, colorChannels, texture);
+		if (TextureCache::SaveCachedTexture(filename, texture) == true)
+		{
+			std::cout << "Saved texture cache:" << TextureCache::GetCacheFilename(filename) << std::endl;
+		}
+	}
+	else
+	{
+		TextureCache::MIP_LEVEL level;
+		level.width = width;
+		level.height = height;
+		level.offset = 0;
+		level.size = (size_t)width * height * colorChannels;
+
+		texture.width = width;
+		texture.height = height;
+		texture.colorChannels = colorChannels;
+		texture.compressedFormat = 0;
+		texture.pixels.assign(pixels, pixels + level.size);
+		texture.levels.assign(1, level);
+	}
+
+	if (NULL != image)
+	{
+		stbi_image_free(image);
+	}
+
+	return(true);
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureloader.h
+// ============
+// decode texture images on worker threads and upload them on the GL thread
+//
+//	Queued textures show the placeholder of their TextureManager handle, so
+//	the scene can be drawn before any image is decoded.  Worker threads
+//	decode the image files in parallel and resample them to their size
+//	class, and the GL thread hands each finished image to the texture
+//	manager.  When the driver supports S3TC, images are uploaded
+//	block-compressed from the TextureCache files, which are written on the
+//	first launch.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureCache.h"
+#include "TextureManager.h"
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  TextureLoader
+ *
+ *  This class contains the worker threads that decode the
+ *  queued image files and the code for passing the decoded
+ *  images on to the texture manager.
+ ***********************************************************/
+class TextureLoader
+{
+public:
+	// constructor, 0 worker threads picks one per hardware thread
+	TextureLoader(TextureManager* pTextureManager, int workerCount);
+	// destructor
+	~TextureLoader();
+
+	// queue an image file to be decoded into a texture handle
+	void QueueTexture(const char* filename, int textureHandle);
+
+	// upload the images that have finished decoding, must be
+	// called from the thread that owns the GL context
+	int UploadFinishedTextures();
+
+	// number of queued images that are not uploaded yet
+	int GetPendingCount() const;
+
+private:
+	// image file that is queued or decoded
+	struct TEXTURE_JOB
+	{
+		std::string filename;
+		int textureHandle;
+		// false when the file could not be read
+		bool bLoaded;
+		TextureCache::TEXTURE_DATA texture;
+	};
+
+	// worker threads that decode the queued images
+	std::vector<std::thread> m_workers;
+	// guards the job lists and the stop flag
+	mutable std::mutex m_mutex;
+	std::condition_variable m_jobAdded;
+	bool m_bStopping;
+	// images waiting for a worker thread
+	std::deque<TEXTURE_JOB> m_queuedJobs;
+	// images decoded and waiting for the GL thread
+	std::vector<TEXTURE_JOB> m_finishedJobs;
+	// queued images that are not uploaded yet
+	int m_pendingCount;
+
+	// pointer to the texture manager that the images go to
+	TextureManager* m_pTextureManager;
+	// true when images are uploaded block-compressed
+	bool m_bUseCompression;
+
+	// decode queued images until the loader is destroyed
+	void WorkerLoop();
+	// read the cache file of an image, or decode and compress the image
+	bool LoadTextureData(const std::string& filename, TextureCache::TEXTURE_DATA& texture);
+};
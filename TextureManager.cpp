@@ -0,0 +1,517 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturemanager.cpp
+// ============
+// keep any number of scene textures resident in 2D array textures
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureManager.h"
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// layers of a newly created array
+	const int g_InitialLayerCapacity = 4;
+
+	/***********************************************************
+	 *  SetArrayParameters()
+	 *
+	 *  Sets the wrapping and filtering of the bound array, the
+	 *  same for every scene texture.
+	 ***********************************************************/
+	void SetArrayParameters(int levelCount)
+	{
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+	}
+}
+
+/***********************************************************
+ *  TextureManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureManager::TextureManager()
+{
+	m_transferBuffer = 0;
+	m_maxLayers = 256;
+	m_alphaChanges = 0;
+
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &m_maxLayers);
+
+	// the cache files are checked against the driver limit
+	GLint maxTextureSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+	TextureCache::SetMaxTextureSize(maxTextureSize);
+}
+
+/***********************************************************
+ *  ~TextureManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureManager::~TextureManager()
+{
+	DestroyTextures();
+	m_locations.clear();
+
+	if (m_transferBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_transferBuffer);
+		m_transferBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  CreateTexture()
+ *
+ *  This method is used for reserving a texture handle.  The
+ *  handle can be used for drawing right away and shows the
+ *  placeholder until its image is set.
+ ***********************************************************/
+int TextureManager::CreateTexture()
+{
+	TEXTURE_LOCATION location;
+	location.arrayIndex = -1;
+	location.layer = 0;
+
+	m_locations.push_back(location);
+
+	return((int)m_locations.size() - 1);
+}
+
+/***********************************************************
+ *  SetTextureData()
+ *
+ *  This method is used for copying a loaded image into a
+ *  layer of the array for its size class and format.  The
+ *  pixels go through the transfer buffer.  Setting the image
+ *  of a texture again reuses its layer.
+ ***********************************************************/
+bool TextureManager::SetTextureData(int textureHandle, const TextureCache::TEXTURE_DATA& texture)
+{
+	if ((textureHandle < 0) || (textureHandle >= (int)m_locations.size()))
+	{
+		return(false);
+	}
+	if ((texture.width != texture.height) || (texture.width != GetSizeClass(texture.width, texture.height)))
+	{
+		std::cout << "Texture image is not a square size class:" << texture.width << "x" << texture.height << std::endl;
+		return(false);
+	}
+
+	GLint activeTexture = GL_TEXTURE0;
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+
+	int arrayIndex = FindTextureArray(texture);
+	if (arrayIndex < 0)
+	{
+		return(false);
+	}
+	if ((texture.compressedFormat != 0) && ((int)texture.levels.size() != m_arrays[arrayIndex].levelCount))
+	{
+		std::cout << "Compressed texture image has " << texture.levels.size() << " mip levels instead of " << m_arrays[arrayIndex].levelCount << std::endl;
+		glActiveTexture(activeTexture);
+		return(false);
+	}
+
+	glActiveTexture(GL_TEXTURE0 + arrayIndex);
+
+	int layer = m_locations[textureHandle].layer;
+	if (m_locations[textureHandle].arrayIndex != arrayIndex)
+	{
+		if ((m_arrays[arrayIndex].layerCount == m_arrays[arrayIndex].layerCapacity) &&
+			(GrowTextureArray(arrayIndex) == false))
+		{
+			glActiveTexture(activeTexture);
+			return(false);
+		}
+		layer = m_arrays[arrayIndex].layerCount++;
+	}
+
+	const TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+	GLsizeiptr imageSize = (GLsizeiptr)texture.pixels.size();
+
+	if (m_transferBuffer == 0)
+	{
+		glGenBuffers(1, &m_transferBuffer);
+	}
+
+	// a fresh buffer store for every image, so the upload never
+	// waits for the GPU to finish reading the previous one
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_transferBuffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, imageSize, NULL, GL_STREAM_DRAW);
+
+	void* pMapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, imageSize,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (NULL == pMapped)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glActiveTexture(activeTexture);
+		std::cout << "Could not map the texture transfer buffer" << std::endl;
+		return(false);
+	}
+	memcpy(pMapped, texture.pixels.data(), (size_t)imageSize);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.textureID);
+
+	// the pixels are read from offsets into the bound transfer buffer
+	if (textureArray.bCompressed == true)
+	{
+		for (int i = 0; i < textureArray.levelCount; i++)
+		{
+			const TextureCache::MIP_LEVEL& level = texture.levels[i];
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer,
+				level.width, level.height, 1, textureArray.format,
+				(GLsizei)level.size, (const void*)level.offset);
+		}
+	}
+	else
+	{
+		// RGB rows are not always a multiple of 4 bytes long
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+			texture.width, texture.height, 1,
+			(textureArray.colorChannels == 3) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	if (textureArray.bCompressed == false)
+	{
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	}
+
+	// the array stays bound to its own unit for drawing
+	glActiveTexture(activeTexture);
+
+	bool bHadAlpha = HasAlpha(textureHandle);
+	m_locations[textureHandle].arrayIndex = arrayIndex;
+	m_locations[textureHandle].layer = layer;
+	if (HasAlpha(textureHandle) != bHadAlpha)
+	{
+		m_alphaChanges++;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetTextureLocation()
+ *
+ *  This method is used for getting the array and layer that
+ *  the shader reads a texture from.
+ ***********************************************************/
+TextureManager::TEXTURE_LOCATION TextureManager::GetTextureLocation(int textureHandle) const
+{
+	if ((textureHandle < 0) || (textureHandle >= (int)m_locations.size()))
+	{
+		TEXTURE_LOCATION location;
+		location.arrayIndex = -1;
+		location.layer = 0;
+		return(location);
+	}
+
+	return(m_locations[textureHandle]);
+}
+
+/***********************************************************
+ *  HasAlpha()
+ *
+ *  This method is used for checking whether the image of a
+ *  texture handle was loaded with an alpha channel.  The
+ *  placeholder of a loading texture has none.
+ ***********************************************************/
+bool TextureManager::HasAlpha(int textureHandle) const
+{
+	TEXTURE_LOCATION location = GetTextureLocation(textureHandle);
+
+	if (location.arrayIndex < 0)
+	{
+		return(false);
+	}
+
+	return(m_arrays[location.arrayIndex].colorChannels == 4);
+}
+
+/***********************************************************
+ *  GetAlphaChangeCount()
+ *
+ *  This method is used for getting the number of times a
+ *  texture gained or lost its alpha channel, so callers can
+ *  tell when their transparent draws have to be sorted out
+ *  again.
+ ***********************************************************/
+int TextureManager::GetAlphaChangeCount() const
+{
+	return(m_alphaChanges);
+}
+
+/***********************************************************
+ *  GetTextureCount()
+ *
+ *  This method is used for getting the number of reserved
+ *  texture handles.
+ ***********************************************************/
+int TextureManager::GetTextureCount() const
+{
+	return((int)m_locations.size());
+}
+
+/***********************************************************
+ *  DestroyTextures()
+ *
+ *  This method is used for freeing every array.  The texture
+ *  handles stay reserved and show the placeholder again.
+ ***********************************************************/
+void TextureManager::DestroyTextures()
+{
+	for (TEXTURE_ARRAY& textureArray : m_arrays)
+	{
+		glDeleteTextures(1, &textureArray.textureID);
+	}
+	m_arrays.clear();
+
+	for (TEXTURE_LOCATION& location : m_locations)
+	{
+		location.arrayIndex = -1;
+		location.layer = 0;
+	}
+}
+
+/***********************************************************
+ *  BindTextureArrays()
+ *
+ *  This method is used for binding every array to the
+ *  texture unit of the same index.
+ ***********************************************************/
+void TextureManager::BindTextureArrays() const
+{
+	for (int i = 0; i < (int)m_arrays.size(); i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_arrays[i].textureID);
+		FrameProfiler::CountStateChange();
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  GetSizeClass()
+ *
+ *  This method is used for getting the smallest power of two
+ *  that holds the larger side of an image, clamped to the
+ *  supported size classes.
+ ***********************************************************/
+int TextureManager::GetSizeClass(int width, int height)
+{
+	int size = TEXTURE_MIN_SIZE;
+
+	while ((size < std::max(width, height)) && (size < TEXTURE_MAX_SIZE))
+	{
+		size *= 2;
+	}
+
+	return(size);
+}
+
+/***********************************************************
+ *  FindTextureArray()
+ *
+ *  This method is used for finding the array that holds the
+ *  size class and format of an image.  A new array is made
+ *  on the next free texture unit if there is none yet, and
+ *  left bound to that unit.
+ ***********************************************************/
+int TextureManager::FindTextureArray(const TextureCache::TEXTURE_DATA& texture)
+{
+	bool bCompressed = (texture.compressedFormat != 0);
+	GLenum format = texture.compressedFormat;
+
+	if (bCompressed == false)
+	{
+		format = (texture.colorChannels == 3) ? GL_RGB8 : GL_RGBA8;
+	}
+
+	for (int i = 0; i < (int)m_arrays.size(); i++)
+	{
+		if ((m_arrays[i].size == texture.width) && (m_arrays[i].format == format))
+		{
+			return(i);
+		}
+	}
+
+	if ((int)m_arrays.size() >= TEXTURE_ARRAY_UNITS)
+	{
+		std::cout << "No texture unit left for another texture size class:" << texture.width << std::endl;
+		return(-1);
+	}
+
+	TEXTURE_ARRAY textureArray;
+	textureArray.size = texture.width;
+	textureArray.format = format;
+	textureArray.bCompressed = bCompressed;
+	textureArray.colorChannels = texture.colorChannels;
+	textureArray.levelCount = 1;
+	textureArray.layerCount = 0;
+	textureArray.layerCapacity = 0;
+	while ((textureArray.size >> textureArray.levelCount) > 0)
+	{
+		textureArray.levelCount++;
+	}
+
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	glActiveTexture(GL_TEXTURE0 + (GLenum)m_arrays.size());
+	AllocateArrayStorage(textureArray, textureID, std::min(g_InitialLayerCapacity, m_maxLayers));
+
+	m_arrays.push_back(textureArray);
+
+	return((int)m_arrays.size() - 1);
+}
+
+/***********************************************************
+ *  AllocateArrayStorage()
+ *
+ *  This method is used for binding a new texture to the
+ *  active texture unit and allocating every mip level of an
+ *  array in it for a number of layers.
+ ***********************************************************/
+void TextureManager::AllocateArrayStorage(TEXTURE_ARRAY& textureArray, GLuint textureID, int layerCapacity)
+{
+	// a bound unpack buffer would be read as the initial contents
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+	SetArrayParameters(textureArray.levelCount);
+
+	for (int i = 0; i < textureArray.levelCount; i++)
+	{
+		int levelSize = std::max(1, textureArray.size >> i);
+
+		if (textureArray.bCompressed == true)
+		{
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, i, textureArray.format,
+				levelSize, levelSize, layerCapacity, 0,
+				(GLsizei)(GetLayerSize(textureArray, i) * layerCapacity), NULL);
+		}
+		else
+		{
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, i, textureArray.format,
+				levelSize, levelSize, layerCapacity, 0,
+				(textureArray.colorChannels == 3) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+	}
+
+	textureArray.textureID = textureID;
+	textureArray.layerCapacity = layerCapacity;
+}
+
+/***********************************************************
+ *  GrowTextureArray()
+ *
+ *  This method is used for reallocating a full array with
+ *  twice the layers.  The existing layers are copied on the
+ *  GPU through the transfer buffer, which works for both the
+ *  compressed and the uncompressed formats on GL 3.3.  The
+ *  new array is left bound to the active texture unit.
+ ***********************************************************/
+bool TextureManager::GrowTextureArray(int arrayIndex)
+{
+	TEXTURE_ARRAY& textureArray = m_arrays[arrayIndex];
+	TEXTURE_ARRAY grownArray = textureArray;
+	int layerCapacity = std::min(textureArray.layerCapacity * 2, m_maxLayers);
+
+	if (layerCapacity <= textureArray.layerCapacity)
+	{
+		std::cout << "Texture size class " << textureArray.size << " has no layers left" << std::endl;
+		return(false);
+	}
+
+	GLuint textureID = 0;
+	glGenTextures(1, &textureID);
+	AllocateArrayStorage(grownArray, textureID, layerCapacity);
+
+	if (m_transferBuffer == 0)
+	{
+		glGenBuffers(1, &m_transferBuffer);
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (int i = 0; i < textureArray.levelCount; i++)
+	{
+		int levelSize = std::max(1, textureArray.size >> i);
+		GLsizeiptr levelBytes = (GLsizeiptr)(GetLayerSize(textureArray, i) * textureArray.layerCapacity);
+
+		// read every layer of the level into the transfer buffer
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_transferBuffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, levelBytes, NULL, GL_STREAM_COPY);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.textureID);
+		if (textureArray.bCompressed == true)
+		{
+			glGetCompressedTexImage(GL_TEXTURE_2D_ARRAY, i, NULL);
+		}
+		else
+		{
+			glGetTexImage(GL_TEXTURE_2D_ARRAY, i,
+				(textureArray.colorChannels == 3) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		// and write them into the first layers of the new array
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_transferBuffer);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+		if (textureArray.bCompressed == true)
+		{
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, 0,
+				levelSize, levelSize, textureArray.layerCapacity, textureArray.format,
+				(GLsizei)levelBytes, NULL);
+		}
+		else
+		{
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, 0,
+				levelSize, levelSize, textureArray.layerCapacity,
+				(textureArray.colorChannels == 3) ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	glDeleteTextures(1, &textureArray.textureID);
+	textureArray.textureID = grownArray.textureID;
+	textureArray.layerCapacity = grownArray.layerCapacity;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetLayerSize()
+ *
+ *  This method is used for getting the number of bytes that
+ *  one layer of a mip level takes up.
+ ***********************************************************/
+size_t TextureManager::GetLayerSize(const TEXTURE_ARRAY& textureArray, int level) const
+{
+	size_t levelSize = (size_t)std::max(1, textureArray.size >> level);
+
+	if (textureArray.bCompressed == true)
+	{
+		size_t blocks = (levelSize + 3) / 4;
+		size_t blockSize = (textureArray.format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) ? 16 : 8;
+		return(blocks * blocks * blockSize);
+	}
+
+	return(levelSize * levelSize * (size_t)textureArray.colorChannels);
+}
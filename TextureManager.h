@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// texturemanager.h
+// ============
+// keep any number of scene textures resident in 2D array textures
+//
+//	Images are resampled to a square power of two size class when they are
+//	loaded (see TextureCache), and all textures of a size class and format
+//	are layers of one GL_TEXTURE_2D_ARRAY.  Each array stays bound to its
+//	own texture unit, so a draw selects a texture with an array index and
+//	a layer index instead of binding it.  An array that runs out of layers
+//	is reallocated with twice the layers on the GPU.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TextureCache.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+// texture units of the arrays, this must match fragmentShader.glsl
+#define TEXTURE_ARRAY_UNITS 8
+
+// smallest and largest size class of the resampled images
+#define TEXTURE_MIN_SIZE 256
+#define TEXTURE_MAX_SIZE 2048
+
+/***********************************************************
+ *  TextureManager
+ *
+ *  This class contains the array textures of the scene and
+ *  the mapping from texture handles to array layers.
+ ***********************************************************/
+class TextureManager
+{
+public:
+	// where the shader finds a texture
+	struct TEXTURE_LOCATION
+	{
+		// texture unit of the array, -1 while the texture is loading
+		int arrayIndex;
+		int layer;
+	};
+
+	// constructor
+	TextureManager();
+	// destructor
+	~TextureManager();
+
+	// reserve a texture handle, it shows the placeholder until
+	// the image is set
+	int CreateTexture();
+	// copy a loaded image into a layer of its size class array
+	bool SetTextureData(int textureHandle, const TextureCache::TEXTURE_DATA& texture);
+
+	// get the array and layer of a texture handle
+	TEXTURE_LOCATION GetTextureLocation(int textureHandle) const;
+	// check if a loaded texture has an alpha channel
+	bool HasAlpha(int textureHandle) const;
+	// number of times a texture image gained or lost alpha
+	int GetAlphaChangeCount() const;
+	// number of reserved texture handles
+	int GetTextureCount() const;
+
+	// free every array, the texture handles show the placeholder
+	// until their images are set again
+	void DestroyTextures();
+
+	// bind every array to its texture unit
+	void BindTextureArrays() const;
+
+	// get the square size class that an image is resampled to
+	static int GetSizeClass(int width, int height);
+
+private:
+	// all of the textures of one size class and format
+	struct TEXTURE_ARRAY
+	{
+		GLuint textureID;
+		int size;
+		// internal format, a compressed one or GL_RGB8/GL_RGBA8
+		GLenum format;
+		bool bCompressed;
+		int colorChannels;
+		int levelCount;
+		int layerCount;
+		int layerCapacity;
+	};
+
+	std::vector<TEXTURE_ARRAY> m_arrays;
+	// array and layer of each texture handle
+	std::vector<TEXTURE_LOCATION> m_locations;
+	// pixel buffer object used for the uploads and array copies
+	GLuint m_transferBuffer;
+	// most layers the driver supports in one array
+	int m_maxLayers;
+	// counts the images that changed whether their texture has alpha
+	int m_alphaChanges;
+
+	// find or create the array for a size class and format
+	int FindTextureArray(const TextureCache::TEXTURE_DATA& texture);
+	// allocate the storage of an array for a number of layers
+	void AllocateArrayStorage(TEXTURE_ARRAY& textureArray, GLuint textureID, int layerCapacity);
+	// reallocate an array with twice the layers, keeping the old ones
+	bool GrowTextureArray(int arrayIndex);
+	// size in bytes of one layer of a level
+	size_t GetLayerSize(const TEXTURE_ARRAY& textureArray, int level) const;
+};
@@ -0,0 +1,523 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformsystem.cpp
+// ============
+// compose the local and world matrices of the scene nodes in batches
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define TRANSFORM_SYSTEM_SSE2
+#include <emmintrin.h>
+#endif
+
+// declaration of the global variables and defines
+namespace
+{
+	// transforms composed together by the SIMD path
+	const int g_TransformsPerGroup = 4;
+	const float g_RadiansPerDegree = 0.017453292519943296f;
+
+	/***********************************************************
+	 *  ComposeRadians()
+	 *
+	 *  This function is used for writing translation * Rz *
+	 *  Ry * Rx * scale directly.  Each rotation column is
+	 *  scaled by the matching scale value, and the position
+	 *  is the last column.
+	 ***********************************************************/
+	glm::mat4 ComposeRadians(
+		float scaleX, float scaleY, float scaleZ,
+		float rotationX, float rotationY, float rotationZ,
+		float positionX, float positionY, float positionZ)
+	{
+		float sinX = std::sin(rotationX);
+		float cosX = std::cos(rotationX);
+		float sinY = std::sin(rotationY);
+		float cosY = std::cos(rotationY);
+		float sinZ = std::sin(rotationZ);
+		float cosZ = std::cos(rotationZ);
+		glm::mat4 matrix;
+
+		matrix[0] = glm::vec4(cosY * cosZ, cosY * sinZ, -sinY, 0.0f) * scaleX;
+		matrix[1] = glm::vec4(
+			cosZ * sinY * sinX - sinZ * cosX,
+			sinZ * sinY * sinX + cosZ * cosX,
+			cosY * sinX,
+			0.0f) * scaleY;
+		matrix[2] = glm::vec4(
+			cosZ * sinY * cosX + sinZ * sinX,
+			sinZ * sinY * cosX - cosZ * sinX,
+			cosY * cosX,
+			0.0f) * scaleZ;
+		matrix[3] = glm::vec4(positionX, positionY, positionZ, 1.0f);
+
+		return(matrix);
+	}
+
+#ifdef TRANSFORM_SYSTEM_SSE2
+	/***********************************************************
+	 *  SinCos4()
+	 *
+	 *  This function is used for getting the sine and cosine
+	 *  of four angles at once.  The angles are reduced to
+	 *  within pi/4 of a multiple of pi/2 in three steps, so the
+	 *  reduction stays exact for any angle a node is likely to
+	 *  be rotated by, and the quadrant picks which polynomial
+	 *  gives the sine and which the cosine.
+	 ***********************************************************/
+	void SinCos4(__m128 angles, __m128& sines, __m128& cosines)
+	{
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angles, _mm_set1_ps(0.63661977236758134f)));
+		__m128 multiple = _mm_cvtepi32_ps(quadrant);
+
+		__m128 x = _mm_sub_ps(angles, _mm_mul_ps(multiple, _mm_set1_ps(1.5703125f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(multiple, _mm_set1_ps(4.837512969970703125e-4f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(multiple, _mm_set1_ps(7.54978995489188216e-8f)));
+		__m128 x2 = _mm_mul_ps(x, x);
+
+		__m128 sine = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), x2), _mm_set1_ps(8.3321608736e-3f));
+		sine = _mm_add_ps(_mm_mul_ps(sine, x2), _mm_set1_ps(-1.6666654611e-1f));
+		sine = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sine, x2), x), x);
+
+		__m128 cosine = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), x2), _mm_set1_ps(-1.388731625493765e-3f));
+		cosine = _mm_add_ps(_mm_mul_ps(cosine, x2), _mm_set1_ps(4.166664568298827e-2f));
+		cosine = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(cosine, x2), x2), _mm_sub_ps(one, _mm_mul_ps(half, x2)));
+
+		// odd quadrants swap the sine and cosine, and the sign bits
+		// follow bit 1 of the quadrant and of the quadrant + 1
+		__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+		__m128 sineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+		__m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(
+			_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+		sines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cosine), _mm_andnot_ps(swap, sine)), sineSign);
+		cosines = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sine), _mm_andnot_ps(swap, cosine)), cosineSign);
+	}
+
+	/***********************************************************
+	 *  LoadGroup()
+	 *
+	 *  This function is used for loading one value of the
+	 *  transforms of a group.  Runs of neighbouring transforms
+	 *  are loaded directly, and unused lanes are set to 0.
+	 ***********************************************************/
+	__m128 LoadGroup(const std::vector<float>& values, const int* indices, int count)
+	{
+		if ((count == g_TransformsPerGroup) &&
+			(indices[1] == indices[0] + 1) && (indices[2] == indices[0] + 2) && (indices[3] == indices[0] + 3))
+		{
+			return(_mm_loadu_ps(&values[indices[0]]));
+		}
+
+		float lanes[g_TransformsPerGroup] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < count; i++)
+		{
+			lanes[i] = values[indices[i]];
+		}
+
+		return(_mm_loadu_ps(lanes));
+	}
+
+	/***********************************************************
+	 *  MultiplyMatrices()
+	 *
+	 *  This function is used for multiplying two column major
+	 *  matrices, a whole column at a time.
+	 ***********************************************************/
+	void MultiplyMatrices(const glm::mat4& left, const glm::mat4& right, glm::mat4& result)
+	{
+		__m128 column0 = _mm_loadu_ps(&left[0][0]);
+		__m128 column1 = _mm_loadu_ps(&left[1][0]);
+		__m128 column2 = _mm_loadu_ps(&left[2][0]);
+		__m128 column3 = _mm_loadu_ps(&left[3][0]);
+
+		for (int i = 0; i < 4; i++)
+		{
+			__m128 value = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(right[i][0])), _mm_mul_ps(column1, _mm_set1_ps(right[i][1]))),
+				_mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(right[i][2])), _mm_mul_ps(column3, _mm_set1_ps(right[i][3]))));
+			_mm_storeu_ps(&result[i][0], value);
+		}
+	}
+#else
+	/***********************************************************
+	 *  MultiplyMatrices()
+	 *
+	 *  This function is used for multiplying two matrices.
+	 ***********************************************************/
+	void MultiplyMatrices(const glm::mat4& left, const glm::mat4& right, glm::mat4& result)
+	{
+		result = left * right;
+	}
+#endif
+}
+
+/***********************************************************
+ *  TransformSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformSystem::TransformSystem()
+{
+	m_firstChanged = 0;
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for removing every transform.
+ ***********************************************************/
+void TransformSystem::Clear()
+{
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+	m_rotationX.clear();
+	m_rotationY.clear();
+	m_rotationZ.clear();
+	m_positionX.clear();
+	m_positionY.clear();
+	m_positionZ.clear();
+	m_parents.clear();
+	m_localMatrices.clear();
+	m_worldMatrices.clear();
+	m_dirty.clear();
+	m_changedTransforms.clear();
+	m_firstChanged = 0;
+}
+
+/***********************************************************
+ *  GetCount()
+ *
+ *  This method is used for getting the number of transforms.
+ ***********************************************************/
+int TransformSystem::GetCount() const
+{
+	return((int)m_parents.size());
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used for making room for a number of
+ *  transforms, so a large scene is added without the arrays
+ *  being reallocated over and over.
+ ***********************************************************/
+void TransformSystem::Reserve(int count)
+{
+	m_scaleX.reserve(count);
+	m_scaleY.reserve(count);
+	m_scaleZ.reserve(count);
+	m_rotationX.reserve(count);
+	m_rotationY.reserve(count);
+	m_rotationZ.reserve(count);
+	m_positionX.reserve(count);
+	m_positionY.reserve(count);
+	m_positionZ.reserve(count);
+	m_parents.reserve(count);
+	m_localMatrices.reserve(count);
+	m_worldMatrices.reserve(count);
+	m_dirty.reserve(count);
+	m_changedTransforms.reserve(count);
+}
+
+/***********************************************************
+ *  AddTransform()
+ *
+ *  This method is used for adding a transform below a parent
+ *  transform.  Its matrices are calculated by the next
+ *  UpdateTransforms(), together with the other transforms
+ *  added since the last one.
+ ***********************************************************/
+int TransformSystem::AddTransform(
+	int parentIndex,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	int index = GetCount();
+
+	m_scaleX.push_back(0.0f);
+	m_scaleY.push_back(0.0f);
+	m_scaleZ.push_back(0.0f);
+	m_rotationX.push_back(0.0f);
+	m_rotationY.push_back(0.0f);
+	m_rotationZ.push_back(0.0f);
+	m_positionX.push_back(0.0f);
+	m_positionY.push_back(0.0f);
+	m_positionZ.push_back(0.0f);
+	// parents are always added before their children
+	m_parents.push_back((parentIndex < index) ? parentIndex : -1);
+	m_localMatrices.push_back(glm::mat4(1.0f));
+	m_worldMatrices.push_back(glm::mat4(1.0f));
+	m_dirty.push_back(0);
+
+	StoreTransform(index, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+
+	return(index);
+}
+
+/***********************************************************
+ *  SetTransform()
+ *
+ *  This method is used for changing the transformation
+ *  values of a transform.  The matrices of the transform and
+ *  everything below it are updated by the next
+ *  UpdateTransforms().
+ ***********************************************************/
+void TransformSystem::SetTransform(
+	int index,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if ((index < 0) || (index >= GetCount()))
+	{
+		return;
+	}
+
+	StoreTransform(index, scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+}
+
+/***********************************************************
+ *  StoreTransform()
+ *
+ *  This method is used for setting the values of a transform
+ *  and adding it to the changed transforms once.
+ ***********************************************************/
+void TransformSystem::StoreTransform(
+	int index,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	m_scaleX[index] = scaleXYZ.x;
+	m_scaleY[index] = scaleXYZ.y;
+	m_scaleZ[index] = scaleXYZ.z;
+	m_rotationX[index] = XrotationDegrees;
+	m_rotationY[index] = YrotationDegrees;
+	m_rotationZ[index] = ZrotationDegrees;
+	m_positionX[index] = positionXYZ.x;
+	m_positionY[index] = positionXYZ.y;
+	m_positionZ[index] = positionXYZ.z;
+
+	if (m_dirty[index] == 0)
+	{
+		if (m_changedTransforms.empty() == true)
+		{
+			m_firstChanged = index;
+		}
+		m_firstChanged = std::min(m_firstChanged, index);
+		m_changedTransforms.push_back(index);
+		m_dirty[index] = 1;
+	}
+}
+
+/***********************************************************
+ *  UpdateTransforms()
+ *
+ *  This method is used for composing the local matrices of
+ *  the changed transforms and recalculating the world
+ *  matrices of those transforms and everything below them.
+ *  Since parents are stored before children, one pass from
+ *  the first changed transform is enough.
+ ***********************************************************/
+bool TransformSystem::UpdateTransforms()
+{
+	if (m_changedTransforms.empty() == true)
+	{
+		return(false);
+	}
+
+	ComposeLocalMatrices();
+
+	for (int i = m_firstChanged; i < GetCount(); i++)
+	{
+		int parentIndex = m_parents[i];
+
+		if ((parentIndex >= 0) && (m_dirty[parentIndex] != 0))
+		{
+			m_dirty[i] = 1;
+		}
+
+		if (m_dirty[i] != 0)
+		{
+			if (parentIndex >= 0)
+			{
+				MultiplyMatrices(m_worldMatrices[parentIndex], m_localMatrices[i], m_worldMatrices[i]);
+			}
+			else
+			{
+				m_worldMatrices[i] = m_localMatrices[i];
+			}
+		}
+	}
+
+	std::fill(m_dirty.begin() + m_firstChanged, m_dirty.end(), 0);
+	m_changedTransforms.clear();
+	m_firstChanged = 0;
+
+	return(true);
+}
+
+/***********************************************************
+ *  ComposeLocalMatrices()
+ *
+ *  This method is used for composing the local matrices of
+ *  the changed transforms, four at a time with SSE2 where it
+ *  is available, and one at a time otherwise.
+ ***********************************************************/
+void TransformSystem::ComposeLocalMatrices()
+{
+	int changedCount = (int)m_changedTransforms.size();
+	int index = 0;
+
+#ifdef TRANSFORM_SYSTEM_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 radiansPerDegree = _mm_set1_ps(g_RadiansPerDegree);
+
+	for (; index < changedCount; index += g_TransformsPerGroup)
+	{
+		const int* indices = &m_changedTransforms[index];
+		int count = std::min(changedCount - index, g_TransformsPerGroup);
+		__m128 sinX, cosX, sinY, cosY, sinZ, cosZ;
+
+		SinCos4(_mm_mul_ps(LoadGroup(m_rotationX, indices, count), radiansPerDegree), sinX, cosX);
+		SinCos4(_mm_mul_ps(LoadGroup(m_rotationY, indices, count), radiansPerDegree), sinY, cosY);
+		SinCos4(_mm_mul_ps(LoadGroup(m_rotationZ, indices, count), radiansPerDegree), sinZ, cosZ);
+
+		__m128 scaleX = LoadGroup(m_scaleX, indices, count);
+		__m128 scaleY = LoadGroup(m_scaleY, indices, count);
+		__m128 scaleZ = LoadGroup(m_scaleZ, indices, count);
+		__m128 sinYsinX = _mm_mul_ps(sinY, sinX);
+		__m128 sinYcosX = _mm_mul_ps(sinY, cosX);
+
+		// row r of column c of each of the four matrices, the same
+		// terms as ComposeRadians()
+		__m128 columns[4][4];
+		columns[0][0] = _mm_mul_ps(_mm_mul_ps(cosY, cosZ), scaleX);
+		columns[0][1] = _mm_mul_ps(_mm_mul_ps(cosY, sinZ), scaleX);
+		columns[0][2] = _mm_mul_ps(_mm_sub_ps(zero, sinY), scaleX);
+		columns[0][3] = zero;
+		columns[1][0] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(cosZ, sinYsinX), _mm_mul_ps(sinZ, cosX)), scaleY);
+		columns[1][1] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sinZ, sinYsinX), _mm_mul_ps(cosZ, cosX)), scaleY);
+		columns[1][2] = _mm_mul_ps(_mm_mul_ps(cosY, sinX), scaleY);
+		columns[1][3] = zero;
+		columns[2][0] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cosZ, sinYcosX), _mm_mul_ps(sinZ, sinX)), scaleZ);
+		columns[2][1] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sinZ, sinYcosX), _mm_mul_ps(cosZ, sinX)), scaleZ);
+		columns[2][2] = _mm_mul_ps(_mm_mul_ps(cosY, cosX), scaleZ);
+		columns[2][3] = zero;
+		columns[3][0] = LoadGroup(m_positionX, indices, count);
+		columns[3][1] = LoadGroup(m_positionY, indices, count);
+		columns[3][2] = LoadGroup(m_positionZ, indices, count);
+		columns[3][3] = one;
+
+		// after the transpose, lane i of the group holds the
+		// column of matrix i
+		for (int column = 0; column < 4; column++)
+		{
+			_MM_TRANSPOSE4_PS(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+			for (int i = 0; i < count; i++)
+			{
+				_mm_storeu_ps(&m_localMatrices[indices[i]][column][0], columns[column][i]);
+			}
+		}
+	}
+#endif
+
+	for (; index < changedCount; index++)
+	{
+		ComposeLocalMatrix(m_changedTransforms[index]);
+	}
+}
+
+/***********************************************************
+ *  ComposeLocalMatrix()
+ *
+ *  This method is used for composing the local matrix of one
+ *  transform from its stored values.
+ ***********************************************************/
+void TransformSystem::ComposeLocalMatrix(int index)
+{
+	m_localMatrices[index] = ComposeRadians(
+		m_scaleX[index], m_scaleY[index], m_scaleZ[index],
+		glm::radians(m_rotationX[index]), glm::radians(m_rotationY[index]), glm::radians(m_rotationZ[index]),
+		m_positionX[index], m_positionY[index], m_positionZ[index]);
+}
+
+/***********************************************************
+ *  GetTransform()
+ *
+ *  This method is used for getting the transformation values
+ *  of a transform, with the rotations in degrees.
+ ***********************************************************/
+void TransformSystem::GetTransform(
+	int index,
+	glm::vec3& scaleXYZ,
+	glm::vec3& rotationDegrees,
+	glm::vec3& positionXYZ) const
+{
+	scaleXYZ = glm::vec3(m_scaleX[index], m_scaleY[index], m_scaleZ[index]);
+	rotationDegrees = glm::vec3(m_rotationX[index], m_rotationY[index], m_rotationZ[index]);
+	positionXYZ = glm::vec3(m_positionX[index], m_positionY[index], m_positionZ[index]);
+}
+
+/***********************************************************
+ *  GetWorldMatrix()
+ *
+ *  This method is used for getting the world matrix of a
+ *  transform as of the last UpdateTransforms().
+ ***********************************************************/
+const glm::mat4& TransformSystem::GetWorldMatrix(int index) const
+{
+	return(m_worldMatrices[index]);
+}
+
+/***********************************************************
+ *  GatherWorldMatrices()
+ *
+ *  This method is used for copying the world matrices of the
+ *  listed transforms into matrices, in the listed order, such
+ *  as the contents of the instance buffer.  The matrices
+ *  must have room for count entries.
+ ***********************************************************/
+void TransformSystem::GatherWorldMatrices(const int* indices, int count, glm::mat4* matrices) const
+{
+	for (int i = 0; i < count; i++)
+	{
+		matrices[i] = m_worldMatrices[indices[i]];
+	}
+}
+
+/***********************************************************
+ *  ComposeMatrix()
+ *
+ *  This method is used for building the model matrix of the
+ *  passed in transformation values in closed form, which is
+ *  the same as translation * Rz * Ry * Rx * scale.
+ ***********************************************************/
+glm::mat4 TransformSystem::ComposeMatrix(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	return(ComposeRadians(
+		scaleXYZ.x, scaleXYZ.y, scaleXYZ.z,
+		glm::radians(XrotationDegrees), glm::radians(YrotationDegrees), glm::radians(ZrotationDegrees),
+		positionXYZ.x, positionXYZ.y, positionXYZ.z));
+}
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformsystem.h
+// ============
+// compose the local and world matrices of the scene nodes in batches
+//
+//	The scale, Euler rotation and position of every transform are kept in
+//	structure-of-arrays form.  A local matrix is written directly from the
+//	sines and cosines of the three angles instead of multiplying five
+//	matrices, which gives the same translation * Rz * Ry * Rx * scale
+//	matrix that SetTransformations() used to build.  Only changed
+//	transforms are composed, four at a time with SSE2 where it is
+//	available, and the world matrices of those transforms and everything
+//	below them are then updated in one pass, since parents are always
+//	added before their children.  The world matrices are stored
+//	contiguously so they can be copied straight into the instance buffer.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  TransformSystem
+ *
+ *  This class contains the transformation values of the
+ *  scene nodes and the code for keeping their local and
+ *  world matrices up to date.
+ ***********************************************************/
+class TransformSystem
+{
+public:
+	// constructor
+	TransformSystem();
+
+	// remove every transform
+	void Clear();
+	int GetCount() const;
+	// make room for count transforms without reallocating
+	void Reserve(int count);
+
+	// add a transform below a parent transform, -1 for the scene
+	// root, and get its index
+	int AddTransform(
+		int parentIndex,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// change the transformation values of a transform
+	void SetTransform(
+		int index,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// compose the changed local matrices and update the world
+	// matrices below them, false when nothing had changed
+	bool UpdateTransforms();
+
+	// get the transformation values of a transform
+	void GetTransform(
+		int index,
+		glm::vec3& scaleXYZ,
+		glm::vec3& rotationDegrees,
+		glm::vec3& positionXYZ) const;
+
+	// get the parent * local matrix as of the last update
+	const glm::mat4& GetWorldMatrix(int index) const;
+	// copy the world matrices of the listed transforms in order
+	void GatherWorldMatrices(const int* indices, int count, glm::mat4* matrices) const;
+
+	// build translation * Rz * Ry * Rx * scale in closed form
+	static glm::mat4 ComposeMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+private:
+	// transformation values, rotations in degrees
+	std::vector<float> m_scaleX;
+	std::vector<float> m_scaleY;
+	std::vector<float> m_scaleZ;
+	std::vector<float> m_rotationX;
+	std::vector<float> m_rotationY;
+	std::vector<float> m_rotationZ;
+	std::vector<float> m_positionX;
+	std::vector<float> m_positionY;
+	std::vector<float> m_positionZ;
+	// index of the parent transform, -1 for the scene root
+	std::vector<int> m_parents;
+
+	std::vector<glm::mat4> m_localMatrices;
+	std::vector<glm::mat4> m_worldMatrices;
+
+	// 1 for the transforms whose world matrix is out of date
+	std::vector<unsigned char> m_dirty;
+	// transforms whose values changed since the last update, in
+	// the order they were changed
+	std::vector<int> m_changedTransforms;
+	// lowest changed index, nothing before it needs updating
+	int m_firstChanged;
+
+	// set the values of a transform and mark it as changed
+	void StoreTransform(
+		int index,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+	// compose the local matrices of the changed transforms
+	void ComposeLocalMatrices();
+	// compose one local matrix from the stored values
+	void ComposeLocalMatrix(int index);
+};
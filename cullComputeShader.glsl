@@ -0,0 +1,161 @@
+#version 430 core
+// one invocation per instanced object, see GpuCuller.h
+layout (local_size_x = 64) in;
+
+// match MESH_LOD_LEVELS in InstancedMeshes.h
+#define MESH_LOD_LEVELS 3
+
+// the struct members are ordered so that the std430 layouts match
+// the structs in GpuCuller.h and InstancedMeshes.h
+struct ObjectRecord {
+    mat4 world;
+    vec4 minPoint;
+    vec4 maxPoint;
+    uint firstCommand;
+    uint lodCount;
+    int materialIndex;
+    uint occlusionGroup;
+};
+
+struct DrawCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+struct CulledInstance {
+    mat4 model;
+    int materialIndex;
+    int padding0;
+    int padding1;
+    int padding2;
+};
+
+layout (std430, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectRecord objects[];
+};
+
+// read as the draw indirect buffer once the pass is done
+layout (std430, binding = 1) buffer CommandBuffer
+{
+    DrawCommand commands[];
+};
+
+// read as the instance attributes of the indirect draws
+layout (std430, binding = 2) writeonly buffer InstanceBuffer
+{
+    CulledInstance instances[];
+};
+
+// level of detail each object was last drawn at
+layout (std430, binding = 3) buffer LodBuffer
+{
+    uint lodLevels[];
+};
+
+// 1 for each occlusion group that was not found occluded
+layout (std430, binding = 4) readonly buffer GroupBuffer
+{
+    uint groupVisible[];
+};
+
+uniform uint objectCount;
+uniform mat4 viewProjection;
+// N.p + d >= 0 inside, not normalized
+uniform vec4 frustumPlanes[6];
+uniform bool bFrustumCulling = true;
+uniform bool bOcclusionCulling = true;
+uniform bool bLevelOfDetail = true;
+uniform float nearPlane;
+// projection[1][1] times the screen height in pixels
+uniform float lodScale;
+// projected diameters in pixels below which the next coarser level is used
+uniform float lodScreenSizes[MESH_LOD_LEVELS - 1];
+uniform float lodHysteresis;
+
+const uint NO_OCCLUSION_GROUP = 0xFFFFFFFFu;
+
+// the level of detail of a projected size, which only changes once
+// the size is clearly past a limit, as in SceneManager::SelectLodLevel()
+uint SelectLodLevel(uint currentLevel, float screenSize, uint lodCount)
+{
+    uint level = min(currentLevel, lodCount - 1u);
+
+    while ((level > 0u) && (screenSize > (lodScreenSizes[level - 1u] * (1.0 + lodHysteresis))))
+    {
+        level--;
+    }
+    while (((level + 1u) < lodCount) && (screenSize < (lodScreenSizes[level] * (1.0 - lodHysteresis))))
+    {
+        level++;
+    }
+
+    return level;
+}
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= objectCount)
+    {
+        return;
+    }
+
+    ObjectRecord object = objects[index];
+
+    // the world box around the local box, as FrustumCuller::TransformBounds()
+    vec3 localCenter = (object.minPoint.xyz + object.maxPoint.xyz) * 0.5;
+    vec3 localExtent = (object.maxPoint.xyz - object.minPoint.xyz) * 0.5;
+    vec3 center = vec3(object.world * vec4(localCenter, 1.0));
+    vec3 extent = mat3(abs(object.world[0].xyz), abs(object.world[1].xyz), abs(object.world[2].xyz)) * localExtent;
+
+    if (bFrustumCulling)
+    {
+        for (int plane = 0; plane < 6; plane++)
+        {
+            vec4 frustumPlane = frustumPlanes[plane];
+            if ((dot(center, frustumPlane.xyz) + frustumPlane.w + dot(extent, abs(frustumPlane.xyz))) < 0.0)
+            {
+                return;
+            }
+        }
+    }
+
+    if (bOcclusionCulling && (object.occlusionGroup != NO_OCCLUSION_GROUP) && (groupVisible[object.occlusionGroup] == 0u))
+    {
+        return;
+    }
+
+    // the projected diameter of the bounding sphere picks the level
+    uint level = 0u;
+    if (object.lodCount > 1u)
+    {
+        if (bLevelOfDetail)
+        {
+            // clip w is the view depth for a perspective projection
+            float clipW = (viewProjection * vec4(center, 1.0)).w;
+            float screenSize = 3.402823e38;
+            if (clipW > nearPlane)
+            {
+                screenSize = (length(extent) * lodScale) / clipW;
+            }
+            level = SelectLodLevel(lodLevels[index], screenSize, object.lodCount);
+        }
+        lodLevels[index] = level;
+    }
+
+    // the command of the level counts the instance and gives it its slot
+    uint command = object.firstCommand + level;
+    uint slot = atomicAdd(commands[command].instanceCount, 1u);
+
+    CulledInstance instance;
+    instance.model = object.world;
+    instance.materialIndex = object.materialIndex;
+    instance.padding0 = 0;
+    instance.padding1 = 0;
+    instance.padding2 = 0;
+    instances[commands[command].baseInstance + slot] = instance;
+}
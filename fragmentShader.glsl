@@ -1,228 +1,334 @@
-#version 330 core
-out vec4 fragmentColor;
-
-in vec3 fragmentPosition;
-in vec3 fragmentVertexNormal;
-in vec2 fragmentTextureCoordinate;
-
-struct Material {
-    vec3 diffuseColor;
-    vec3 specularColor;
-    float shininess;
-}; 
-
-struct DirectionalLight {
-    vec3 direction;
-	
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct PointLight {
-    vec3 position;
-    
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-  
-    float constant;
-    float linear;
-    float quadratic;
-  
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;       
-
-    bool bActive;
-};
-
-#define TOTAL_POINT_LIGHTS 5
-
-uniform bool bUseTexture=false;
-uniform bool bUseLighting=false;
-uniform vec4 objectColor = vec4(1.0f);
-uniform vec3 viewPosition;
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
-uniform SpotLight spotLight;
-uniform Material material;
-uniform sampler2D objectTexture;
-uniform vec2 UVscale = vec2(1.0f, 1.0f);
-
-// the scaled texture coordinate to use in calculations
-vec2 fragmentTextureCoordinateScaled = fragmentTextureCoordinate * UVscale;
-
-// function prototypes
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-
-void main()
-{   
-    if(bUseLighting == true)
-    {
-        vec3 phongResult = vec3(0.0f);
-        // properties
-        vec3 norm = normalize(fragmentVertexNormal);
-        vec3 viewDir = normalize(viewPosition - fragmentPosition);
-    
-        // == =====================================================
-        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
-        // For each phase, a calculate function is defined that calculates the corresponding color
-        // per light source. In the main() function we take all the calculated colors and sum them 
-        // up for this fragment's final color.
-        // == =====================================================
-        // phase 1: directional lighting
-        if(directionalLight.bActive == true)
-        {
-            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir);
-        }
-        // phase 2: point lights
-        for(int i = 0; i < TOTAL_POINT_LIGHTS; i++)
-        {
-	    if(pointLights[i].bActive == true)
-            {
-                phongResult += CalcPointLight(pointLights[i], norm, fragmentPosition, viewDir);   
-            }
-        } 
-        // phase 3: spot light
-        if(spotLight.bActive == true)
-        {
-            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir);    
-        }
-    
-        if(bUseTexture == true)
-        {
-            fragmentColor = vec4(phongResult, (texture(objectTexture, fragmentTextureCoordinateScaled)).a);
-        }
-        else
-        {
-            fragmentColor = vec4(phongResult, objectColor.a);
-        }
-    }
-    else
-    {
-        if(bUseTexture == true)
-        {
-            fragmentColor = texture(objectTexture, fragmentTextureCoordinateScaled);
-        }
-        else
-        {
-            fragmentColor = objectColor;
-        }
-    }
-}
-
-// calculates the color when using a directional light.
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDirection = normalize(-light.direction);
-    // diffuse shading
-    float diff = max(dot(normal, lightDirection), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDirection, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a point light.
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular= vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    // Calculate specular component
-    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-   
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a spot light.
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // attenuation
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
-    // spotlight intensity
-    float theta = dot(lightDir, normalize(-light.direction)); 
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinateScaled));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    ambient *= attenuation * intensity;
-    diffuse *= attenuation * intensity;
-    specular *= attenuation * intensity;
-    return (ambient + diffuse + specular);
-}
+#version 330 core
+out vec4 fragmentColor;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+in float fragmentViewDepth;
+flat in int fragmentMaterialIndex;
+
+// the struct members are ordered so that the std140 block layouts
+// match the structs in ShaderUniforms.h
+struct Material {
+    vec3 diffuseColor;
+    float shininess;
+    vec3 specularColor;
+}; 
+
+struct DirectionalLight {
+    vec3 direction;
+	
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+struct PointLight {
+    vec3 position;
+    float constant;
+    
+    vec3 ambient;
+    float linear;
+    vec3 diffuse;
+    float quadratic;
+    vec3 specular;
+    // lights further away than this add nothing visible
+    float radius;
+};
+
+struct SpotLight {
+    vec3 position;
+    float cutOff;
+    vec3 direction;
+    float outerCutOff;
+  
+    vec3 ambient;
+    float constant;
+    vec3 diffuse;
+    float linear;
+    vec3 specular;       
+    float quadratic;
+
+    bool bActive;
+};
+
+// must match ShaderUniforms.h
+#define MAX_POINT_LIGHTS 1024
+
+// light cluster grid, must match LightClusters.h
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 8
+#define CLUSTER_SLICES 24
+// texture units of the texture arrays, must match TextureManager.h
+#define TEXTURE_ARRAY_UNITS 8
+
+layout (std140) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    vec3 viewPosition;
+    vec2 screenSize;
+    float nearPlane;
+    float farPlane;
+};
+
+layout (std140) uniform LightBlock
+{
+    int pointLightCount;
+    DirectionalLight directionalLight;
+    SpotLight spotLight;
+};
+
+uniform bool bUseTexture=false;
+uniform bool bUseLighting=false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform int materialIndex = 0;
+// every scene texture is a layer of one of the texture arrays,
+// an array index of -1 means the texture is still loading
+uniform sampler2DArray textureArrays[TEXTURE_ARRAY_UNITS];
+uniform int textureArray = -1;
+uniform int textureLayer = 0;
+// second texture mixed over the first one by blendFactor
+uniform int blendTextureArray = -1;
+uniform int blendTextureLayer = 0;
+uniform float blendFactor = 0.0f;
+// when true only the lights binned into the fragment cluster are used
+uniform bool bUseLightClusters = false;
+// (offset, count) of the light index run of each cluster
+uniform usamplerBuffer clusterLightGrid;
+// point light indices of all of the clusters
+uniform usamplerBuffer clusterLightIndices;
+// four texels per point light in the order of the PointLight members
+uniform samplerBuffer pointLightData;
+// two texels per object material, indexed by material handle
+uniform samplerBuffer materialData;
+
+// ShaderVariants builds programs with these features defined as
+// constants, so the unused paths and their uniforms are compiled out.
+// Without them the features are switched by the uniforms above.
+#ifndef SHADER_PERMUTATION
+#define USE_TEXTURE bUseTexture
+#define USE_LIGHTING bUseLighting
+#define USE_LIGHT_CLUSTERS bUseLightClusters
+#define USE_DIRECTIONAL_LIGHT directionalLight.bActive
+#define USE_SPOT_LIGHT spotLight.bActive
+#define USE_TEXTURE_BLEND (bUseTexture && (blendFactor > 0.0f))
+#endif
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+
+// the scaled texture coordinate to use in calculations
+vec2 fragmentTextureCoordinateScaled = fragmentTextureCoordinate * UVscale;
+
+// the material of the object, read from the material buffer
+Material material;
+
+// function prototypes
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo);
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo);
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo);
+vec4 SampleSceneTexture(int arrayIndex, int layer, vec2 textureCoordinate);
+PointLight FetchPointLight(int index);
+Material FetchMaterial(int index);
+bool IsPointLightInReach(int index, vec3 fragPos);
+
+void main()
+{   
+    material = FetchMaterial((fragmentMaterialIndex >= 0) ? fragmentMaterialIndex : materialIndex);
+
+    // the surface color is fetched once and shared by all of the lights
+    vec4 albedo = USE_TEXTURE ? SampleSceneTexture(textureArray, textureLayer, fragmentTextureCoordinateScaled) : objectColor;
+    if(USE_TEXTURE_BLEND)
+    {
+        albedo = mix(albedo, SampleSceneTexture(blendTextureArray, blendTextureLayer, fragmentTextureCoordinateScaled), blendFactor);
+    }
+
+    if(USE_LIGHTING)
+    {
+        vec3 phongResult = vec3(0.0f);
+        // properties
+        vec3 norm = normalize(fragmentVertexNormal);
+        vec3 viewDir = normalize(viewPosition - fragmentPosition);
+    
+        // == =====================================================
+        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
+        // For each phase, a calculate function is defined that calculates the corresponding color
+        // per light source. In the main() function we take all the calculated colors and sum them 
+        // up for this fragment's final color.
+        // == =====================================================
+        // phase 1: directional lighting
+        if(USE_DIRECTIONAL_LIGHT)
+        {
+            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir, albedo.rgb);
+        }
+        // phase 2: point lights, skipping the ones that are out of reach
+        if(USE_LIGHT_CLUSTERS)
+        {
+            // find the screen tile and depth slice of this fragment
+            ivec2 tile = ivec2(gl_FragCoord.xy / screenSize * vec2(CLUSTER_TILES_X, CLUSTER_TILES_Y));
+            int slice = int(log(max(fragmentViewDepth, nearPlane) / nearPlane) / log(farPlane / nearPlane) * float(CLUSTER_SLICES));
+            tile = clamp(tile, ivec2(0), ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+            slice = clamp(slice, 0, CLUSTER_SLICES - 1);
+
+            int cluster = (slice * CLUSTER_TILES_Y + tile.y) * CLUSTER_TILES_X + tile.x;
+            uvec2 lightRun = texelFetch(clusterLightGrid, cluster).rg;
+            for(uint n = 0u; n < lightRun.y; n++)
+            {
+                int i = int(texelFetch(clusterLightIndices, int(lightRun.x + n)).r);
+                if(IsPointLightInReach(i, fragmentPosition))
+                {
+                    phongResult += CalcPointLight(FetchPointLight(i), norm, fragmentPosition, viewDir, albedo.rgb);
+                }
+            }
+        }
+        else
+        {
+            int lightCount = min(pointLightCount, MAX_POINT_LIGHTS);
+            for(int i = 0; i < lightCount; i++)
+            {
+                if(IsPointLightInReach(i, fragmentPosition))
+                {
+                    phongResult += CalcPointLight(FetchPointLight(i), norm, fragmentPosition, viewDir, albedo.rgb);   
+                }
+            } 
+        }
+        // phase 3: spot light
+        if(USE_SPOT_LIGHT)
+        {
+            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir, albedo.rgb);    
+        }
+    
+        fragmentColor = vec4(phongResult, albedo.a);
+    }
+    else
+    {
+        fragmentColor = albedo;
+    }
+}
+
+// calculates the color when using a directional light.
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 albedo)
+{
+    vec3 lightDirection = normalize(-light.direction);
+    // diffuse shading
+    float diff = max(dot(normal, lightDirection), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDirection, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    vec3 ambient = light.ambient * albedo;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * albedo;
+    vec3 specular = light.specular * spec * material.specularColor * albedo;
+    
+    return (ambient + diffuse + specular);
+}
+
+// calculates the color when using a point light.
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
+{
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    // Calculate specular component
+    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+   
+    // combine results, the point light highlight is not tinted by the surface
+    vec3 ambient = light.ambient * albedo;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * albedo;
+    vec3 specular = light.specular * specularComponent * material.specularColor;
+    
+    return (ambient + diffuse + specular) * attenuation;
+}
+
+// calculates the color when using a spot light.
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo)
+{
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
+    // spotlight intensity
+    float theta = dot(lightDir, normalize(-light.direction)); 
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    // combine results
+    vec3 ambient = light.ambient * albedo;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * albedo;
+    vec3 specular = light.specular * spec * material.specularColor * albedo;
+    
+    return (ambient + diffuse + specular) * (attenuation * intensity);
+}
+
+// samples a layer of a texture array. GLSL 3.30 only allows constant
+// sampler array indices, and the index is the same for the whole draw.
+vec4 SampleSceneTexture(int arrayIndex, int layer, vec2 textureCoordinate)
+{
+    vec3 coordinate = vec3(textureCoordinate, float(layer));
+
+    if(arrayIndex == 0) return texture(textureArrays[0], coordinate);
+    if(arrayIndex == 1) return texture(textureArrays[1], coordinate);
+    if(arrayIndex == 2) return texture(textureArrays[2], coordinate);
+    if(arrayIndex == 3) return texture(textureArrays[3], coordinate);
+    if(arrayIndex == 4) return texture(textureArrays[4], coordinate);
+    if(arrayIndex == 5) return texture(textureArrays[5], coordinate);
+    if(arrayIndex == 6) return texture(textureArrays[6], coordinate);
+    if(arrayIndex == 7) return texture(textureArrays[7], coordinate);
+
+    // placeholder grey while the texture is loading
+    return vec4(0.5f, 0.5f, 0.5f, 1.0f);
+}
+
+// reads a point light from the point light texture buffer.
+PointLight FetchPointLight(int index)
+{
+    vec4 positionConstant = texelFetch(pointLightData, index * 4);
+    vec4 ambientLinear = texelFetch(pointLightData, index * 4 + 1);
+    vec4 diffuseQuadratic = texelFetch(pointLightData, index * 4 + 2);
+    vec4 specularRadius = texelFetch(pointLightData, index * 4 + 3);
+    PointLight light;
+
+    light.position = positionConstant.xyz;
+    light.constant = positionConstant.w;
+    light.ambient = ambientLinear.xyz;
+    light.linear = ambientLinear.w;
+    light.diffuse = diffuseQuadratic.xyz;
+    light.quadratic = diffuseQuadratic.w;
+    light.specular = specularRadius.xyz;
+    light.radius = specularRadius.w;
+
+    return light;
+}
+
+// reads an object material from the material texture buffer.
+Material FetchMaterial(int index)
+{
+    vec4 diffuseShininess = texelFetch(materialData, index * 2);
+    vec4 specular = texelFetch(materialData, index * 2 + 1);
+    Material objectMaterial;
+
+    objectMaterial.diffuseColor = diffuseShininess.xyz;
+    objectMaterial.shininess = diffuseShininess.w;
+    objectMaterial.specularColor = specular.xyz;
+
+    return objectMaterial;
+}
+
+// checks the distance to a point light before the whole light is read.
+bool IsPointLightInReach(int index, vec3 fragPos)
+{
+    vec3 lightOffset = texelFetch(pointLightData, index * 4).xyz - fragPos;
+    float radius = texelFetch(pointLightData, index * 4 + 3).w;
+
+    return dot(lightOffset, lightOffset) < radius * radius;
+}
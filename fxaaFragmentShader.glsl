@@ -0,0 +1,67 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+// tonemapped colors with their luma in alpha, at the render size
+uniform sampler2D ldrColor;
+// size of one texel of ldrColor
+uniform vec2 texelSize;
+
+// longest blur along an edge, in texels
+const float spanMax = 8.0f;
+// limits of the blur direction scaling on dark and flat areas
+const float reduceMultiplier = 1.0f / 8.0f;
+const float reduceMinimum = 1.0f / 128.0f;
+// contrast below which a pixel is left alone, as an absolute
+// value and relative to the brightest neighbour
+const float edgeThresholdMinimum = 0.0312f;
+const float edgeThreshold = 0.125f;
+
+void main()
+{
+   vec2 uv = fragmentTextureCoordinate;
+   vec4 center = texture(ldrColor, uv);
+   float lumaNW = texture(ldrColor, uv + vec2(-1.0f, -1.0f) * texelSize).a;
+   float lumaNE = texture(ldrColor, uv + vec2(1.0f, -1.0f) * texelSize).a;
+   float lumaSW = texture(ldrColor, uv + vec2(-1.0f, 1.0f) * texelSize).a;
+   float lumaSE = texture(ldrColor, uv + vec2(1.0f, 1.0f) * texelSize).a;
+   float lumaM = center.a;
+
+   float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+   float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+   // most pixels are not on an edge and keep their color
+   if ((lumaMax - lumaMin) < max(edgeThresholdMinimum, lumaMax * edgeThreshold))
+   {
+      fragmentColor = vec4(center.rgb, 1.0f);
+      return;
+   }
+
+   // the blur runs along the edge, across the luma gradient
+   vec2 direction;
+   direction.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+   direction.y = ((lumaNW + lumaSW) - (lumaNE + lumaSE));
+
+   float directionReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25f * reduceMultiplier), reduceMinimum);
+   float inverseDirectionMin = 1.0f / (min(abs(direction.x), abs(direction.y)) + directionReduce);
+   direction = clamp(direction * inverseDirectionMin, vec2(-spanMax), vec2(spanMax)) * texelSize;
+
+   // two taps near the pixel, and two more further out along the edge
+   vec4 colorA = 0.5f * (
+      texture(ldrColor, uv + direction * (1.0f / 3.0f - 0.5f)) +
+      texture(ldrColor, uv + direction * (2.0f / 3.0f - 0.5f)));
+   vec4 colorB = colorA * 0.5f + 0.25f * (
+      texture(ldrColor, uv + direction * -0.5f) +
+      texture(ldrColor, uv + direction * 0.5f));
+
+   // the wide blur is dropped where it crossed into another edge
+   if ((colorB.a < lumaMin) || (colorB.a > lumaMax))
+   {
+      fragmentColor = vec4(colorA.rgb, 1.0f);
+   }
+   else
+   {
+      fragmentColor = vec4(colorB.rgb, 1.0f);
+   }
+}
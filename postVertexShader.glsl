@@ -0,0 +1,12 @@
+#version 330 core
+// one triangle that covers the whole screen, made from the vertex
+// index so the post processing passes need no vertex buffer
+out vec2 fragmentTextureCoordinate;
+
+void main()
+{
+   vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+
+   fragmentTextureCoordinate = position;
+   gl_Position = vec4(position * 2.0f - 1.0f, 0.0f, 1.0f);
+}
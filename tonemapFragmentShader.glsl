@@ -0,0 +1,45 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+// HDR colors of the offscreen scene, see RenderTarget.h
+uniform sampler2D hdrColor;
+uniform float exposure = 1.0f;
+// when true the luma is written to alpha for the FXAA pass
+uniform bool bOutputLuma = false;
+
+// colors are kept as they are up to the shoulder, so the scene looks
+// as it did before wherever it was not clipped
+const float shoulderStart = 0.8f;
+
+// roll the brightest channel off towards 1 along an exponential
+// shoulder that starts with the slope of the straight part, and
+// scale the others with it so the hue is kept
+vec3 Tonemap(vec3 color)
+{
+   float peak = max(max(color.r, color.g), color.b);
+
+   if (peak <= shoulderStart)
+   {
+      return color;
+   }
+
+   float shoulderRange = 1.0f - shoulderStart;
+   float mappedPeak = shoulderStart + shoulderRange * (1.0f - exp(-(peak - shoulderStart) / shoulderRange));
+
+   return color * (mappedPeak / peak);
+}
+
+void main()
+{
+   vec3 color = Tonemap(max(texture(hdrColor, fragmentTextureCoordinate).rgb * exposure, vec3(0.0f)));
+   float alpha = 1.0f;
+
+   if (bOutputLuma)
+   {
+      alpha = dot(color, vec3(0.299f, 0.587f, 0.114f));
+   }
+
+   fragmentColor = vec4(color, alpha);
+}
@@ -1,20 +1,47 @@
-#version 330 core
-layout (location = 0) in vec3 inVertexPosition;
-layout (location = 1) in vec3 inVertexNormal;
-layout (location = 2) in vec2 inTextureCoordinate;
-
-out vec3 fragmentPosition;
-out vec3 fragmentVertexNormal;
-out vec2 fragmentTextureCoordinate;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-   fragmentPosition = vec3(model * vec4(inVertexPosition, 1.0));
-   gl_Position = projection * view * model * vec4(inVertexPosition, 1.0f);
-   fragmentVertexNormal = inVertexNormal;
-   fragmentTextureCoordinate = inTextureCoordinate;
+#version 330 core
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+// per-instance model matrix, occupies locations 3 to 6
+layout (location = 3) in mat4 inInstanceModel;
+// per-instance material of the GPU culled draws, -1 for the uniform one
+layout (location = 7) in int inInstanceMaterial;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+// distance in front of the camera, used for the light cluster lookup
+out float fragmentViewDepth;
+// material of the instance, -1 when the materialIndex uniform is used
+flat out int fragmentMaterialIndex;
+// the depth pre-pass and the main pass use different variants
+invariant gl_Position;
+
+// shared with the fragment shader, see ShaderUniforms.h
+layout (std140) uniform CameraBlock
+{
+   mat4 view;
+   mat4 projection;
+   vec3 viewPosition;
+   vec2 screenSize;
+   float nearPlane;
+   float farPlane;
+};
+
+uniform mat4 model;
+uniform bool bUseInstancing = false;
+uniform bool bUseInstanceMaterials = false;
+
+void main()
+{
+   // instanced draws read the model matrix from the instance buffer
+   mat4 modelMatrix = bUseInstancing ? inInstanceModel : model;
+
+   fragmentPosition = vec3(modelMatrix * vec4(inVertexPosition, 1.0));
+   vec4 eyePosition = view * vec4(fragmentPosition, 1.0f);
+   fragmentViewDepth = -eyePosition.z;
+   gl_Position = projection * eyePosition;
+   fragmentVertexNormal = inVertexNormal;
+   fragmentTextureCoordinate = inTextureCoordinate;
+   fragmentMaterialIndex = (bUseInstancing && bUseInstanceMaterials) ? inInstanceMaterial : -1;
 }
\ No newline at end of file